@@ -17,6 +17,12 @@ let package = Package(
                 "CXXAudioRingBuffer",
             ]
         ),
+        .library(
+            name: "AudioRingBuffer",
+            targets: [
+                "AudioRingBuffer",
+            ]
+        ),
     ],
     targets: [
         .target(
@@ -25,10 +31,46 @@ let package = Package(
                 .linkedFramework("CoreAudio"),
             ],
         ),
+        .target(
+            name: "AudioRingBuffer",
+            dependencies: [
+                "CXXAudioRingBuffer",
+            ],
+            swiftSettings: [
+                .interoperabilityMode(.Cxx),
+            ]
+        ),
+        .executableTarget(
+            name: "AudioRingBufferBenchmarks",
+            dependencies: [
+                "CXXAudioRingBuffer",
+            ]
+        ),
+        .executableTarget(
+            name: "AudioRingBufferCapacityPlanner",
+            dependencies: [
+                "CXXAudioRingBuffer",
+            ]
+        ),
+        .executableTarget(
+            name: "ringtop",
+            dependencies: [
+                "CXXAudioRingBuffer",
+            ]
+        ),
+        .target(
+            name: "CXXAudioRingBufferTestSupport",
+            dependencies: [
+                "CXXAudioRingBuffer",
+            ],
+            path: "Tests/CXXAudioRingBufferTestSupport"
+        ),
         .testTarget(
             name: "CXXAudioRingBufferTests",
             dependencies: [
+                "AudioRingBuffer",
                 "CXXAudioRingBuffer",
+                "CXXAudioRingBufferTestSupport",
             ],
             swiftSettings: [
                 .interoperabilityMode(.Cxx),
@@ -0,0 +1,111 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+@_exported import CXXAudioRingBuffer
+
+/// Audio frames of 32-bit float channels in an `spsc.AudioRingBuffer`, accessed in place.
+///
+/// A region is only valid for the duration of the closure passed to `withWritableRegion` or `withReadableRegion`.
+public struct AudioRingBufferRegion {
+    /// The channel buffers.
+    @usableFromInline
+    let channelBuffers: UnsafeBufferPointer<UnsafeMutablePointer<Float>>
+    /// The index of the first frame of the region in each channel buffer.
+    @usableFromInline
+    let index: Int
+
+    /// The number of frames starting at the region's first frame.
+    public let firstCount: Int
+    /// The number of frames at the start of the channel buffers following the wrap.
+    public let secondCount: Int
+
+    @inlinable
+    init(channelBuffers: UnsafeBufferPointer<UnsafeMutablePointer<Float>>, region: spsc.AudioRingBuffer.Region) {
+        self.channelBuffers = channelBuffers
+        self.index = region.index
+        self.firstCount = region.firstCount
+        self.secondCount = region.secondCount
+    }
+
+    /// The number of channels.
+    @inlinable
+    public var channelCount: Int {
+        channelBuffers.count
+    }
+
+    /// The total number of frames in the region.
+    @inlinable
+    public var frameCount: Int {
+        firstCount + secondCount
+    }
+
+    /// Returns the frames of a channel as two buffers, the second empty unless the region wraps.
+    /// - parameter channel: The channel index.
+    @inlinable
+    public func channel(_ channel: Int) -> (UnsafeMutableBufferPointer<Float>, UnsafeMutableBufferPointer<Float>) {
+        let buffer = channelBuffers[channel]
+        return (UnsafeMutableBufferPointer(start: buffer + index, count: firstCount),
+                UnsafeMutableBufferPointer(start: buffer, count: secondCount))
+    }
+}
+
+extension spsc.AudioRingBuffer {
+    /// Writes audio in place.
+    ///
+    /// `body` receives the free space, up to `frameCount` frames, and returns the number of frames it wrote, which are
+    /// then published to the consumer. If `body` throws nothing is published. Nothing is allocated on the heap or
+    /// bridged, so this method may be called from a realtime thread.
+    /// - note: This method is only safe to call from the producer. The ring buffer must hold 32-bit float audio.
+    /// - parameter frameCount: The desired number of frames.
+    /// - parameter body: A closure that writes to a region and returns the number of frames written.
+    /// - returns: The number of frames written.
+    @inlinable
+    @discardableResult
+    public mutating func withWritableRegion(frameCount: Int, _ body: (AudioRingBufferRegion) throws -> Int) rethrows -> Int {
+        let region = reserveWrite(frameCount)
+        let framesWritten = try withRegion(region, body)
+        precondition(framesWritten >= 0 && framesWritten <= region.count(), "Invalid number of frames written")
+        commitWrite(framesWritten)
+        return framesWritten
+    }
+
+    /// Reads audio in place.
+    ///
+    /// `body` receives the available audio, up to `frameCount` frames, and returns the number of frames it read, which
+    /// are then released to the producer. If `body` throws nothing is released. Nothing is allocated on the heap or
+    /// bridged, so this method may be called from a realtime thread.
+    /// - note: This method is only safe to call from the consumer. The ring buffer must hold 32-bit float audio.
+    /// - parameter frameCount: The desired number of frames.
+    /// - parameter body: A closure that reads from a region and returns the number of frames read.
+    /// - returns: The number of frames read.
+    @inlinable
+    @discardableResult
+    public mutating func withReadableRegion(frameCount: Int, _ body: (AudioRingBufferRegion) throws -> Int) rethrows -> Int {
+        let region = reserveRead(frameCount)
+        let framesRead = try withRegion(region, body)
+        precondition(framesRead >= 0 && framesRead <= region.count(), "Invalid number of frames read")
+        commitRead(framesRead)
+        return framesRead
+    }
+
+    /// Calls `body` with a region whose channel buffers are gathered in stack memory.
+    @inlinable
+    func withRegion(_ region: Region, _ body: (AudioRingBufferRegion) throws -> Int) rethrows -> Int {
+        let format = self.format()
+        let channelCount = __convertToBool() ? Int(format.mChannelsPerFrame) : 0
+        precondition(channelCount == 0 || (format.mFormatFlags & kAudioFormatFlagIsFloat != 0 &&
+                                           format.mBytesPerFrame == UInt32(MemoryLayout<Float>.size)),
+                     "Only 32-bit float audio is supported")
+
+        return try withUnsafeTemporaryAllocation(of: UnsafeMutablePointer<Float>.self, capacity: channelCount) { channelBuffers in
+            for channel in 0..<channelCount {
+                channelBuffers.initializeElement(at: channel, to: channelBuffer(UInt32(channel)).assumingMemoryBound(to: Float.self))
+            }
+            return try body(AudioRingBufferRegion(channelBuffers: UnsafeBufferPointer(channelBuffers), region: region))
+        }
+    }
+}
@@ -0,0 +1,329 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "CounterBenchmark.hpp"
+#include "PerfCounters.hpp"
+
+#include "spsc/AudioRingBuffer.hpp"
+#include "spsc/BitOperations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// The assumed cache line size; positions are padded to two lines to defeat adjacent-line prefetching.
+constexpr std::size_t cacheLineSize = 64;
+/// The alignment of channel storage, so power-of-two channel strides map to the same cache sets.
+constexpr std::size_t pageSize = 4096;
+
+/// Owns the channel storage referenced by a single-buffer-per-channel AudioBufferList.
+struct CounterBufferList {
+    std::vector<std::vector<float>> channels;
+    std::vector<unsigned char> storage;
+
+    CounterBufferList(UInt32 channelCount, std::size_t frameCount)
+        : channels(channelCount, std::vector<float>(frameCount, 0.25f)),
+          storage(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount) {
+        auto *bufferList = get();
+        bufferList->mNumberBuffers = channelCount;
+        for (UInt32 i = 0; i < channelCount; ++i) {
+            bufferList->mBuffers[i].mNumberChannels = 1;
+            bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(frameCount * sizeof(float));
+            bufferList->mBuffers[i].mData = channels[i].data();
+        }
+    }
+
+    AudioBufferList *get() noexcept { return reinterpret_cast<AudioBufferList *>(storage.data()); }
+};
+
+/// The algorithm of AudioRingBuffer with a configurable memory layout.
+///
+/// With PaddedPositions false the write and read positions share a cache line as in ``spsc::detail::RingBufferIndex``;
+/// with it true each has its own pair of lines. Staggered channels start one cache line further into their stride
+/// than the previous channel, so the same frame of every channel maps to a different cache set; packed channels are
+/// exactly a power of two apart as in AudioRingBuffer.
+template <bool PaddedPositions> class LayoutRingBuffer final {
+  public:
+    LayoutRingBuffer() noexcept = default;
+
+    // This class is non-copyable
+    LayoutRingBuffer(const LayoutRingBuffer &) = delete;
+
+    // This class is non-assignable
+    LayoutRingBuffer &operator=(const LayoutRingBuffer &) = delete;
+
+    ~LayoutRingBuffer() noexcept { std::free(storage_); }
+
+    /// Allocates zeroed channel storage.
+    /// @return true on success, false if memory could not be allocated.
+    bool allocate(UInt32 channelCount, std::size_t minFrameCapacity, bool staggerChannels) noexcept {
+        capacity_ = spsc::detail::bit_ceil(minFrameCapacity);
+        const auto channelByteSize = capacity_ * sizeof(float);
+        const auto channelStride = channelByteSize + (staggerChannels ? cacheLineSize : 0);
+        const auto allocationSize = (channelStride * channelCount + pageSize - 1) / pageSize * pageSize;
+
+        storage_ = static_cast<unsigned char *>(std::aligned_alloc(pageSize, allocationSize));
+        if (storage_ == nullptr) {
+            return false;
+        }
+        std::memset(storage_, 0, allocationSize);
+
+        try {
+            channels_.resize(channelCount);
+        } catch (const std::bad_alloc &) {
+            return false;
+        }
+        for (UInt32 i = 0; i < channelCount; ++i) {
+            channels_[i] = storage_ + channelStride * i;
+        }
+        return true;
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    std::size_t write(const AudioBufferList *const bufferList, std::size_t frameCount) noexcept {
+        const auto writePosition = writePosition_.value.load(std::memory_order_relaxed);
+        const auto readPosition = readPosition_.value.load(std::memory_order_acquire);
+        const auto framesToWrite = std::min(frameCount, capacity_ - (writePosition - readPosition));
+        if (framesToWrite == 0) {
+            return 0;
+        }
+
+        const auto index = writePosition & (capacity_ - 1);
+        const auto firstCount = std::min(framesToWrite, capacity_ - index);
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            const auto *source = static_cast<const unsigned char *>(bufferList->mBuffers[i].mData);
+            std::memcpy(channels_[i] + index * sizeof(float), source, firstCount * sizeof(float));
+            std::memcpy(channels_[i], source + firstCount * sizeof(float),
+                        (framesToWrite - firstCount) * sizeof(float));
+        }
+
+        writePosition_.value.store(writePosition + framesToWrite, std::memory_order_release);
+        return framesToWrite;
+    }
+
+    std::size_t read(AudioBufferList *const bufferList, std::size_t frameCount) noexcept {
+        const auto readPosition = readPosition_.value.load(std::memory_order_relaxed);
+        const auto writePosition = writePosition_.value.load(std::memory_order_acquire);
+        const auto framesToRead = std::min(frameCount, writePosition - readPosition);
+        if (framesToRead == 0) {
+            return 0;
+        }
+
+        const auto index = readPosition & (capacity_ - 1);
+        const auto firstCount = std::min(framesToRead, capacity_ - index);
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            auto *destination = static_cast<unsigned char *>(bufferList->mBuffers[i].mData);
+            std::memcpy(destination, channels_[i] + index * sizeof(float), firstCount * sizeof(float));
+            std::memcpy(destination + firstCount * sizeof(float), channels_[i],
+                        (framesToRead - firstCount) * sizeof(float));
+        }
+
+        readPosition_.value.store(readPosition + framesToRead, std::memory_order_release);
+        return framesToRead;
+    }
+
+    std::size_t drain() noexcept {
+        const auto writePosition = writePosition_.value.load(std::memory_order_acquire);
+        return writePosition - readPosition_.value.exchange(writePosition, std::memory_order_release);
+    }
+
+  private:
+    /// A free-running position, alone on two cache lines if PaddedPositions.
+    struct alignas(PaddedPositions ? 2 * cacheLineSize : alignof(std::atomic<std::size_t>)) Position {
+        std::atomic<std::size_t> value{0};
+    };
+
+    /// The channel storage, allocated in one chunk.
+    unsigned char *storage_{nullptr};
+    /// The start of each channel within storage_.
+    std::vector<unsigned char *> channels_;
+    /// The capacity in audio frames.
+    std::size_t capacity_{0};
+    /// The free-running write position.
+    Position writePosition_;
+    /// The free-running read position.
+    Position readPosition_;
+};
+
+/// The time and counter events of a scenario.
+struct Measurement {
+    double nanoseconds{0};
+    std::size_t frameCount{0};
+    PerfCounters::Reading reading;
+};
+
+/// Moves configuration.frameCount frames through a ring buffer, writing and reading on the calling thread or writing
+/// on a separate producer thread.
+/// @return true on success, false if the producer thread could not be started.
+template <typename RingBuffer>
+bool measure(RingBuffer &ringBuffer, const CounterBenchmarkConfiguration &configuration, bool threaded,
+             PerfCounters &counters, Measurement &measurement) {
+    const auto channelCount = static_cast<UInt32>(configuration.channelCount);
+    const auto sliceFrames = configuration.sliceFrames;
+    const auto frameCount = configuration.frameCount / sliceFrames * sliceFrames;
+    CounterBufferList input{channelCount, sliceFrames};
+    CounterBufferList output{channelCount, sliceFrames};
+
+    // Touch the storage and offset the positions so wrapping occurs at a varying point within the slices
+    for (std::size_t frames = 0; frames < ringBuffer.capacity(); frames += sliceFrames) {
+        ringBuffer.write(input.get(), sliceFrames);
+        ringBuffer.drain();
+    }
+    ringBuffer.write(input.get(), sliceFrames / 3);
+    ringBuffer.drain();
+
+    std::size_t framesRead = 0;
+    counters.start();
+    const auto start = std::chrono::steady_clock::now();
+
+    if (!threaded) {
+        while (framesRead < frameCount) {
+            ringBuffer.write(input.get(), sliceFrames);
+            framesRead += ringBuffer.read(output.get(), sliceFrames);
+        }
+    } else {
+        std::thread producer;
+        try {
+            producer = std::thread([&] {
+                for (std::size_t framesWritten = 0; framesWritten < frameCount;) {
+                    const auto count = ringBuffer.write(input.get(), sliceFrames);
+                    framesWritten += count;
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        } catch (const std::system_error &e) {
+            counters.stop();
+            std::fprintf(stderr, "Unable to start producer thread: %s\n", e.what());
+            return false;
+        }
+
+        while (framesRead < frameCount) {
+            const auto count = ringBuffer.read(output.get(), sliceFrames);
+            framesRead += count;
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    measurement.reading = counters.stop();
+    measurement.nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+    measurement.frameCount = framesRead;
+    ringBuffer.drain();
+    return true;
+}
+
+/// Prints a row of per-frame rates.
+void printMeasurement(const char *layout, bool threaded, const Measurement &measurement) {
+    const auto frames = static_cast<double>(measurement.frameCount);
+    std::printf("%-22s %-7s %9.3f", layout, threaded ? "2" : "1", measurement.nanoseconds / frames);
+    for (std::size_t counter = 0; counter < PerfCounters::counterCount; ++counter) {
+        if (measurement.reading.valid[counter]) {
+            std::printf(" %10.4f", measurement.reading.counts[counter] / frames);
+        } else {
+            std::printf(" %10s", "-");
+        }
+    }
+    if (measurement.reading.valid[PerfCounters::cycles] && measurement.reading.valid[PerfCounters::instructions] &&
+        measurement.reading.counts[PerfCounters::cycles] > 0) {
+        std::printf(" %6.2f", measurement.reading.counts[PerfCounters::instructions] /
+                                      measurement.reading.counts[PerfCounters::cycles]);
+    } else {
+        std::printf(" %6s", "-");
+    }
+    std::printf("\n");
+}
+
+/// Measures a layout variant on one and two threads.
+template <bool PaddedPositions>
+bool measureLayout(const char *layout, bool staggerChannels, const CounterBenchmarkConfiguration &configuration,
+                   PerfCounters &counters) {
+    for (const auto threaded : {false, true}) {
+        LayoutRingBuffer<PaddedPositions> ringBuffer;
+        if (!ringBuffer.allocate(configuration.channelCount, configuration.capacityFrames, staggerChannels)) {
+            std::fprintf(stderr, "Unable to allocate ring buffer with capacity %zu\n", configuration.capacityFrames);
+            return false;
+        }
+
+        Measurement measurement;
+        if (!measure(ringBuffer, configuration, threaded, counters, measurement)) {
+            return false;
+        }
+        printMeasurement(layout, threaded, measurement);
+    }
+    return true;
+}
+
+} /* namespace */
+
+bool runCounterBenchmark(const CounterBenchmarkConfiguration &configuration) {
+    if (configuration.channelCount == 0 || configuration.sliceFrames == 0 ||
+        configuration.sliceFrames > configuration.capacityFrames ||
+        configuration.frameCount < configuration.sliceFrames) {
+        std::fprintf(stderr, "Invalid counter benchmark configuration\n");
+        return false;
+    }
+
+    PerfCounters counters;
+    const auto openCount = counters.open(configuration.coherenceEvent);
+    std::printf("%u channels, capacity %zu, slice %zu, %zu frames per scenario, %zu hardware counters\n",
+                configuration.channelCount, configuration.capacityFrames, configuration.sliceFrames,
+                configuration.frameCount, openCount);
+    if (openCount == 0) {
+        std::printf("perf_event_open unavailable; check /proc/sys/kernel/perf_event_paranoid\n");
+    }
+
+    std::printf("\n%-22s %-7s %9s", "layout", "threads", "ns/frame");
+    for (std::size_t counter = 0; counter < PerfCounters::counterCount; ++counter) {
+        std::printf(" %10s", PerfCounters::name(counter));
+    }
+    std::printf(" %6s\n", "IPC");
+
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 48000;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked | kAudioFormatFlagIsNonInterleaved |
+                          kAudioFormatFlagsNativeEndian;
+    format.mBytesPerPacket = sizeof(float);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerFrame = sizeof(float);
+    format.mChannelsPerFrame = configuration.channelCount;
+    format.mBitsPerChannel = 32;
+
+    for (const auto threaded : {false, true}) {
+        spsc::AudioRingBuffer ringBuffer;
+        if (!ringBuffer.allocate(format, configuration.capacityFrames)) {
+            std::fprintf(stderr, "Unable to allocate ring buffer with capacity %zu\n", configuration.capacityFrames);
+            return false;
+        }
+
+        Measurement measurement;
+        if (!measure(ringBuffer, configuration, threaded, counters, measurement)) {
+            return false;
+        }
+        printMeasurement("AudioRingBuffer", threaded, measurement);
+    }
+
+    return measureLayout<false>("unpadded, packed", false, configuration, counters) &&
+           measureLayout<false>("unpadded, staggered", true, configuration, counters) &&
+           measureLayout<true>("padded, packed", false, configuration, counters) &&
+           measureLayout<true>("padded, staggered", true, configuration, counters);
+}
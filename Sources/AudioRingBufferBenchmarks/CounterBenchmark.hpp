@@ -0,0 +1,31 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Parameters for the hardware counter benchmark.
+struct CounterBenchmarkConfiguration {
+    /// The number of channels.
+    unsigned int channelCount{8};
+    /// The requested ring buffer capacity in audio frames.
+    std::size_t capacityFrames{4096};
+    /// The number of audio frames written and read per call.
+    std::size_t sliceFrames{256};
+    /// The number of audio frames moved through a ring buffer by each scenario.
+    std::size_t frameCount{std::size_t{1} << 22};
+    /// The `PERF_TYPE_RAW` configuration of the coherence counter, or 0 to leave it closed.
+    std::uint64_t coherenceEvent{0};
+};
+
+/// Moves audio through AudioRingBuffer and through copies of its algorithm with padded or unpadded positions and packed
+/// or staggered channels, on one thread and on a producer and consumer thread, and prints the time and hardware
+/// counter events per frame of each scenario.
+/// @return true on success, false if a ring buffer could not be allocated or a thread could not be started.
+bool runCounterBenchmark(const CounterBenchmarkConfiguration &configuration);
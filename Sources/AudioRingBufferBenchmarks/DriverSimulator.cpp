@@ -0,0 +1,249 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "DriverSimulator.hpp"
+
+#include "spsc/AudioRingBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// The number of power-of-two microsecond buckets in a histogram; the last bucket collects everything larger.
+constexpr std::size_t histogramBucketCount = 20;
+
+/// Sleeps until an absolute deadline.
+///
+/// On Linux this uses `clock_nanosleep` with `TIMER_ABSTIME` on `CLOCK_MONOTONIC`, the clock behind
+/// `std::chrono::steady_clock`, so lateness in one period does not push back the following deadlines.
+void sleepUntil(Clock::time_point deadline) noexcept {
+#if defined(__linux__)
+    const auto nanoseconds =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(nanoseconds / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(nanoseconds % 1'000'000'000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+/// Requests SCHED_FIFO at priority for the calling thread.
+/// @return true if the request was granted.
+bool requestRealtimePriority(int priority) noexcept {
+    if (priority <= 0) {
+        return false;
+    }
+    sched_param param{};
+    param.sched_priority = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+/// Returns a distribution of clock ticks in [0, jitter].
+std::uniform_int_distribution<Clock::rep> jitterDistribution(std::chrono::microseconds jitter) {
+    return std::uniform_int_distribution<Clock::rep>{0, std::chrono::duration_cast<Clock::duration>(jitter).count()};
+}
+
+/// Prints percentiles and a power-of-two histogram of samples in microseconds.
+void printDistribution(const char *title, std::vector<double> samples) {
+    std::printf("%s (us):", title);
+    if (samples.empty()) {
+        std::printf(" no samples\n");
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double p) {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+        return samples[index];
+    };
+    std::printf(" p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n", percentile(0.5), percentile(0.99), percentile(0.999),
+                samples.back());
+
+    std::size_t buckets[histogramBucketCount]{};
+    for (const auto sample : samples) {
+        std::size_t bucket = 0;
+        while (bucket < histogramBucketCount - 1 && sample >= static_cast<double>(std::size_t{1} << bucket)) {
+            ++bucket;
+        }
+        ++buckets[bucket];
+    }
+
+    const auto largest = *std::max_element(std::begin(buckets), std::end(buckets));
+    for (std::size_t bucket = 0; bucket < histogramBucketCount; ++bucket) {
+        if (buckets[bucket] == 0) {
+            continue;
+        }
+        const auto width = static_cast<int>(40 * buckets[bucket] / largest);
+        if (bucket == histogramBucketCount - 1) {
+            std::printf("  >= %7zu %8zu %.*s\n", std::size_t{1} << (bucket - 1), buckets[bucket], width,
+                        "########################################");
+        } else {
+            std::printf("  <  %7zu %8zu %.*s\n", std::size_t{1} << bucket, buckets[bucket], width,
+                        "########################################");
+        }
+    }
+}
+
+/// Owns the channel storage referenced by a single-buffer-per-channel AudioBufferList.
+struct SimulatorBufferList {
+    std::vector<std::vector<float>> channels;
+    std::vector<unsigned char> storage;
+
+    SimulatorBufferList(UInt32 channelCount, std::size_t frameCount)
+        : channels(channelCount, std::vector<float>(frameCount, 0.25f)),
+          storage(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount) {
+        auto *bufferList = get();
+        bufferList->mNumberBuffers = channelCount;
+        for (UInt32 i = 0; i < channelCount; ++i) {
+            bufferList->mBuffers[i].mNumberChannels = 1;
+            bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(frameCount * sizeof(float));
+            bufferList->mBuffers[i].mData = channels[i].data();
+        }
+    }
+
+    AudioBufferList *get() noexcept { return reinterpret_cast<AudioBufferList *>(storage.data()); }
+};
+
+} /* namespace */
+
+bool runDriverSimulator(const DriverSimulatorConfiguration &configuration) {
+    // A period or producer write larger than the ring could never complete, and a prefill larger than the ring would
+    // be truncated
+    if (configuration.periodFrames == 0 || configuration.producerFrames == 0 ||
+        configuration.capacityFrames < configuration.periodFrames ||
+        configuration.capacityFrames < configuration.producerFrames ||
+        configuration.capacityFrames < configuration.prefillFrames) {
+        std::fprintf(stderr, "Invalid driver simulator configuration: the capacity must be at least the period, "
+                             "producer, and prefill sizes\n");
+        return false;
+    }
+
+    constexpr UInt32 channelCount = 2;
+
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = configuration.sampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked | kAudioFormatFlagIsNonInterleaved |
+                          kAudioFormatFlagsNativeEndian;
+    format.mBytesPerPacket = sizeof(float);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerFrame = sizeof(float);
+    format.mChannelsPerFrame = channelCount;
+    format.mBitsPerChannel = 32;
+
+    spsc::AudioRingBuffer ringBuffer;
+    if (!ringBuffer.allocate(format, configuration.capacityFrames)) {
+        std::fprintf(stderr, "Unable to allocate ring buffer with capacity %zu\n", configuration.capacityFrames);
+        return false;
+    }
+    ringBuffer.prefault();
+
+    const auto framesToDuration = [&configuration](std::size_t frames) {
+        return std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(frames) / configuration.sampleRate));
+    };
+    const auto period = framesToDuration(configuration.periodFrames);
+    const auto producerInterval = framesToDuration(configuration.producerFrames);
+    const auto callbackCount = static_cast<std::size_t>(
+            std::chrono::duration_cast<Clock::duration>(configuration.duration) / period);
+
+    SimulatorBufferList prefill{channelCount, configuration.prefillFrames};
+    const auto prefilledFrames = ringBuffer.write(prefill.get(), configuration.prefillFrames);
+
+    // Preallocated so the device thread does not allocate
+    std::vector<double> wakeJitter(callbackCount);
+    std::vector<double> callbackDuration(callbackCount);
+    std::size_t underrunCount = 0;
+    std::size_t underrunFrames = 0;
+    bool realtimeGranted = false;
+
+    std::size_t overrunCount = 0;
+    std::size_t overrunFrames = 0;
+    std::atomic<bool> stop{false};
+
+    const auto start = Clock::now() + std::chrono::milliseconds{10};
+
+    std::thread producer;
+    std::thread device;
+    try {
+        producer = std::thread([&] {
+            SimulatorBufferList input{channelCount, configuration.producerFrames};
+            std::mt19937_64 engine{0x5eed};
+            auto jitter = jitterDistribution(configuration.producerJitter);
+
+            for (std::size_t call = 0; !stop.load(std::memory_order_acquire); ++call) {
+                sleepUntil(start + producerInterval * call + Clock::duration{jitter(engine)});
+                const auto framesWritten = ringBuffer.write(input.get(), configuration.producerFrames);
+                if (framesWritten < configuration.producerFrames) {
+                    ++overrunCount;
+                    overrunFrames += configuration.producerFrames - framesWritten;
+                }
+            }
+        });
+
+        device = std::thread([&] {
+            realtimeGranted = requestRealtimePriority(configuration.realtimePriority);
+            SimulatorBufferList output{channelCount, configuration.periodFrames};
+
+            for (std::size_t callback = 0; callback < callbackCount; ++callback) {
+                const auto deadline = start + period * (callback + 1);
+                sleepUntil(deadline);
+                const auto woke = Clock::now();
+
+                const auto framesRead = ringBuffer.read(output.get(), configuration.periodFrames);
+                if (framesRead < configuration.periodFrames) {
+                    ++underrunCount;
+                    underrunFrames += configuration.periodFrames - framesRead;
+                }
+
+                const auto finished = Clock::now();
+                wakeJitter[callback] = std::chrono::duration<double, std::micro>(woke - deadline).count();
+                callbackDuration[callback] = std::chrono::duration<double, std::micro>(finished - woke).count();
+            }
+        });
+    } catch (const std::system_error &e) {
+        stop.store(true, std::memory_order_release);
+        if (producer.joinable()) {
+            producer.join();
+        }
+        std::fprintf(stderr, "Unable to start simulator threads: %s\n", e.what());
+        return false;
+    }
+
+    device.join();
+    stop.store(true, std::memory_order_release);
+    producer.join();
+
+    std::printf("period %zu frames (%.0f us), capacity %zu, prefill %zu, producer %zu frames with %lld us jitter, "
+                "%s\n",
+                configuration.periodFrames, std::chrono::duration<double, std::micro>(period).count(),
+                ringBuffer.capacity(), prefilledFrames, configuration.producerFrames,
+                static_cast<long long>(configuration.producerJitter.count()),
+                realtimeGranted ? "SCHED_FIFO" : "default scheduling");
+    std::printf("callbacks %zu, underruns %zu (%zu frames), overruns %zu (%zu frames)\n", callbackCount,
+                underrunCount, underrunFrames, overrunCount, overrunFrames);
+    printDistribution("wake jitter", std::move(wakeJitter));
+    printDistribution("callback duration", std::move(callbackDuration));
+
+    return true;
+}
@@ -0,0 +1,38 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/// Parameters for a simulated audio device driving a ring buffer consumer.
+struct DriverSimulatorConfiguration {
+    /// The sample rate in Hz.
+    double sampleRate{48000};
+    /// The number of audio frames the simulated device pulls per callback.
+    std::size_t periodFrames{256};
+    /// The requested ring buffer capacity in audio frames.
+    std::size_t capacityFrames{1024};
+    /// The number of audio frames written before the device starts.
+    std::size_t prefillFrames{512};
+    /// The number of audio frames the producer writes per call.
+    std::size_t producerFrames{256};
+    /// The maximum random delay added to each producer deadline.
+    std::chrono::microseconds producerJitter{2000};
+    /// The length of the simulation.
+    std::chrono::seconds duration{5};
+    /// The SCHED_FIFO priority requested for the device thread, or 0 to run it with the default policy.
+    int realtimePriority{80};
+};
+
+/// Runs a simulated audio device that pulls from an AudioRingBuffer every period on an absolute schedule while a
+/// producer thread with random jitter feeds it, then prints underruns, overruns, and wake-jitter and callback-duration
+/// histograms.
+/// @return true on success, false if the capacity is smaller than the period, producer, or prefill size, the ring
+/// buffer could not be allocated, or a thread could not be started.
+bool runDriverSimulator(const DriverSimulatorConfiguration &configuration);
@@ -0,0 +1,172 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "PerfCounters.hpp"
+
+#if defined(__linux__)
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+
+/// Returns the `perf_event_attr` type and config of a counter, or false if it is not requested.
+bool eventForCounter(std::size_t counter, std::uint64_t coherenceEvent, std::uint32_t &type,
+                     std::uint64_t &config) noexcept {
+    /// Returns the config of a cache read miss event.
+    const auto cacheReadMiss = [](std::uint64_t cache) noexcept {
+        return cache | (std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+               (std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+    };
+
+    switch (counter) {
+    case PerfCounters::cycles:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_CPU_CYCLES;
+        return true;
+    case PerfCounters::instructions:
+        type = PERF_TYPE_HARDWARE;
+        config = PERF_COUNT_HW_INSTRUCTIONS;
+        return true;
+    case PerfCounters::l1dMisses:
+        type = PERF_TYPE_HW_CACHE;
+        config = cacheReadMiss(PERF_COUNT_HW_CACHE_L1D);
+        return true;
+    case PerfCounters::llcMisses:
+        type = PERF_TYPE_HW_CACHE;
+        config = cacheReadMiss(PERF_COUNT_HW_CACHE_LL);
+        return true;
+    case PerfCounters::dtlbMisses:
+        type = PERF_TYPE_HW_CACHE;
+        config = cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB);
+        return true;
+    case PerfCounters::coherence:
+        type = PERF_TYPE_RAW;
+        config = coherenceEvent;
+        return coherenceEvent != 0;
+    default:
+        return false;
+    }
+}
+
+#endif
+
+} /* namespace */
+
+const char *PerfCounters::name(std::size_t counter) noexcept {
+    switch (counter) {
+    case cycles:
+        return "cycles";
+    case instructions:
+        return "instr";
+    case l1dMisses:
+        return "L1D-miss";
+    case llcMisses:
+        return "LLC-miss";
+    case dtlbMisses:
+        return "dTLB-miss";
+    case coherence:
+        return "coherence";
+    default:
+        return "unknown";
+    }
+}
+
+PerfCounters::~PerfCounters() noexcept { close(); }
+
+std::size_t PerfCounters::open(std::uint64_t coherenceEvent) noexcept {
+    close();
+
+    std::size_t openCount = 0;
+#if defined(__linux__)
+    for (std::size_t counter = 0; counter < counterCount; ++counter) {
+        std::uint32_t type = 0;
+        std::uint64_t config = 0;
+        if (!eventForCounter(counter, coherenceEvent, type, config)) {
+            continue;
+        }
+
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const auto descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (descriptor >= 0) {
+            descriptors_[counter] = descriptor;
+            ++openCount;
+        }
+    }
+#else
+    (void)coherenceEvent;
+#endif
+    return openCount;
+}
+
+void PerfCounters::close() noexcept {
+    for (auto &descriptor : descriptors_) {
+#if defined(__linux__)
+        if (descriptor >= 0) {
+            ::close(descriptor);
+        }
+#endif
+        descriptor = -1;
+    }
+}
+
+void PerfCounters::start() noexcept {
+#if defined(__linux__)
+    for (const auto descriptor : descriptors_) {
+        if (descriptor >= 0) {
+            ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+auto PerfCounters::stop() noexcept -> Reading {
+    Reading reading;
+#if defined(__linux__)
+    for (const auto descriptor : descriptors_) {
+        if (descriptor >= 0) {
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (std::size_t counter = 0; counter < counterCount; ++counter) {
+        if (descriptors_[counter] < 0) {
+            continue;
+        }
+
+        // value, time enabled, time running
+        std::uint64_t values[3]{};
+        if (::read(descriptors_[counter], values, sizeof values) != static_cast<ssize_t>(sizeof values) ||
+            values[2] == 0) {
+            continue;
+        }
+
+        // Scale for the time the counter was multiplexed off the PMU
+        reading.counts[counter] = static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+                                  static_cast<double>(values[2]);
+        reading.valid[counter] = true;
+    }
+#endif
+    return reading;
+}
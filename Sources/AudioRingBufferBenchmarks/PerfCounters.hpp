@@ -0,0 +1,86 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Hardware performance counters opened with `perf_event_open` for the calling thread and the threads it creates.
+///
+/// Each counter is opened on its own with `inherit` set, so threads started after ``open`` are counted and their
+/// counts are added when they exit. Counters the kernel or CPU does not support are left closed, and counts are scaled
+/// for multiplexing. Only user-space events are counted. On platforms other than Linux no counter opens.
+class PerfCounters final {
+  public:
+    /// The counters.
+    enum Counter : std::size_t {
+        /// CPU cycles.
+        cycles,
+        /// Instructions retired.
+        instructions,
+        /// L1 data cache read misses.
+        l1dMisses,
+        /// Last-level cache read misses.
+        llcMisses,
+        /// Data TLB read misses.
+        dtlbMisses,
+        /// A model-specific raw event, such as loads that hit a modified line in another core's cache (HITM).
+        coherence,
+    };
+
+    /// The number of counters.
+    static constexpr std::size_t counterCount = 6;
+
+    /// Counts read by ``stop``.
+    struct Reading {
+        /// The scaled count of each counter.
+        double counts[counterCount]{};
+        /// true for each counter that is open and was scheduled on the PMU.
+        bool valid[counterCount]{};
+    };
+
+    /// Returns a short name for a counter.
+    static const char *name(std::size_t counter) noexcept;
+
+    /// Creates closed counters.
+    PerfCounters() noexcept = default;
+
+    // This class is non-copyable
+    PerfCounters(const PerfCounters &) = delete;
+
+    // This class is non-movable
+    PerfCounters(PerfCounters &&) = delete;
+
+    // This class is non-assignable
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // This class is non-move-assignable
+    PerfCounters &operator=(PerfCounters &&) = delete;
+
+    /// Closes the counters.
+    ~PerfCounters() noexcept;
+
+    /// Opens the counters, disabled.
+    /// @param coherenceEvent The `PERF_TYPE_RAW` configuration of the coherence counter, or 0 to leave it closed.
+    /// For example, 0x04d2 is `MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM` on Intel Skylake.
+    /// @return The number of counters opened.
+    std::size_t open(std::uint64_t coherenceEvent) noexcept;
+
+    /// Closes the counters.
+    void close() noexcept;
+
+    /// Zeroes and enables the open counters.
+    void start() noexcept;
+
+    /// Disables the open counters and reads them.
+    Reading stop() noexcept;
+
+  private:
+    /// The file descriptor of each counter, or -1.
+    int descriptors_[counterCount]{-1, -1, -1, -1, -1, -1};
+};
@@ -0,0 +1,266 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "CounterBenchmark.hpp"
+#include "DriverSimulator.hpp"
+
+#include "spsc/AudioRingBuffer.hpp"
+#include "spsc/AudioRingBufferGroup.hpp"
+#include "spsc/ExactAudioRingBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/// The number of channels used by every benchmark.
+constexpr UInt32 channelCount = 2;
+/// The number of audio frames moved through a buffer by each benchmark.
+constexpr std::size_t framesPerRun = std::size_t{1} << 26;
+
+/// Returns a non-interleaved 32-bit float format.
+AudioStreamBasicDescription benchmarkFormat() noexcept {
+    AudioStreamBasicDescription format{};
+    format.mSampleRate = 48000;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked | kAudioFormatFlagIsNonInterleaved |
+                          kAudioFormatFlagsNativeEndian;
+    format.mBytesPerPacket = sizeof(float);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerFrame = sizeof(float);
+    format.mChannelsPerFrame = channelCount;
+    format.mBitsPerChannel = 32;
+    return format;
+}
+
+/// Owns the channel storage referenced by a single-buffer-per-channel AudioBufferList.
+struct BenchmarkBufferList {
+    std::vector<std::vector<float>> channels;
+    std::vector<unsigned char> storage;
+
+    explicit BenchmarkBufferList(std::size_t frameCount)
+        : channels(channelCount, std::vector<float>(frameCount, 0.25f)),
+          storage(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount) {
+        auto *bufferList = get();
+        bufferList->mNumberBuffers = channelCount;
+        for (UInt32 i = 0; i < channelCount; ++i) {
+            bufferList->mBuffers[i].mNumberChannels = 1;
+            bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(frameCount * sizeof(float));
+            bufferList->mBuffers[i].mData = channels[i].data();
+        }
+    }
+
+    AudioBufferList *get() noexcept { return reinterpret_cast<AudioBufferList *>(storage.data()); }
+};
+
+/// Moves audio through a ring buffer in fixed-size slices and returns the average cost in nanoseconds per frame.
+template <typename RingBuffer> double nanosecondsPerFrame(RingBuffer &ringBuffer, std::size_t sliceFrames) {
+    BenchmarkBufferList input{sliceFrames};
+    BenchmarkBufferList output{sliceFrames};
+
+    // Offset the positions so wrapping occurs at a varying point within the slices
+    ringBuffer.write(input.get(), sliceFrames / 3);
+
+    std::size_t framesMoved = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (framesMoved < framesPerRun) {
+        ringBuffer.write(input.get(), sliceFrames);
+        framesMoved += ringBuffer.read(output.get(), sliceFrames);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ringBuffer.drain();
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(framesMoved);
+}
+
+/// Returns the number of bytes of sample storage used by a ring buffer.
+template <typename RingBuffer> std::size_t storageBytes(const RingBuffer &ringBuffer) noexcept {
+    return ringBuffer.capacity() * ringBuffer.format().mBytesPerFrame * ringBuffer.format().mChannelsPerFrame;
+}
+
+/// Writes the same audio to memberCount ring buffers and returns the average cost in nanoseconds per source frame.
+double fanOutNanosecondsPerFrame(std::size_t memberCount, std::size_t sliceFrames, bool useGroup) {
+    const auto format = benchmarkFormat();
+    BenchmarkBufferList input{sliceFrames};
+
+    std::vector<std::unique_ptr<spsc::AudioRingBuffer>> members;
+    spsc::AudioRingBufferGroup group;
+    if (!group.allocate(memberCount)) {
+        return 0;
+    }
+    for (std::size_t i = 0; i < memberCount; ++i) {
+        members.push_back(std::make_unique<spsc::AudioRingBuffer>(format, sliceFrames * 2));
+        members.back()->prefault();
+        group.add(*members.back());
+    }
+
+    std::size_t framesMoved = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (framesMoved < framesPerRun / memberCount) {
+        if (useGroup) {
+            framesMoved += group.writeAll(input.get(), sliceFrames);
+        } else {
+            for (const auto &member : members) {
+                member->write(input.get(), sliceFrames);
+            }
+            framesMoved += sliceFrames;
+        }
+        for (const auto &member : members) {
+            member->skip(sliceFrames);
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(framesMoved);
+}
+
+/// A `--name=value` option and the function storing its value in a configuration.
+template <typename Configuration> struct Option {
+    /// The option name, including the leading dashes.
+    std::string_view name;
+    /// Stores the option's value.
+    void (*assign)(Configuration &configuration, unsigned long long value);
+};
+
+/// Parses `--name=value` options with numeric values, given in decimal or with a `0x` prefix in hexadecimal.
+/// @return true on success, false if an option is not recognized.
+template <typename Configuration, std::size_t N>
+bool parseOptions(int argc, char *argv[], const Option<Configuration> (&options)[N], Configuration &configuration) {
+    for (int i = 0; i < argc; ++i) {
+        const char *value = std::strchr(argv[i], '=');
+        if (value == nullptr) {
+            return false;
+        }
+        const auto name = std::string_view{argv[i], static_cast<std::size_t>(value - argv[i])};
+        const auto option = std::find_if(std::begin(options), std::end(options),
+                                         [name](const auto &option) { return option.name == name; });
+        if (option == std::end(options)) {
+            return false;
+        }
+        // Base 0 so raw event configurations may be given in hexadecimal
+        option->assign(configuration, std::strtoull(value + 1, nullptr, 0));
+    }
+    return true;
+}
+
+/// Parses `--name=value` options for the driver simulator.
+/// @return true on success, false if an option is not recognized or the period, capacity, or producer size is 0.
+bool parseDriverOptions(int argc, char *argv[], DriverSimulatorConfiguration &configuration) {
+    using Configuration = DriverSimulatorConfiguration;
+    static constexpr Option<Configuration> options[] = {
+            {"--period", [](Configuration &c, unsigned long long value) { c.periodFrames = value; }},
+            {"--capacity", [](Configuration &c, unsigned long long value) { c.capacityFrames = value; }},
+            {"--prefill", [](Configuration &c, unsigned long long value) { c.prefillFrames = value; }},
+            {"--producer", [](Configuration &c, unsigned long long value) { c.producerFrames = value; }},
+            {"--jitter",
+             [](Configuration &c, unsigned long long value) { c.producerJitter = std::chrono::microseconds{value}; }},
+            {"--seconds", [](Configuration &c, unsigned long long value) { c.duration = std::chrono::seconds{value}; }},
+            {"--priority",
+             [](Configuration &c, unsigned long long value) { c.realtimePriority = static_cast<int>(value); }},
+    };
+
+    if (!parseOptions(argc, argv, options, configuration)) {
+        return false;
+    }
+    return configuration.periodFrames != 0 && configuration.capacityFrames != 0 && configuration.producerFrames != 0;
+}
+
+/// Parses `--name=value` options for the counter benchmark.
+/// @return true on success, false if an option is not recognized.
+bool parseCounterOptions(int argc, char *argv[], CounterBenchmarkConfiguration &configuration) {
+    using Configuration = CounterBenchmarkConfiguration;
+    static constexpr Option<Configuration> options[] = {
+            {"--channels",
+             [](Configuration &c, unsigned long long value) { c.channelCount = static_cast<unsigned int>(value); }},
+            {"--capacity", [](Configuration &c, unsigned long long value) { c.capacityFrames = value; }},
+            {"--slice", [](Configuration &c, unsigned long long value) { c.sliceFrames = value; }},
+            {"--frames", [](Configuration &c, unsigned long long value) { c.frameCount = value; }},
+            {"--coherence-event", [](Configuration &c, unsigned long long value) { c.coherenceEvent = value; }},
+    };
+
+    return parseOptions(argc, argv, options, configuration);
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[]) {
+    // `driver [--period=N] [--capacity=N] [--prefill=N] [--producer=N] [--jitter=us] [--seconds=N] [--priority=N]`
+    // runs only the driver simulator
+    if (argc > 1 && std::strcmp(argv[1], "driver") == 0) {
+        DriverSimulatorConfiguration configuration;
+        if (!parseDriverOptions(argc - 2, argv + 2, configuration)) {
+            std::fprintf(stderr, "Usage: %s driver [--period=frames] [--capacity=frames] [--prefill=frames] "
+                                 "[--producer=frames] [--jitter=us] [--seconds=s] [--priority=n]\n",
+                         argv[0]);
+            return EXIT_FAILURE;
+        }
+        return runDriverSimulator(configuration) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // `counters [--channels=N] [--capacity=N] [--slice=N] [--frames=N] [--coherence-event=0xN]` runs only the
+    // hardware counter benchmark
+    if (argc > 1 && std::strcmp(argv[1], "counters") == 0) {
+        CounterBenchmarkConfiguration configuration;
+        if (!parseCounterOptions(argc - 2, argv + 2, configuration)) {
+            std::fprintf(stderr, "Usage: %s counters [--channels=n] [--capacity=frames] [--slice=frames] "
+                                 "[--frames=n] [--coherence-event=raw-config]\n",
+                         argv[0]);
+            return EXIT_FAILURE;
+        }
+        return runCounterBenchmark(configuration) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const auto format = benchmarkFormat();
+    const std::size_t requestedCapacities[] = {4800, 48000, 65536, 96001};
+    const std::size_t sliceSizes[] = {64, 512, 4096};
+
+    std::printf("%-10s %-7s %-6s %10s %12s %10s\n", "requested", "slice", "mode", "capacity", "bytes", "ns/frame");
+
+    for (const auto requestedCapacity : requestedCapacities) {
+        spsc::AudioRingBuffer maskBuffer;
+        spsc::ExactAudioRingBuffer exactBuffer;
+        if (!maskBuffer.allocate(format, requestedCapacity) || !exactBuffer.allocate(format, requestedCapacity)) {
+            std::fprintf(stderr, "Unable to allocate ring buffers with capacity %zu\n", requestedCapacity);
+            return EXIT_FAILURE;
+        }
+
+        for (const auto sliceFrames : sliceSizes) {
+            if (sliceFrames > requestedCapacity) {
+                continue;
+            }
+
+            const auto maskCost = nanosecondsPerFrame(maskBuffer, sliceFrames);
+            const auto exactCost = nanosecondsPerFrame(exactBuffer, sliceFrames);
+
+            std::printf("%-10zu %-7zu %-6s %10zu %12zu %10.3f\n", requestedCapacity, sliceFrames, "mask",
+                        maskBuffer.capacity(), storageBytes(maskBuffer), maskCost);
+            std::printf("%-10zu %-7zu %-6s %10zu %12zu %10.3f\n", requestedCapacity, sliceFrames, "exact",
+                        exactBuffer.capacity(), storageBytes(exactBuffer), exactCost);
+        }
+    }
+
+    std::printf("\n%-8s %-7s %12s %12s\n", "members", "slice", "separate", "writeAll");
+
+    // Cached slices show the chunking overhead; at the largest slice the members of the larger groups outgrow a typical
+    // last-level cache, and reading the source once is what counts
+    for (const std::size_t memberCount : {2, 4, 8}) {
+        for (const std::size_t sliceFrames : {512, 16384, 1048576}) {
+            std::printf("%-8zu %-7zu %12.3f %12.3f\n", memberCount, sliceFrames,
+                        fanOutNanosecondsPerFrame(memberCount, sliceFrames, false),
+                        fanOutNanosecondsPerFrame(memberCount, sliceFrames, true));
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+// Replays producer and consumer traces saved by spsc::AudioRingBufferTracer against a simulated ring buffer using the
+// same position arithmetic as spsc::AudioRingBuffer, and reports the smallest capacity that avoids underruns and
+// overruns.
+//
+// The trace is split into windows, each replayed from the same starting fill level. For a percentile p, the reported
+// capacity is the smallest for which at least p percent of the windows replay with no underruns or overruns; the
+// 100th percentile covers every window.
+
+#include "spsc/AudioRingBuffer.hpp"
+#include "spsc/BitOperations.hpp"
+#include "spsc/RingBufferIndex.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using SizeType = spsc::AudioRingBuffer::SizeType;
+
+/// A recorded call.
+struct TraceEvent {
+    /// The time of the call in nanoseconds.
+    long long timestamp{0};
+    /// The number of audio frames the caller asked to transfer.
+    SizeType frameCount{0};
+    /// true for a write, false for a read.
+    bool isWrite{false};
+};
+
+/// The outcome of replaying events.
+struct ReplayResult {
+    /// The number of reads that found fewer frames than requested.
+    SizeType underrunCount{0};
+    /// The number of writes that found less space than requested.
+    SizeType overrunCount{0};
+};
+
+/// The fill levels, as fractions of capacity, at which each replay starts.
+constexpr double prefillFractions[] = {0, 0.25, 0.5, 0.75};
+/// The largest capacity swept.
+constexpr SizeType maxSweptCapacity = SizeType{1} << 24;
+
+/// Appends the events in a file written by AudioRingBufferTracer::save.
+/// @return true on success, false if the file could not be read.
+bool loadTrace(const char *path, std::vector<TraceEvent> &events) {
+    auto file = std::fopen(path, "r");
+    if (file == nullptr) {
+        std::fprintf(stderr, "Unable to open %s\n", path);
+        return false;
+    }
+
+    char operation = 0;
+    long long timestamp = 0;
+    unsigned long long framesRequested = 0;
+    unsigned long long framesTransferred = 0;
+    while (std::fscanf(file, " %c,%lld,%llu,%llu", &operation, &timestamp, &framesRequested, &framesTransferred) ==
+           4) {
+        events.push_back({timestamp, static_cast<SizeType>(framesRequested), operation == 'w'});
+    }
+
+    const auto ok = std::feof(file) != 0;
+    std::fclose(file);
+    if (!ok) {
+        std::fprintf(stderr, "Malformed trace %s\n", path);
+    }
+    return ok;
+}
+
+/// Replays events against a ring of capacity frames that starts holding prefillFrames frames.
+ReplayResult replay(const TraceEvent *begin, const TraceEvent *end, SizeType capacity, SizeType prefillFrames) {
+    spsc::detail::RingBufferIndex index;
+    index.reset(capacity);
+    index.commitWrite(index.reserveWrite(prefillFrames).count());
+
+    ReplayResult result;
+    for (auto event = begin; event != end; ++event) {
+        if (event->isWrite) {
+            const auto count = index.reserveWrite(event->frameCount).count();
+            if (count < event->frameCount) {
+                ++result.overrunCount;
+            }
+            index.commitWrite(count);
+        } else {
+            const auto count = index.reserveRead(event->frameCount).count();
+            if (count < event->frameCount) {
+                ++result.underrunCount;
+            }
+            index.commitRead(count);
+        }
+    }
+    return result;
+}
+
+/// Parses a comma-separated list of percentiles.
+bool parsePercentiles(const char *list, std::vector<double> &percentiles) {
+    percentiles.clear();
+    while (*list != '\0') {
+        char *end = nullptr;
+        const auto value = std::strtod(list, &end);
+        if (end == list || value <= 0 || value > 100) {
+            return false;
+        }
+        percentiles.push_back(value);
+        list = *end == ',' ? end + 1 : end;
+    }
+    return !percentiles.empty();
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[]) {
+    long long windowNanoseconds = 1'000'000'000;
+    std::vector<double> percentiles = {50, 99, 99.9, 100};
+    std::vector<TraceEvent> events;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto argument = std::string_view{argv[i]};
+        if (argument.rfind("--window=", 0) == 0) {
+            windowNanoseconds = std::strtoll(argv[i] + 9, nullptr, 10) * 1'000'000;
+        } else if (argument.rfind("--percentiles=", 0) == 0) {
+            if (!parsePercentiles(argv[i] + 14, percentiles)) {
+                std::fprintf(stderr, "Invalid percentiles %s\n", argv[i] + 14);
+                return EXIT_FAILURE;
+            }
+        } else if (!loadTrace(argv[i], events)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (events.empty() || windowNanoseconds <= 0) {
+        std::fprintf(stderr, "Usage: %s [--window=ms] [--percentiles=50,99,99.9,100] trace.csv [trace.csv ...]\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Merge producer and consumer events into the order the calls were made
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent &a, const TraceEvent &b) { return a.timestamp < b.timestamp; });
+
+    // Split the trace into windows
+    std::vector<std::size_t> windowStarts{0};
+    for (std::size_t i = 1; i < events.size(); ++i) {
+        if (events[i].timestamp - events[windowStarts.back()].timestamp >= windowNanoseconds) {
+            windowStarts.push_back(i);
+        }
+    }
+    windowStarts.push_back(events.size());
+    const auto windowCount = windowStarts.size() - 1;
+
+    SizeType largestRequest = 1;
+    for (const auto &event : events) {
+        largestRequest = std::max(largestRequest, event.frameCount);
+    }
+    const auto minSweptCapacity = std::max(spsc::detail::bit_ceil(largestRequest), spsc::AudioRingBuffer::minCapacity);
+
+    std::printf("%zu events in %zu windows of %lld ms\n\n", events.size(), windowCount, windowNanoseconds / 1'000'000);
+
+    // Full-trace underruns and overruns for each capacity and starting fill level
+    std::printf("%-10s", "capacity");
+    for (const auto fraction : prefillFractions) {
+        char heading[32];
+        std::snprintf(heading, sizeof heading, "prefill %.0f%% (u/o)", fraction * 100);
+        std::printf("  %19s", heading);
+    }
+    std::printf("\n");
+
+    // The smallest capacity meeting each percentile, for each starting fill level
+    std::vector<std::vector<SizeType>> plannedCapacities(std::size(prefillFractions),
+                                                         std::vector<SizeType>(percentiles.size(), 0));
+
+    // Stop once more capacity no longer changes anything: no overruns and an unchanged underrun count, which with too
+    // little prefill no capacity can cure
+    std::vector<ReplayResult> previousTotals(std::size(prefillFractions), ReplayResult{~SizeType{0}, ~SizeType{0}});
+
+    for (auto capacity = minSweptCapacity; capacity <= maxSweptCapacity; capacity *= 2) {
+        bool settled = true;
+        std::printf("%-10zu", static_cast<std::size_t>(capacity));
+
+        for (std::size_t f = 0; f < std::size(prefillFractions); ++f) {
+            const auto prefillFrames = static_cast<SizeType>(prefillFractions[f] * static_cast<double>(capacity));
+
+            const auto total = replay(events.data(), events.data() + events.size(), capacity, prefillFrames);
+            std::printf("  %9zu/%-9zu", static_cast<std::size_t>(total.underrunCount),
+                        static_cast<std::size_t>(total.overrunCount));
+
+            std::size_t cleanWindowCount = 0;
+            for (std::size_t w = 0; w < windowCount; ++w) {
+                const auto result = replay(events.data() + windowStarts[w], events.data() + windowStarts[w + 1],
+                                           capacity, prefillFrames);
+                if (result.underrunCount == 0 && result.overrunCount == 0) {
+                    ++cleanWindowCount;
+                }
+            }
+
+            const auto cleanPercent = 100 * static_cast<double>(cleanWindowCount) / static_cast<double>(windowCount);
+            for (std::size_t p = 0; p < percentiles.size(); ++p) {
+                if (plannedCapacities[f][p] == 0 && cleanPercent >= percentiles[p]) {
+                    plannedCapacities[f][p] = capacity;
+                }
+            }
+
+            settled = settled && total.overrunCount == 0 && total.underrunCount == previousTotals[f].underrunCount;
+            previousTotals[f] = total;
+        }
+        std::printf("\n");
+
+        if (settled) {
+            break;
+        }
+    }
+
+    std::printf("\nminimum capacity with no underruns or overruns in p%% of windows\n%-14s", "prefill");
+    for (const auto percentile : percentiles) {
+        std::printf("  p%-8g", percentile);
+    }
+    std::printf("\n");
+    for (std::size_t f = 0; f < std::size(prefillFractions); ++f) {
+        std::printf("%12.0f%%", prefillFractions[f] * 100);
+        for (std::size_t p = 0; p < percentiles.size(); ++p) {
+            if (plannedCapacities[f][p] != 0) {
+                std::printf("  %-9zu", static_cast<std::size_t>(plannedCapacities[f][p]));
+            } else {
+                std::printf("  %-9s", "-");
+            }
+        }
+        std::printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
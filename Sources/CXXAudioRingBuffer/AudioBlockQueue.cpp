@@ -0,0 +1,217 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioBlockQueue.hpp"
+
+#include "spsc/BitOperations.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <utility>
+
+struct spsc::AudioBlockQueue::Slot {
+    /// Equals the slot's next push position when free and that position plus one once published.
+    std::atomic<SizeType> sequence{0};
+    /// The number of valid audio frames in the published block.
+    SizeType frameCount{0};
+};
+
+// MARK: Construction and Destruction
+
+spsc::AudioBlockQueue::AudioBlockQueue() noexcept = default;
+
+spsc::AudioBlockQueue::AudioBlockQueue(AudioBlockQueue &&other) noexcept
+    : buffers_{std::exchange(other.buffers_, nullptr)}, slots_{std::move(other.slots_)},
+      blockFrameCount_{std::exchange(other.blockFrameCount_, 0)}, slotCount_{std::exchange(other.slotCount_, 0)},
+      slotMask_{std::exchange(other.slotMask_, 0)}, pushPosition_{std::exchange(other.pushPosition_, 0)},
+      claimPosition_{other.claimPosition_.exchange(0, std::memory_order_relaxed)},
+      format_{std::exchange(other.format_, {})} {}
+
+auto spsc::AudioBlockQueue::operator=(AudioBlockQueue &&other) noexcept -> AudioBlockQueue & {
+    if (this != &other) [[likely]] {
+        std::free(buffers_);
+        buffers_ = std::exchange(other.buffers_, nullptr);
+        slots_ = std::move(other.slots_);
+
+        blockFrameCount_ = std::exchange(other.blockFrameCount_, 0);
+        slotCount_ = std::exchange(other.slotCount_, 0);
+        slotMask_ = std::exchange(other.slotMask_, 0);
+
+        pushPosition_ = std::exchange(other.pushPosition_, 0);
+        claimPosition_.store(other.claimPosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        format_ = std::exchange(other.format_, {});
+    }
+    return *this;
+}
+
+spsc::AudioBlockQueue::~AudioBlockQueue() noexcept { std::free(buffers_); }
+
+// MARK: Buffer Management
+
+bool spsc::AudioBlockQueue::allocate(const AudioStreamBasicDescription &format, SizeType blockFrameCount,
+                                     SizeType minSlotCount) noexcept {
+    if ((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 || format.mBytesPerFrame == 0 ||
+        format.mChannelsPerFrame == 0) [[unlikely]] {
+        return false;
+    }
+    if (blockFrameCount == 0 || minSlotCount < 2 ||
+        minSlotCount > (SizeType{1} << (std::numeric_limits<SizeType>::digits - 1))) [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    // Round to nearest power of two
+    const auto slotCount = detail::bit_ceil(minSlotCount);
+
+    /// Values larger than this will exceed the maximum allocation size
+    const auto maxChannelBufferByteSize =
+            (std::numeric_limits<std::size_t>::max() / format.mChannelsPerFrame) - sizeof(void *);
+    if (blockFrameCount > maxChannelBufferByteSize / format.mBytesPerFrame / slotCount) [[unlikely]] {
+        return false;
+    }
+
+    const auto channelBufferByteSize = slotCount * blockFrameCount * format.mBytesPerFrame;
+    const auto allocationSize = (channelBufferByteSize + sizeof(void *)) * format.mChannelsPerFrame;
+
+    auto slots = std::unique_ptr<Slot[]>(new (std::nothrow) Slot[slotCount]);
+    if (!slots) [[unlikely]] {
+        return false;
+    }
+
+    void *allocation = std::calloc(1, allocationSize);
+    if (allocation == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    // Assign the channel buffers
+    auto address = reinterpret_cast<uintptr_t>(allocation);
+
+    buffers_ = reinterpret_cast<void **>(address);
+    address += format.mChannelsPerFrame * sizeof(void *);
+    for (UInt32 i = 0; i < format.mChannelsPerFrame; ++i) {
+        buffers_[i] = reinterpret_cast<void *>(address);
+        address += channelBufferByteSize;
+    }
+
+    for (SizeType i = 0; i < slotCount; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    slots_ = std::move(slots);
+
+    blockFrameCount_ = blockFrameCount;
+    slotCount_ = slotCount;
+    slotMask_ = slotCount - 1;
+
+    pushPosition_ = 0;
+    claimPosition_.store(0, std::memory_order_relaxed);
+
+    format_ = format;
+
+    return true;
+}
+
+void spsc::AudioBlockQueue::deallocate() noexcept {
+    if (buffers_) [[likely]] {
+        std::free(buffers_);
+        buffers_ = nullptr;
+        slots_.reset();
+
+        blockFrameCount_ = 0;
+        slotCount_ = 0;
+        slotMask_ = 0;
+
+        pushPosition_ = 0;
+        claimPosition_.store(0, std::memory_order_relaxed);
+
+        format_ = {};
+    }
+}
+
+// MARK: Producing
+
+bool spsc::AudioBlockQueue::reserve(Block &block) noexcept {
+    if (buffers_ == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    const auto position = pushPosition_;
+    const auto slot = position & slotMask_;
+
+    // A slot is free for this pass once the consumer of the previous pass has completed it
+    if (slots_[slot].sequence.load(std::memory_order_acquire) != position) {
+        return false;
+    }
+
+    block = {position, slot, blockFrameCount_};
+    return true;
+}
+
+void spsc::AudioBlockQueue::publish(const Block &block, SizeType frameCount) noexcept {
+    assert(block.sequence == pushPosition_ && frameCount <= blockFrameCount_);
+
+    auto &slot = slots_[block.slot];
+    slot.frameCount = frameCount;
+    slot.sequence.store(block.sequence + 1, std::memory_order_release);
+
+    ++pushPosition_;
+}
+
+bool spsc::AudioBlockQueue::push(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept {
+    assert(frameCount <= blockFrameCount_);
+
+    Block block;
+    if (bufferList == nullptr || !reserve(block)) [[unlikely]] {
+        return false;
+    }
+
+    const auto byteCount = frameCount * format_.mBytesPerFrame;
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+        assert(byteCount <= bufferList->mBuffers[i].mDataByteSize);
+        std::memcpy(channelData(block, i), bufferList->mBuffers[i].mData, byteCount);
+    }
+
+    publish(block, frameCount);
+    return true;
+}
+
+// MARK: Consuming
+
+bool spsc::AudioBlockQueue::claim(Block &block) noexcept {
+    if (buffers_ == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    auto position = claimPosition_.load(std::memory_order_relaxed);
+    for (;;) {
+        auto &slot = slots_[position & slotMask_];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0) {
+            // The block is published; take it unless another consumer got there first
+            if (claimPosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                block = {position, position & slotMask_, slot.frameCount};
+                return true;
+            }
+        } else if (difference < 0) {
+            // The producer has not published this block yet
+            return false;
+        } else {
+            // Another consumer claimed the block
+            position = claimPosition_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void spsc::AudioBlockQueue::complete(const Block &block) noexcept {
+    // The slot is next used for the block one full pass later
+    slots_[block.slot].sequence.store(block.sequence + slotCount_, std::memory_order_release);
+}
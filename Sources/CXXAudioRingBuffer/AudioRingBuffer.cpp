@@ -7,45 +7,16 @@
 
 #include "spsc/AudioRingBuffer.hpp"
 
+#include "spsc/BitOperations.hpp"
+
 #include <cstdlib>
 #include <limits>
 #include <new>
 #include <stdexcept>
 #include <utility>
 
-namespace {
-
-/// Returns the number of leading 0-bits in x, starting at the most significant bit position.
-template <typename T> constexpr int clz(T x) noexcept {
-    static_assert(std::is_unsigned_v<T>, "Only unsigned types supported");
-    if (x == 0) {
-        return sizeof(T) * CHAR_BIT;
-    }
-    if constexpr (sizeof(T) < sizeof(unsigned int)) {
-        return __builtin_clz(x) - (sizeof(unsigned int) - sizeof(T)) * CHAR_BIT;
-    } else if constexpr (sizeof(T) == sizeof(unsigned int)) {
-        return __builtin_clz(x);
-    } else if constexpr (sizeof(T) == sizeof(unsigned long)) {
-        return __builtin_clzl(x);
-    } else {
-        return __builtin_clzll(x);
-    }
-}
-
-/// Calculates and returns the smallest integral power of two not less than x.
-/// @param x A value on the closed interval [0, 2147483648].
-/// @return The smallest integral power of two not less than x.
-template <typename T> constexpr T bit_ceil(T x) noexcept {
-    static_assert(std::is_unsigned_v<T>, "Only unsigned types supported");
-    if (x < 2) {
-        return 1;
-    }
-    const auto n = std::numeric_limits<T>::digits - clz(x - 1);
-    assert(n != std::numeric_limits<T>::digits);
-    return T{1} << n;
-}
-
-} /* namespace */
+#include <sys/mman.h>
+#include <unistd.h>
 
 // MARK: Construction and Destruction
 
@@ -63,24 +34,26 @@ spsc::AudioRingBuffer::AudioRingBuffer(const AudioStreamBasicDescription &format
 }
 
 spsc::AudioRingBuffer::AudioRingBuffer(AudioRingBuffer &&other) noexcept
-    : buffers_{std::exchange(other.buffers_, nullptr)}, capacity_{std::exchange(other.capacity_, 0)},
-      capacityMask_{std::exchange(other.capacityMask_, 0)},
-      writePosition_{other.writePosition_.exchange(0, std::memory_order_relaxed)},
-      readPosition_{other.readPosition_.exchange(0, std::memory_order_relaxed)},
-      format_{std::exchange(other.format_, {})} {}
+    : buffers_{std::exchange(other.buffers_, nullptr)}, allocationSize_{std::exchange(other.allocationSize_, 0)},
+      index_{std::move(other.index_)}, format_{std::exchange(other.format_, {})},
+      underrunCount_{other.underrunCount_.exchange(0, std::memory_order_relaxed)},
+      overrunCount_{other.overrunCount_.exchange(0, std::memory_order_relaxed)},
+      costHistograms_{other.costHistograms_.exchange(nullptr, std::memory_order_relaxed)} {}
 
 auto spsc::AudioRingBuffer::operator=(AudioRingBuffer &&other) noexcept -> AudioRingBuffer & {
     if (this != &other) [[likely]] {
         std::free(buffers_);
         buffers_ = std::exchange(other.buffers_, nullptr);
+        allocationSize_ = std::exchange(other.allocationSize_, 0);
 
-        capacity_ = std::exchange(other.capacity_, 0);
-        capacityMask_ = std::exchange(other.capacityMask_, 0);
-
-        writePosition_.store(other.writePosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
-        readPosition_.store(other.readPosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        index_ = std::move(other.index_);
 
         format_ = std::exchange(other.format_, {});
+
+        underrunCount_.store(other.underrunCount_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        overrunCount_.store(other.overrunCount_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        costHistograms_.store(other.costHistograms_.exchange(nullptr, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
     }
     return *this;
 }
@@ -110,23 +83,28 @@ bool spsc::AudioRingBuffer::allocate(const AudioStreamBasicDescription &format,
             std::min(static_cast<std::size_t>(maxAudioBufferFrameCount), maxAllocationFrameCount);
 
     // Round to nearest power of two
-    const auto channelBufferFrameSize = bit_ceil(minFrameCapacity);
+    const auto channelBufferFrameSize = detail::bit_ceil(minFrameCapacity);
     if (channelBufferFrameSize > maxChannelBufferFrameSize) [[unlikely]] {
         return false;
     }
 
-    deallocate();
-
     const auto channelBufferByteSize = channelBufferFrameSize * format.mBytesPerFrame;
     const auto allocationSize = (channelBufferByteSize + sizeof(void *)) * format.mChannelsPerFrame;
 
-    auto allocation = std::malloc(allocationSize);
-    if (allocation == nullptr) [[unlikely]] {
-        return false;
-    }
+    void *allocation = buffers_;
 
-    // Zero the entire allocation
-    std::memset(allocation, 0, allocationSize);
+    // Reuse the existing allocation if it is large enough
+    if (allocationSize > allocationSize_) {
+        deallocate();
+
+        // Large zeroed allocations are satisfied with untouched zero-fill pages, so no pages are committed here
+        allocation = std::calloc(1, allocationSize);
+        if (allocation == nullptr) [[unlikely]] {
+            return false;
+        }
+
+        allocationSize_ = allocationSize;
+    }
 
     // Assign the channel buffers
     auto address = reinterpret_cast<uintptr_t>(allocation);
@@ -138,14 +116,13 @@ bool spsc::AudioRingBuffer::allocate(const AudioStreamBasicDescription &format,
         address += channelBufferByteSize;
     }
 
-    capacity_ = channelBufferFrameSize;
-    capacityMask_ = channelBufferFrameSize - 1;
-
-    writePosition_.store(0, std::memory_order_relaxed);
-    readPosition_.store(0, std::memory_order_relaxed);
+    index_.reset(channelBufferFrameSize);
 
     format_ = format;
 
+    underrunCount_.store(0, std::memory_order_relaxed);
+    overrunCount_.store(0, std::memory_order_relaxed);
+
     return true;
 }
 
@@ -153,13 +130,75 @@ void spsc::AudioRingBuffer::deallocate() noexcept {
     if (buffers_) [[likely]] {
         std::free(buffers_);
         buffers_ = nullptr;
+        allocationSize_ = 0;
 
-        capacity_ = 0;
-        capacityMask_ = 0;
-
-        writePosition_.store(0, std::memory_order_relaxed);
-        readPosition_.store(0, std::memory_order_relaxed);
+        index_.reset(0);
 
         format_ = {};
     }
 }
+
+void spsc::AudioRingBuffer::prefault() noexcept {
+    if (buffers_ == nullptr) [[unlikely]] {
+        return;
+    }
+
+    /// A stride no larger than the smallest page size in use
+    constexpr std::size_t pageStride = 4096;
+
+    auto allocation = reinterpret_cast<volatile unsigned char *>(buffers_);
+
+    // Writing one byte per page forces the page to be committed; the value is unchanged
+    for (std::size_t offset = 0; offset < allocationSize_; offset += pageStride) {
+        allocation[offset] = allocation[offset];
+    }
+    allocation[allocationSize_ - 1] = allocation[allocationSize_ - 1];
+}
+
+auto spsc::AudioRingBuffer::reclaimFreeSpace(SizeType keepFrames) noexcept -> SizeType {
+    if (buffers_ == nullptr) [[unlikely]] {
+        return 0;
+    }
+
+    // A stale read position only makes the free region appear smaller
+    const auto writePos = index_.writePosition();
+    const auto framesFree = index_.freeSpace();
+
+    if (framesFree <= keepFrames) {
+        return 0;
+    }
+
+    static const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+
+#if defined(MADV_FREE)
+    constexpr int advice = MADV_FREE;
+#else
+    constexpr int advice = MADV_DONTNEED;
+#endif
+
+    /// Releases the whole pages in [begin, end) and returns the number of bytes released.
+    const auto release = [](uintptr_t begin, uintptr_t end) noexcept -> SizeType {
+        begin = (begin + pageSize - 1) & ~(pageSize - 1);
+        end &= ~(pageSize - 1);
+        if (end <= begin || madvise(reinterpret_cast<void *>(begin), end - begin, advice) != 0) {
+            return 0;
+        }
+        return end - begin;
+    };
+
+    const auto startIndex = index_.wrap(writePos + keepFrames);
+    const auto frameCount = framesFree - keepFrames;
+    const auto framesToEnd = std::min(frameCount, index_.capacity() - startIndex);
+
+    SizeType bytesReleased = 0;
+    for (UInt32 i = 0; i < format_.mChannelsPerFrame; ++i) {
+        const auto base = reinterpret_cast<uintptr_t>(buffers_[i]);
+        bytesReleased += release(base + startIndex * format_.mBytesPerFrame,
+                                 base + (startIndex + framesToEnd) * format_.mBytesPerFrame);
+        if (framesToEnd < frameCount) {
+            bytesReleased += release(base, base + (frameCount - framesToEnd) * format_.mBytesPerFrame);
+        }
+    }
+
+    return bytesReleased;
+}
@@ -0,0 +1,178 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferCostHistograms.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+/// Returns the value of a fast, monotonic tick counter.
+///
+/// The counter is the time stamp counter on x86, the virtual counter `cntvct_el0` on arm64, and nanoseconds of
+/// `std::chrono::steady_clock` elsewhere.
+inline std::uint64_t readTickCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+#endif
+}
+
+} /* namespace */
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferCostHistograms::AudioRingBufferCostHistograms(AudioRingBufferCostHistograms &&other) noexcept {
+    *this = std::move(other);
+}
+
+auto spsc::AudioRingBufferCostHistograms::operator=(AudioRingBufferCostHistograms &&other) noexcept
+        -> AudioRingBufferCostHistograms & {
+    if (this != &other) [[likely]] {
+        for (std::size_t phase = 0; phase < phaseCount; ++phase) {
+            auto &histogram = histograms_[phase];
+            auto &otherHistogram = other.histograms_[phase];
+            for (std::size_t i = 0; i < bucketCount; ++i) {
+                histogram.counts[i].store(otherHistogram.counts[i].exchange(0, std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+            }
+            histogram.ticks.store(otherHistogram.ticks.exchange(0, std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+        }
+    }
+    return *this;
+}
+
+// MARK: Phases and Buckets
+
+const char *spsc::AudioRingBufferCostHistograms::name(Phase phase) noexcept {
+    switch (phase) {
+    case Phase::writeReserve:
+        return "writeReserve";
+    case Phase::writeCopy:
+        return "writeCopy";
+    case Phase::writeCommit:
+        return "writeCommit";
+    case Phase::readReserve:
+        return "readReserve";
+    case Phase::readCopy:
+        return "readCopy";
+    case Phase::readCommit:
+        return "readCommit";
+    case Phase::readSilence:
+        return "readSilence";
+    }
+    return "unknown";
+}
+
+double spsc::AudioRingBufferCostHistograms::ticksPerSecond() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    // The time stamp counter frequency is not architecturally visible, so measure it against steady_clock
+    static const double calibratedTicksPerSecond = [] {
+        const auto startTime = std::chrono::steady_clock::now();
+        const auto startTicks = readTickCounter();
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        const auto ticks = readTickCounter() - startTicks;
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return static_cast<double>(ticks) / elapsed;
+    }();
+    return calibratedTicksPerSecond;
+#elif defined(__aarch64__)
+    std::uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return static_cast<double>(frequency);
+#else
+    return 1e9;
+#endif
+}
+
+// MARK: Recording
+
+void spsc::AudioRingBufferCostHistograms::reset() noexcept {
+    for (auto &histogram : histograms_) {
+        for (auto &count : histogram.counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        histogram.ticks.store(0, std::memory_order_relaxed);
+    }
+}
+
+// MARK: Exporting
+
+auto spsc::AudioRingBufferCostHistograms::totalCount(Phase phase) const noexcept -> std::uint64_t {
+    std::uint64_t total = 0;
+    for (const auto &count : histograms_[static_cast<std::size_t>(phase)].counts) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+auto spsc::AudioRingBufferCostHistograms::percentile(Phase phase, double percentile) const noexcept -> std::uint64_t {
+    const auto &histogram = histograms_[static_cast<std::size_t>(phase)];
+
+    // Copy the counts once so a concurrent recorder cannot make the total and the walk disagree
+    std::uint64_t counts[bucketCount];
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        counts[i] = histogram.counts[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<std::uint64_t>(std::ceil(percentile / 100 * static_cast<double>(total)));
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        cumulative += counts[i];
+        if (cumulative >= rank && counts[i] != 0) {
+            return bucketLowerBound(i);
+        }
+    }
+    return bucketLowerBound(bucketCount - 1);
+}
+
+bool spsc::AudioRingBufferCostHistograms::save(std::FILE *_Nonnull file) const noexcept {
+    for (std::size_t phase = 0; phase < phaseCount; ++phase) {
+        for (std::size_t i = 0; i < bucketCount; ++i) {
+            const auto count = histograms_[phase].counts[i].load(std::memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            if (std::fprintf(file, "%s,%llu,%llu\n", name(static_cast<Phase>(phase)),
+                             static_cast<unsigned long long>(bucketLowerBound(i)),
+                             static_cast<unsigned long long>(count)) < 0) [[unlikely]] {
+                return false;
+            }
+        }
+    }
+    return std::ferror(file) == 0;
+}
+
+// MARK: - Timer
+
+std::uint64_t spsc::detail::CostTimer::now() noexcept { return readTickCounter(); }
+
+void spsc::detail::CostTimer::record(AudioRingBufferCostPhase phase) noexcept {
+    const auto ticks = readTickCounter();
+    histograms_->record(phase, ticks - ticks_);
+    ticks_ = ticks;
+}
@@ -0,0 +1,152 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferGroup.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+struct spsc::AudioRingBufferGroup::Member {
+    /// The member ring buffer.
+    AudioRingBuffer *ringBuffer{nullptr};
+    /// The space reserved in the member during the current call to writeAll.
+    AudioRingBuffer::Region region{};
+};
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferGroup::AudioRingBufferGroup() noexcept = default;
+
+spsc::AudioRingBufferGroup::AudioRingBufferGroup(AudioRingBufferGroup &&other) noexcept
+    : members_{std::move(other.members_)}, maxMemberCount_{std::exchange(other.maxMemberCount_, 0)},
+      memberCount_{std::exchange(other.memberCount_, 0)} {}
+
+auto spsc::AudioRingBufferGroup::operator=(AudioRingBufferGroup &&other) noexcept -> AudioRingBufferGroup & {
+    if (this != &other) [[likely]] {
+        members_ = std::move(other.members_);
+        maxMemberCount_ = std::exchange(other.maxMemberCount_, 0);
+        memberCount_ = std::exchange(other.memberCount_, 0);
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferGroup::~AudioRingBufferGroup() noexcept = default;
+
+// MARK: Group Management
+
+bool spsc::AudioRingBufferGroup::allocate(SizeType maxMemberCount) noexcept {
+    deallocate();
+
+    auto members = std::unique_ptr<Member[]>(new (std::nothrow) Member[maxMemberCount]);
+    if (!members) [[unlikely]] {
+        return false;
+    }
+
+    members_ = std::move(members);
+    maxMemberCount_ = maxMemberCount;
+    return true;
+}
+
+void spsc::AudioRingBufferGroup::deallocate() noexcept {
+    members_.reset();
+    maxMemberCount_ = 0;
+    memberCount_ = 0;
+}
+
+bool spsc::AudioRingBufferGroup::add(AudioRingBuffer &ringBuffer) noexcept {
+    if (memberCount_ == maxMemberCount_ || !ringBuffer) [[unlikely]] {
+        return false;
+    }
+
+    if (memberCount_ > 0) {
+        const auto &format = members_[0].ringBuffer->format();
+        if (ringBuffer.format().mChannelsPerFrame != format.mChannelsPerFrame ||
+            ringBuffer.format().mBytesPerFrame != format.mBytesPerFrame) [[unlikely]] {
+            return false;
+        }
+    }
+
+    members_[memberCount_++].ringBuffer = &ringBuffer;
+    return true;
+}
+
+void spsc::AudioRingBufferGroup::remove(const AudioRingBuffer &ringBuffer) noexcept {
+    for (SizeType i = 0; i < memberCount_; ++i) {
+        if (members_[i].ringBuffer == &ringBuffer) {
+            members_[i] = members_[--memberCount_];
+            members_[memberCount_] = {};
+            return;
+        }
+    }
+}
+
+// MARK: Writing Audio
+
+auto spsc::AudioRingBufferGroup::writeAll(const AudioBufferList *const _Nonnull bufferList,
+                                          SizeType frameCount) noexcept -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || memberCount_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    SizeType minFramesWritten = frameCount;
+    SizeType maxFramesWritten = 0;
+    for (SizeType i = 0; i < memberCount_; ++i) {
+        auto &member = members_[i];
+        member.region = member.ringBuffer->reserveWrite(frameCount);
+        minFramesWritten = std::min(minFramesWritten, member.region.count());
+        maxFramesWritten = std::max(maxFramesWritten, member.region.count());
+    }
+
+    const auto bytesPerFrame = members_[0].ringBuffer->format().mBytesPerFrame;
+    const auto chunkFrameCount = std::max(chunkByteSize / bytesPerFrame, SizeType{1});
+
+    for (UInt32 channel = 0; channel < bufferList->mNumberBuffers; ++channel) {
+        assert(maxFramesWritten * bytesPerFrame <= bufferList->mBuffers[channel].mDataByteSize);
+        const auto src = static_cast<const unsigned char *>(bufferList->mBuffers[channel].mData);
+
+        for (SizeType chunkStart = 0; chunkStart < maxFramesWritten; chunkStart += chunkFrameCount) {
+            const auto chunkEnd = std::min(chunkStart + chunkFrameCount, maxFramesWritten);
+
+            // The chunk stays in cache while it is stored to every member
+            for (SizeType i = 0; i < memberCount_; ++i) {
+                const auto &member = members_[i];
+                const auto &region = member.region;
+                const auto end = std::min(chunkEnd, region.count());
+                if (end <= chunkStart) {
+                    continue;
+                }
+
+                const auto dst = static_cast<unsigned char *>(member.ringBuffer->channelBuffer(channel));
+
+                // The part of the chunk before the wrap, then the part after it
+                auto offset = chunkStart;
+                if (offset < region.firstCount) {
+                    const auto count = std::min(end, region.firstCount) - offset;
+                    std::memcpy(dst + (region.index + offset) * bytesPerFrame, src + offset * bytesPerFrame,
+                                count * bytesPerFrame);
+                    offset += count;
+                }
+                if (offset < end) {
+                    std::memcpy(dst + (offset - region.firstCount) * bytesPerFrame, src + offset * bytesPerFrame,
+                                (end - offset) * bytesPerFrame);
+                }
+            }
+        }
+    }
+
+    for (SizeType i = 0; i < memberCount_; ++i) {
+        auto &member = members_[i];
+        if (member.region.count() != 0) {
+            member.ringBuffer->commitWrite(member.region.count());
+        }
+    }
+
+    return minFramesWritten;
+}
@@ -0,0 +1,383 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferMetrics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// The number of attempts to obtain a consistent copy of a slot.
+constexpr int maxReadAttempts = 16;
+
+/// Opens a slot for writing.
+void beginUpdate(spsc::AudioRingBufferMetricsSlot &slot) noexcept {
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // Order the odd sequence number before the field stores
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+/// Closes a slot after writing.
+void endUpdate(spsc::AudioRingBufferMetricsSlot &slot) noexcept {
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+} /* namespace */
+
+// MARK: Slot
+
+bool spsc::AudioRingBufferMetricsSlot::read(AudioRingBufferMetricsSnapshot &snapshot) const noexcept {
+    for (int attempt = 0; attempt < maxReadAttempts; ++attempt) {
+        const auto before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (inUse.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < sizeof snapshot.label; ++i) {
+            snapshot.label[i] = label[i].load(std::memory_order_relaxed);
+        }
+        snapshot.label[sizeof snapshot.label - 1] = '\0';
+        snapshot.capacity = capacity.load(std::memory_order_relaxed);
+        snapshot.writePosition = writePosition.load(std::memory_order_relaxed);
+        snapshot.readPosition = readPosition.load(std::memory_order_relaxed);
+        snapshot.minFill = minFill.load(std::memory_order_relaxed);
+        snapshot.maxFill = maxFill.load(std::memory_order_relaxed);
+        snapshot.fillSum = fillSum.load(std::memory_order_relaxed);
+        snapshot.sampleCount = sampleCount.load(std::memory_order_relaxed);
+        snapshot.underrunCount = underrunCount.load(std::memory_order_relaxed);
+        snapshot.overrunCount = overrunCount.load(std::memory_order_relaxed);
+        const auto sampleRate = sampleRateBits.load(std::memory_order_relaxed);
+        std::memcpy(&snapshot.sampleRate, &sampleRate, sizeof snapshot.sampleRate);
+        snapshot.formatID = formatID.load(std::memory_order_relaxed);
+        snapshot.formatFlags = formatFlags.load(std::memory_order_relaxed);
+        snapshot.bytesPerFrame = bytesPerFrame.load(std::memory_order_relaxed);
+        snapshot.channelsPerFrame = channelsPerFrame.load(std::memory_order_relaxed);
+        snapshot.bitsPerChannel = bitsPerChannel.load(std::memory_order_relaxed);
+
+        // Order the field loads before the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// MARK: - Registry
+
+struct spsc::AudioRingBufferMetricsRegistry::Publisher {
+    /// Fill statistics kept for a registered ring.
+    struct Entry {
+        /// The ring, or nullptr if the slot is free.
+        const AudioRingBuffer *ringBuffer{nullptr};
+        /// The smallest fill level sampled.
+        std::uint64_t minFill{0};
+        /// The largest fill level sampled.
+        std::uint64_t maxFill{0};
+        /// The sum of the fill levels sampled.
+        std::uint64_t fillSum{0};
+        /// The number of fill levels sampled.
+        std::uint64_t sampleCount{0};
+    };
+
+    /// The publisher thread.
+    std::thread thread;
+    /// Set to request the publisher thread exit.
+    std::atomic<bool> stop{false};
+    /// The interval between updates.
+    std::chrono::milliseconds interval{};
+    /// Serializes changes to entries with updates.
+    std::mutex mutex;
+    /// The registered rings.
+    Entry entries[AudioRingBufferMetricsPage::slotCount];
+    /// The shared-memory object name.
+    std::string name;
+    /// The mapped page.
+    AudioRingBufferMetricsPage *page{nullptr};
+
+    /// Copies the metrics of every registered ring to the page.
+    ///
+    /// The publisher thread calls this without reference to the registry so the registry may be moved while it runs.
+    void publish() noexcept;
+};
+
+bool spsc::AudioRingBufferMetricsRegistry::defaultName(int processID, char *_Nonnull name, std::size_t size) noexcept {
+    const auto length = std::snprintf(name, size, "/spsc-metrics.%d", processID);
+    return length > 0 && static_cast<std::size_t>(length) < size;
+}
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferMetricsRegistry::AudioRingBufferMetricsRegistry() noexcept = default;
+
+spsc::AudioRingBufferMetricsRegistry::AudioRingBufferMetricsRegistry(AudioRingBufferMetricsRegistry &&other) noexcept
+    : publisher_{std::move(other.publisher_)} {}
+
+auto spsc::AudioRingBufferMetricsRegistry::operator=(AudioRingBufferMetricsRegistry &&other) noexcept
+        -> AudioRingBufferMetricsRegistry & {
+    if (this != &other) [[likely]] {
+        close();
+        publisher_ = std::move(other.publisher_);
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferMetricsRegistry::~AudioRingBufferMetricsRegistry() noexcept { close(); }
+
+// MARK: Registry Management
+
+bool spsc::AudioRingBufferMetricsRegistry::open(const char *_Nullable name,
+                                                std::chrono::milliseconds updateInterval) noexcept {
+    if (publisher_) [[unlikely]] {
+        return false;
+    }
+
+    char defaultObjectName[32];
+    if (name == nullptr) {
+        if (!defaultName(static_cast<int>(getpid()), defaultObjectName, sizeof defaultObjectName)) [[unlikely]] {
+            return false;
+        }
+        name = defaultObjectName;
+    }
+
+    try {
+        auto publisher = std::make_unique<Publisher>();
+        publisher->name = name;
+        publisher->interval = updateInterval;
+
+        const auto fd = shm_open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) [[unlikely]] {
+            return false;
+        }
+
+        // A new object is zero-filled, which is a valid page with every slot unused
+        const auto pageSize = sizeof(AudioRingBufferMetricsPage);
+        void *address = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(pageSize)) == 0) [[likely]] {
+            address = mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (address == MAP_FAILED) [[unlikely]] {
+            shm_unlink(name);
+            return false;
+        }
+
+        auto page = static_cast<AudioRingBufferMetricsPage *>(address);
+        page->version.store(AudioRingBufferMetricsPage::currentVersion, std::memory_order_relaxed);
+        page->processID.store(static_cast<std::uint32_t>(getpid()), std::memory_order_relaxed);
+        page->updateInterval.store(static_cast<std::uint32_t>(updateInterval.count()), std::memory_order_relaxed);
+        page->magic.store(AudioRingBufferMetricsPage::magicValue, std::memory_order_release);
+        publisher->page = page;
+
+        publisher_ = std::move(publisher);
+        publisher_->thread = std::thread([publisher = publisher_.get()] {
+            while (!publisher->stop.load(std::memory_order_acquire)) {
+                publisher->publish();
+                std::this_thread::sleep_for(publisher->interval);
+            }
+        });
+    } catch (const std::bad_alloc &) {
+        close();
+        return false;
+    } catch (const std::system_error &) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::AudioRingBufferMetricsRegistry::close() noexcept {
+    if (!publisher_) {
+        return;
+    }
+
+    publisher_->stop.store(true, std::memory_order_release);
+    if (publisher_->thread.joinable()) {
+        publisher_->thread.join();
+    }
+
+    munmap(publisher_->page, sizeof(AudioRingBufferMetricsPage));
+    shm_unlink(publisher_->name.c_str());
+    publisher_.reset();
+}
+
+auto spsc::AudioRingBufferMetricsRegistry::add(const AudioRingBuffer &ringBuffer, const char *_Nonnull label) noexcept
+        -> SizeType {
+    if (!publisher_) [[unlikely]] {
+        return static_cast<SizeType>(-1);
+    }
+
+    std::lock_guard lock{publisher_->mutex};
+
+    for (SizeType i = 0; i < AudioRingBufferMetricsPage::slotCount; ++i) {
+        auto &entry = publisher_->entries[i];
+        if (entry.ringBuffer != nullptr) {
+            continue;
+        }
+
+        entry = {};
+        entry.ringBuffer = &ringBuffer;
+        entry.minFill = std::numeric_limits<std::uint64_t>::max();
+
+        auto &slot = publisher_->page->slots[i];
+        const auto &format = ringBuffer.format();
+        std::uint64_t sampleRate = 0;
+        std::memcpy(&sampleRate, &format.mSampleRate, sizeof sampleRate);
+
+        beginUpdate(slot);
+        const auto labelLength = std::min(std::strlen(label), sizeof slot.label / sizeof slot.label[0] - 1);
+        for (std::size_t j = 0; j < sizeof slot.label / sizeof slot.label[0]; ++j) {
+            slot.label[j].store(j < labelLength ? label[j] : '\0', std::memory_order_relaxed);
+        }
+        slot.capacity.store(ringBuffer.capacity(), std::memory_order_relaxed);
+        slot.minFill.store(0, std::memory_order_relaxed);
+        slot.maxFill.store(0, std::memory_order_relaxed);
+        slot.fillSum.store(0, std::memory_order_relaxed);
+        slot.sampleCount.store(0, std::memory_order_relaxed);
+        slot.sampleRateBits.store(sampleRate, std::memory_order_relaxed);
+        slot.formatID.store(format.mFormatID, std::memory_order_relaxed);
+        slot.formatFlags.store(format.mFormatFlags, std::memory_order_relaxed);
+        slot.bytesPerFrame.store(format.mBytesPerFrame, std::memory_order_relaxed);
+        slot.channelsPerFrame.store(format.mChannelsPerFrame, std::memory_order_relaxed);
+        slot.bitsPerChannel.store(format.mBitsPerChannel, std::memory_order_relaxed);
+        slot.inUse.store(1, std::memory_order_relaxed);
+        endUpdate(slot);
+
+        return i;
+    }
+
+    return static_cast<SizeType>(-1);
+}
+
+void spsc::AudioRingBufferMetricsRegistry::remove(SizeType slot) noexcept {
+    if (!publisher_ || slot >= AudioRingBufferMetricsPage::slotCount) [[unlikely]] {
+        return;
+    }
+
+    std::lock_guard lock{publisher_->mutex};
+
+    publisher_->entries[slot] = {};
+
+    auto &pageSlot = publisher_->page->slots[slot];
+    beginUpdate(pageSlot);
+    pageSlot.inUse.store(0, std::memory_order_relaxed);
+    endUpdate(pageSlot);
+}
+
+// MARK: Publishing
+
+void spsc::AudioRingBufferMetricsRegistry::Publisher::publish() noexcept {
+    std::lock_guard lock{mutex};
+
+    for (SizeType i = 0; i < AudioRingBufferMetricsPage::slotCount; ++i) {
+        auto &entry = entries[i];
+        if (entry.ringBuffer == nullptr) {
+            continue;
+        }
+
+        // Load the read position first so a concurrent write cannot make the fill appear negative
+        const auto readPosition = entry.ringBuffer->readPosition();
+        const auto writePosition = entry.ringBuffer->writePosition();
+        const auto fill = static_cast<std::uint64_t>(
+                std::min(writePosition - readPosition, entry.ringBuffer->capacity()));
+
+        entry.minFill = std::min(entry.minFill, fill);
+        entry.maxFill = std::max(entry.maxFill, fill);
+        entry.fillSum += fill;
+        ++entry.sampleCount;
+
+        auto &slot = page->slots[i];
+        beginUpdate(slot);
+        slot.writePosition.store(writePosition, std::memory_order_relaxed);
+        slot.readPosition.store(readPosition, std::memory_order_relaxed);
+        slot.minFill.store(entry.minFill, std::memory_order_relaxed);
+        slot.maxFill.store(entry.maxFill, std::memory_order_relaxed);
+        slot.fillSum.store(entry.fillSum, std::memory_order_relaxed);
+        slot.sampleCount.store(entry.sampleCount, std::memory_order_relaxed);
+        slot.underrunCount.store(entry.ringBuffer->underrunCount(), std::memory_order_relaxed);
+        slot.overrunCount.store(entry.ringBuffer->overrunCount(), std::memory_order_relaxed);
+        endUpdate(slot);
+    }
+
+    auto &updateCount = page->updateCount;
+    updateCount.store(updateCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// MARK: - Reader
+
+spsc::AudioRingBufferMetricsReader::AudioRingBufferMetricsReader(AudioRingBufferMetricsReader &&other) noexcept
+    : page_{std::exchange(other.page_, nullptr)} {}
+
+auto spsc::AudioRingBufferMetricsReader::operator=(AudioRingBufferMetricsReader &&other) noexcept
+        -> AudioRingBufferMetricsReader & {
+    if (this != &other) [[likely]] {
+        close();
+        page_ = std::exchange(other.page_, nullptr);
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferMetricsReader::~AudioRingBufferMetricsReader() noexcept { close(); }
+
+bool spsc::AudioRingBufferMetricsReader::open(const char *_Nonnull name) noexcept {
+    close();
+
+    const auto fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1) {
+        return false;
+    }
+
+    // The publisher may not have sized the object yet, and mapping past its end would fault on access
+    const auto pageSize = sizeof(AudioRingBufferMetricsPage);
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < pageSize) {
+        ::close(fd);
+        return false;
+    }
+
+    const auto address = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) [[unlikely]] {
+        return false;
+    }
+
+    const auto page = static_cast<const AudioRingBufferMetricsPage *>(address);
+    if (page->magic.load(std::memory_order_acquire) != AudioRingBufferMetricsPage::magicValue ||
+        page->version.load(std::memory_order_relaxed) != AudioRingBufferMetricsPage::currentVersion) {
+        munmap(address, pageSize);
+        return false;
+    }
+
+    page_ = page;
+    return true;
+}
+
+void spsc::AudioRingBufferMetricsReader::close() noexcept {
+    if (page_ != nullptr) {
+        munmap(const_cast<AudioRingBufferMetricsPage *>(page_), sizeof(AudioRingBufferMetricsPage));
+        page_ = nullptr;
+    }
+}
@@ -0,0 +1,224 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferMixer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+/// Returns true if format is non-interleaved native 32-bit float.
+constexpr bool isFloat32(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 && format.mBitsPerChannel == 32 &&
+           format.mBytesPerFrame == sizeof(float);
+}
+
+/// Adds gain × src to dst for count samples.
+void multiplyAdd(float *const _Nonnull dst, const float *const _Nonnull src, float gain, std::size_t count) noexcept {
+    std::size_t i = 0;
+#if defined(__ARM_NEON)
+    const auto g = vdupq_n_f32(gain);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vfmaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+    }
+#elif defined(__SSE__)
+    const auto g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += gain * src[i];
+    }
+}
+
+} /* namespace */
+
+struct spsc::AudioRingBufferMixer::Stream {
+    /// The attached ring buffer or nullptr if the slot is free.
+    AudioRingBuffer *ringBuffer{nullptr};
+    /// The linear gain applied to the stream.
+    std::atomic<float> gain{1};
+    /// The number of calls to mix in which the stream underran.
+    std::atomic<SizeType> underrunCount{0};
+
+    /// The audio read from the stream during the current call to mix.
+    AudioRingBuffer::Region region{};
+    /// The gain sampled at the start of the current call to mix.
+    float currentGain{1};
+};
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferMixer::AudioRingBufferMixer() noexcept = default;
+
+spsc::AudioRingBufferMixer::AudioRingBufferMixer(AudioRingBufferMixer &&other) noexcept
+    : streams_{std::move(other.streams_)}, maxStreamCount_{std::exchange(other.maxStreamCount_, 0)},
+      streamLimit_{std::exchange(other.streamLimit_, 0)} {}
+
+auto spsc::AudioRingBufferMixer::operator=(AudioRingBufferMixer &&other) noexcept -> AudioRingBufferMixer & {
+    if (this != &other) [[likely]] {
+        streams_ = std::move(other.streams_);
+        maxStreamCount_ = std::exchange(other.maxStreamCount_, 0);
+        streamLimit_ = std::exchange(other.streamLimit_, 0);
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferMixer::~AudioRingBufferMixer() noexcept = default;
+
+// MARK: Mixer Management
+
+bool spsc::AudioRingBufferMixer::allocate(SizeType maxStreamCount) noexcept {
+    deallocate();
+
+    auto streams = std::unique_ptr<Stream[]>(new (std::nothrow) Stream[maxStreamCount]);
+    if (!streams) [[unlikely]] {
+        return false;
+    }
+
+    streams_ = std::move(streams);
+    maxStreamCount_ = maxStreamCount;
+    return true;
+}
+
+void spsc::AudioRingBufferMixer::deallocate() noexcept {
+    streams_.reset();
+    maxStreamCount_ = 0;
+    streamLimit_ = 0;
+}
+
+// MARK: Streams
+
+auto spsc::AudioRingBufferMixer::attach(AudioRingBuffer &ringBuffer, float gain) noexcept -> SizeType {
+    if (!isFloat32(ringBuffer.format())) [[unlikely]] {
+        return maxStreamCount_;
+    }
+
+    for (SizeType slot = 0; slot < maxStreamCount_; ++slot) {
+        auto &stream = streams_[slot];
+        if (stream.ringBuffer == nullptr) {
+            stream.ringBuffer = &ringBuffer;
+            stream.gain.store(gain, std::memory_order_relaxed);
+            stream.underrunCount.store(0, std::memory_order_relaxed);
+            streamLimit_ = std::max(streamLimit_, slot + 1);
+            return slot;
+        }
+    }
+
+    return maxStreamCount_;
+}
+
+void spsc::AudioRingBufferMixer::detach(SizeType slot) noexcept {
+    if (slot >= maxStreamCount_) [[unlikely]] {
+        return;
+    }
+
+    streams_[slot].ringBuffer = nullptr;
+    while (streamLimit_ > 0 && streams_[streamLimit_ - 1].ringBuffer == nullptr) {
+        --streamLimit_;
+    }
+}
+
+void spsc::AudioRingBufferMixer::setGain(SizeType slot, float gain) noexcept {
+    if (slot < maxStreamCount_) [[likely]] {
+        streams_[slot].gain.store(gain, std::memory_order_relaxed);
+    }
+}
+
+float spsc::AudioRingBufferMixer::gain(SizeType slot) const noexcept {
+    return slot < maxStreamCount_ ? streams_[slot].gain.load(std::memory_order_relaxed) : 0;
+}
+
+auto spsc::AudioRingBufferMixer::underrunCount(SizeType slot) const noexcept -> SizeType {
+    return slot < maxStreamCount_ ? streams_[slot].underrunCount.load(std::memory_order_relaxed) : 0;
+}
+
+// MARK: Mixing
+
+auto spsc::AudioRingBufferMixer::mix(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0) [[unlikely]] {
+        return 0;
+    }
+
+    // Find the audio available in every stream up front so each tile visits only the streams that reach it
+    SizeType contributingStreams = 0;
+    for (SizeType slot = 0; slot < streamLimit_; ++slot) {
+        auto &stream = streams_[slot];
+        if (stream.ringBuffer == nullptr) {
+            stream.region = {};
+            continue;
+        }
+
+        stream.region = stream.ringBuffer->reserveRead(frameCount);
+        stream.currentGain = stream.gain.load(std::memory_order_relaxed);
+        if (stream.region.count() < frameCount) [[unlikely]] {
+            stream.underrunCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (stream.region.count() != 0) {
+            ++contributingStreams;
+        }
+    }
+
+    for (SizeType tileStart = 0; tileStart < frameCount; tileStart += tileFrameCount) {
+        const auto tileEnd = std::min(tileStart + tileFrameCount, frameCount);
+
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(frameCount * sizeof(float) <= bufferList->mBuffers[i].mDataByteSize);
+            std::memset(static_cast<float *>(bufferList->mBuffers[i].mData) + tileStart, 0,
+                        (tileEnd - tileStart) * sizeof(float));
+        }
+
+        for (SizeType slot = 0; slot < streamLimit_; ++slot) {
+            const auto &stream = streams_[slot];
+            const auto &region = stream.region;
+            const auto end = std::min(tileEnd, region.count());
+            if (end <= tileStart) {
+                continue;
+            }
+
+            const auto channelCount =
+                    std::min(bufferList->mNumberBuffers, stream.ringBuffer->format().mChannelsPerFrame);
+            for (UInt32 i = 0; i < channelCount; ++i) {
+                const auto src = static_cast<const float *>(stream.ringBuffer->channelBuffer(i));
+                const auto dst = static_cast<float *>(bufferList->mBuffers[i].mData);
+
+                // The part of the tile before the wrap, then the part after it
+                auto offset = tileStart;
+                if (offset < region.firstCount) {
+                    const auto count = std::min(end, region.firstCount) - offset;
+                    multiplyAdd(dst + offset, src + region.index + offset, stream.currentGain, count);
+                    offset += count;
+                }
+                if (offset < end) {
+                    multiplyAdd(dst + offset, src + (offset - region.firstCount), stream.currentGain, end - offset);
+                }
+            }
+        }
+    }
+
+    for (SizeType slot = 0; slot < streamLimit_; ++slot) {
+        auto &stream = streams_[slot];
+        if (stream.region.count() != 0) {
+            stream.ringBuffer->commitRead(stream.region.count());
+        }
+    }
+
+    return contributingStreams;
+}
@@ -0,0 +1,421 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferPipeline.hpp"
+
+#include "spsc/AudioRingBufferScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <pthread.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+
+/// The number of consecutive idle rounds after which a stage thread sleeps.
+constexpr unsigned spinRoundsBeforeSleep = 64;
+
+/// Creates an audio buffer list in storage with channelCount buffers of byteSize bytes starting at data.
+AudioBufferList *makeBufferList(std::vector<unsigned char> &storage, UInt32 channelCount, unsigned char *data,
+                                std::size_t byteSize) {
+    storage.resize(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount);
+    auto bufferList = reinterpret_cast<AudioBufferList *>(storage.data());
+    bufferList->mNumberBuffers = channelCount;
+    for (UInt32 i = 0; i < channelCount; ++i) {
+        bufferList->mBuffers[i].mNumberChannels = 1;
+        bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(byteSize);
+        bufferList->mBuffers[i].mData = data + i * byteSize;
+    }
+    return bufferList;
+}
+
+/// Restricts the calling thread to cpu.
+///
+/// macOS does not support pinning, so there cpu is used as an affinity tag: threads with different tags are
+/// preferentially run on different cores.
+void pinCurrentThread(int cpu) noexcept {
+#if defined(__APPLE__)
+    thread_affinity_policy_data_t policy{cpu + 1};
+    thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+                      reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+#else
+    (void)cpu;
+#endif
+}
+
+} /* namespace */
+
+struct spsc::AudioRingBufferPipeline::StageState {
+    /// The processing function.
+    ProcessFunction process;
+    /// The ring the stage reads.
+    AudioRingBuffer *input{nullptr};
+    /// The ring the stage writes.
+    AudioRingBuffer *output{nullptr};
+    /// The number of audio frames consumed per call.
+    SizeType blockFrameCount{0};
+    /// The maximum number of audio frames produced per call.
+    SizeType maxOutputFrameCount{0};
+    /// The CPU to pin the stage's dedicated thread to, or -1.
+    int cpu{-1};
+
+    /// Storage for the input block.
+    std::vector<unsigned char> inputData;
+    /// Storage for the output block.
+    std::vector<unsigned char> outputData;
+    /// Storage for inputList.
+    std::vector<unsigned char> inputListStorage;
+    /// Storage for outputList.
+    std::vector<unsigned char> outputListStorage;
+    /// A buffer list describing inputData.
+    AudioBufferList *inputList{nullptr};
+    /// A buffer list describing outputData.
+    AudioBufferList *outputList{nullptr};
+    /// The size of each output buffer in bytes.
+    UInt32 outputByteSize{0};
+
+    /// The number of blocks processed.
+    std::atomic<SizeType> blockCount{0};
+    /// The number of audio frames consumed.
+    std::atomic<SizeType> framesConsumed{0};
+    /// The number of audio frames produced.
+    std::atomic<SizeType> framesProduced{0};
+    /// The time spent in process in nanoseconds.
+    std::atomic<std::int64_t> processingNanoseconds{0};
+    /// The number of times less than a block of input was available.
+    std::atomic<SizeType> starvedCount{0};
+    /// The number of times the output lacked space for a block.
+    std::atomic<SizeType> blockedCount{0};
+    /// The largest input depth observed before reading a block.
+    std::atomic<SizeType> maxInputDepth{0};
+};
+
+struct spsc::AudioRingBufferPipeline::Runner {
+    /// The dedicated stage threads.
+    std::vector<std::thread> threads;
+    /// The worker pool for pooled threading.
+    std::unique_ptr<AudioRingBufferScheduler> scheduler;
+    /// Set to request the dedicated stage threads exit.
+    std::atomic<bool> stop{false};
+    /// The interval an idle dedicated stage thread sleeps.
+    std::chrono::microseconds idleInterval{};
+};
+
+// MARK: Stages
+
+auto spsc::AudioRingBufferPipeline::makeProcessFunction(
+        SizeType (*_Nonnull function)(void *_Nullable context, const AudioBufferList *_Nonnull input,
+                                      AudioBufferList *_Nonnull output, SizeType frameCount),
+        void *_Nullable context) noexcept -> ProcessFunction {
+    // Two pointers fit in std::function's small buffer, so this does not allocate
+    return [function, context](const AudioBufferList *_Nonnull input, AudioBufferList *_Nonnull output,
+                               SizeType frameCount) { return function(context, input, output, frameCount); };
+}
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferPipeline::AudioRingBufferPipeline() noexcept = default;
+
+spsc::AudioRingBufferPipeline::AudioRingBufferPipeline(AudioRingBufferPipeline &&other) noexcept
+    : rings_{std::exchange(other.rings_, {})}, stages_{std::exchange(other.stages_, {})},
+      runner_{std::move(other.runner_)} {}
+
+auto spsc::AudioRingBufferPipeline::operator=(AudioRingBufferPipeline &&other) noexcept -> AudioRingBufferPipeline & {
+    if (this != &other) [[likely]] {
+        deallocate();
+        rings_ = std::exchange(other.rings_, {});
+        stages_ = std::exchange(other.stages_, {});
+        runner_ = std::move(other.runner_);
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferPipeline::~AudioRingBufferPipeline() noexcept { stop(); }
+
+// MARK: Pipeline Management
+
+bool spsc::AudioRingBufferPipeline::allocate(const AudioStreamBasicDescription &format, Endpoint source,
+                                             StageList stages, Endpoint sink) noexcept {
+    if (runner_) [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    if (source.blockFrameCount == 0 || sink.blockFrameCount == 0) [[unlikely]] {
+        return false;
+    }
+
+    try {
+        std::vector<std::unique_ptr<AudioRingBuffer>> rings;
+        std::vector<std::unique_ptr<StageState>> stageStates;
+
+        auto ringFormat = format;
+        auto producerBlockFrameCount = source.blockFrameCount;
+        auto producerLatencyFrameCount = source.latencyFrameCount;
+
+        for (auto &stage : stages) {
+            const auto maxOutputFrameCount =
+                    stage.maxOutputFrameCount != 0 ? stage.maxOutputFrameCount : stage.blockFrameCount;
+            if (stage.blockFrameCount == 0 || !stage.process) [[unlikely]] {
+                return false;
+            }
+
+            // The ring feeding this stage
+            auto ring = std::make_unique<AudioRingBuffer>();
+            const auto capacity = ringCapacity(producerBlockFrameCount, producerLatencyFrameCount,
+                                               stage.blockFrameCount, stage.latencyFrameCount);
+            if (!ring->allocate(ringFormat, std::max(capacity, AudioRingBuffer::minCapacity))) [[unlikely]] {
+                return false;
+            }
+
+            const auto &outputFormat = stage.outputFormat;
+            if ((outputFormat.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 ||
+                outputFormat.mBytesPerFrame == 0 || outputFormat.mChannelsPerFrame == 0) [[unlikely]] {
+                return false;
+            }
+            if (stage.blockFrameCount > std::numeric_limits<UInt32>::max() / ringFormat.mBytesPerFrame ||
+                maxOutputFrameCount > std::numeric_limits<UInt32>::max() / outputFormat.mBytesPerFrame) [[unlikely]] {
+                return false;
+            }
+
+            auto state = std::make_unique<StageState>();
+            state->process = std::move(stage.process);
+            state->input = ring.get();
+            state->blockFrameCount = stage.blockFrameCount;
+            state->maxOutputFrameCount = maxOutputFrameCount;
+            state->cpu = stage.cpu;
+
+            const std::size_t inputByteSize = stage.blockFrameCount * ringFormat.mBytesPerFrame;
+            state->inputData.resize(inputByteSize * ringFormat.mChannelsPerFrame);
+            state->inputList = makeBufferList(state->inputListStorage, ringFormat.mChannelsPerFrame,
+                                              state->inputData.data(), inputByteSize);
+
+            state->outputByteSize = static_cast<UInt32>(maxOutputFrameCount * outputFormat.mBytesPerFrame);
+            state->outputData.resize(std::size_t{state->outputByteSize} * outputFormat.mChannelsPerFrame);
+            state->outputList = makeBufferList(state->outputListStorage, outputFormat.mChannelsPerFrame,
+                                               state->outputData.data(), state->outputByteSize);
+
+            if (!stageStates.empty()) {
+                stageStates.back()->output = ring.get();
+            }
+            rings.push_back(std::move(ring));
+            stageStates.push_back(std::move(state));
+
+            ringFormat = outputFormat;
+            producerBlockFrameCount = maxOutputFrameCount;
+            producerLatencyFrameCount = stage.latencyFrameCount;
+        }
+
+        // The ring feeding the sink
+        auto ring = std::make_unique<AudioRingBuffer>();
+        const auto capacity = ringCapacity(producerBlockFrameCount, producerLatencyFrameCount, sink.blockFrameCount,
+                                           sink.latencyFrameCount);
+        if (!ring->allocate(ringFormat, std::max(capacity, AudioRingBuffer::minCapacity))) [[unlikely]] {
+            return false;
+        }
+        if (!stageStates.empty()) {
+            stageStates.back()->output = ring.get();
+        }
+        rings.push_back(std::move(ring));
+
+        rings_ = std::move(rings);
+        stages_ = std::move(stageStates);
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::AudioRingBufferPipeline::deallocate() noexcept {
+    stop();
+    stages_.clear();
+    rings_.clear();
+}
+
+spsc::AudioRingBufferPipeline::operator bool() const noexcept { return !rings_.empty(); }
+
+auto spsc::AudioRingBufferPipeline::stageCount() const noexcept -> SizeType { return stages_.size(); }
+
+spsc::AudioRingBuffer &spsc::AudioRingBufferPipeline::input() const noexcept { return *rings_.front(); }
+
+spsc::AudioRingBuffer &spsc::AudioRingBufferPipeline::output() const noexcept { return *rings_.back(); }
+
+// MARK: Running
+
+bool spsc::AudioRingBufferPipeline::start(Threading threading, unsigned poolThreadCount,
+                                          std::chrono::microseconds idleInterval) noexcept {
+    if (rings_.empty() || runner_) [[unlikely]] {
+        return false;
+    }
+
+    try {
+        runner_ = std::make_unique<Runner>();
+        runner_->idleInterval = idleInterval;
+
+        if (threading == Threading::pooled) {
+            runner_->scheduler = std::make_unique<AudioRingBufferScheduler>();
+            for (const auto &stage : stages_) {
+                const auto node = runner_->scheduler->addNode([&stage = *stage] { runStage(stage); },
+                                                              {{stage->input, stage->blockFrameCount}},
+                                                              {{stage->output, stage->maxOutputFrameCount}});
+                if (node == static_cast<SizeType>(-1)) [[unlikely]] {
+                    runner_.reset();
+                    return false;
+                }
+            }
+            if (!runner_->scheduler->start(poolThreadCount, idleInterval)) [[unlikely]] {
+                runner_.reset();
+                return false;
+            }
+            return true;
+        }
+
+        runner_->threads.reserve(stages_.size());
+        for (const auto &stage : stages_) {
+            runner_->threads.emplace_back([&runner = *runner_, &stage = *stage] {
+                if (stage.cpu >= 0) {
+                    pinCurrentThread(stage.cpu);
+                }
+
+                unsigned idleRounds = 0;
+                while (!runner.stop.load(std::memory_order_acquire)) {
+                    if (runStage(stage)) {
+                        idleRounds = 0;
+                    } else if (++idleRounds < spinRoundsBeforeSleep) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(runner.idleInterval);
+                    }
+                }
+            });
+        }
+    } catch (const std::bad_alloc &) {
+        stop();
+        return false;
+    } catch (const std::system_error &) {
+        stop();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::AudioRingBufferPipeline::stop() noexcept {
+    if (!runner_) {
+        return;
+    }
+
+    if (runner_->scheduler) {
+        runner_->scheduler->stop();
+    }
+
+    runner_->stop.store(true, std::memory_order_release);
+    for (auto &thread : runner_->threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    runner_.reset();
+}
+
+bool spsc::AudioRingBufferPipeline::isRunning() const noexcept { return runner_ != nullptr; }
+
+// MARK: Instrumentation
+
+auto spsc::AudioRingBufferPipeline::statistics(SizeType stage) const noexcept -> StageStatistics {
+    if (stage >= stages_.size()) [[unlikely]] {
+        return {};
+    }
+
+    const auto &state = *stages_[stage];
+    StageStatistics statistics;
+    statistics.blockCount = state.blockCount.load(std::memory_order_relaxed);
+    statistics.framesConsumed = state.framesConsumed.load(std::memory_order_relaxed);
+    statistics.framesProduced = state.framesProduced.load(std::memory_order_relaxed);
+    statistics.processingTime =
+            std::chrono::nanoseconds{state.processingNanoseconds.load(std::memory_order_relaxed)};
+    statistics.starvedCount = state.starvedCount.load(std::memory_order_relaxed);
+    statistics.blockedCount = state.blockedCount.load(std::memory_order_relaxed);
+    statistics.inputDepth = state.input->availableFrames();
+    statistics.maxInputDepth = state.maxInputDepth.load(std::memory_order_relaxed);
+    statistics.inputCapacity = state.input->capacity();
+    return statistics;
+}
+
+// MARK: Processing
+
+bool spsc::AudioRingBufferPipeline::runStage(StageState &stage) noexcept {
+    // A stage never runs on two threads at once, so its counters need not be read-modify-write
+    const auto increment = [](std::atomic<SizeType> &counter, SizeType value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    };
+
+    bool processed = false;
+    for (;;) {
+        const auto inputDepth = stage.input->availableFrames();
+        if (inputDepth < stage.blockFrameCount) {
+            if (!processed) {
+                increment(stage.starvedCount, 1);
+            }
+            break;
+        }
+        if (stage.output->freeSpace() < stage.maxOutputFrameCount) {
+            increment(stage.blockedCount, 1);
+            break;
+        }
+
+        if (inputDepth > stage.maxInputDepth.load(std::memory_order_relaxed)) {
+            stage.maxInputDepth.store(inputDepth, std::memory_order_relaxed);
+        }
+
+        stage.input->read(stage.inputList, stage.blockFrameCount);
+        for (UInt32 i = 0; i < stage.outputList->mNumberBuffers; ++i) {
+            stage.outputList->mBuffers[i].mDataByteSize = stage.outputByteSize;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto framesProduced =
+                std::min(stage.process(stage.inputList, stage.outputList, stage.blockFrameCount),
+                         stage.maxOutputFrameCount);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        stage.output->write(stage.outputList, framesProduced);
+
+        increment(stage.blockCount, 1);
+        increment(stage.framesConsumed, stage.blockFrameCount);
+        increment(stage.framesProduced, framesProduced);
+        stage.processingNanoseconds.store(
+                stage.processingNanoseconds.load(std::memory_order_relaxed) +
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                std::memory_order_relaxed);
+        processed = true;
+    }
+
+    return processed;
+}
@@ -0,0 +1,57 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferProbes.hpp"
+
+#if defined(SPSC_PROBES)
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+// MARK: Probe Semaphores
+
+extern "C" {
+unsigned short spsc_write_semaphore __attribute__((section(".probes"))) = 0;
+unsigned short spsc_read_semaphore __attribute__((section(".probes"))) = 0;
+unsigned short spsc_overrun_semaphore __attribute__((section(".probes"))) = 0;
+unsigned short spsc_underrun_semaphore __attribute__((section(".probes"))) = 0;
+unsigned short spsc_skip_semaphore __attribute__((section(".probes"))) = 0;
+unsigned short spsc_drain_semaphore __attribute__((section(".probes"))) = 0;
+}
+
+// MARK: Probes
+
+void spsc::detail::writeProbe(const void *ring, std::size_t requested, std::size_t written, std::size_t writePosition,
+                              std::size_t readPosition) noexcept {
+    STAP_PROBE5(spsc, write, ring, requested, written, writePosition, readPosition);
+}
+
+void spsc::detail::readProbe(const void *ring, std::size_t requested, std::size_t read, std::size_t writePosition,
+                             std::size_t readPosition) noexcept {
+    STAP_PROBE5(spsc, read, ring, requested, read, writePosition, readPosition);
+}
+
+void spsc::detail::overrunProbe(const void *ring, std::size_t requested, std::size_t written,
+                                std::size_t writePosition, std::size_t readPosition) noexcept {
+    STAP_PROBE5(spsc, overrun, ring, requested, written, writePosition, readPosition);
+}
+
+void spsc::detail::underrunProbe(const void *ring, std::size_t requested, std::size_t read,
+                                 std::size_t writePosition, std::size_t readPosition) noexcept {
+    STAP_PROBE5(spsc, underrun, ring, requested, read, writePosition, readPosition);
+}
+
+void spsc::detail::skipProbe(const void *ring, std::size_t requested, std::size_t skipped,
+                             std::size_t readPosition) noexcept {
+    STAP_PROBE4(spsc, skip, ring, requested, skipped, readPosition);
+}
+
+void spsc::detail::drainProbe(const void *ring, std::size_t discarded, std::size_t readPosition) noexcept {
+    STAP_PROBE3(spsc, drain, ring, discarded, readPosition);
+}
+
+#endif
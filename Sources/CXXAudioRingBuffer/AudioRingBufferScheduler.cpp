@@ -0,0 +1,287 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferScheduler.hpp"
+
+#include "WorkStealingDeque.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+/// The number of consecutive rounds without work after which a worker sleeps.
+constexpr unsigned spinRoundsBeforeSleep = 64;
+
+} /* namespace */
+
+struct spsc::AudioRingBufferScheduler::Node {
+    /// The processing function.
+    ProcessFunction process;
+    /// The rings the node reads.
+    PortList inputs;
+    /// The rings the node writes.
+    PortList outputs;
+    /// Nodes sharing a ring with this node, whose readiness changes when this node runs.
+    std::vector<Node *> neighbors;
+
+    /// Set while the node is in a deque or running.
+    std::atomic<bool> scheduled{false};
+    /// The number of times the node has run.
+    std::atomic<SizeType> runCount{0};
+};
+
+struct spsc::AudioRingBufferScheduler::Worker {
+    /// The worker's runnable nodes.
+    detail::WorkStealingDeque<Node> deque;
+    /// The worker thread.
+    std::thread thread;
+    /// The worker's index in the pool.
+    unsigned index{0};
+    /// State for choosing steal victims.
+    std::uint32_t random{0};
+};
+
+struct spsc::AudioRingBufferScheduler::Pool {
+    /// The workers.
+    std::vector<std::unique_ptr<Worker>> workers;
+    /// Set to request the workers exit.
+    std::atomic<bool> stop{false};
+    /// The interval a worker sleeps after finding no work.
+    std::chrono::microseconds idleInterval{};
+};
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferScheduler::AudioRingBufferScheduler() noexcept = default;
+
+spsc::AudioRingBufferScheduler::AudioRingBufferScheduler(AudioRingBufferScheduler &&other) noexcept {
+    *this = std::move(other);
+}
+
+auto spsc::AudioRingBufferScheduler::operator=(AudioRingBufferScheduler &&other) noexcept
+        -> AudioRingBufferScheduler & {
+    if (this != &other) [[likely]] {
+        stop();
+
+        // The workers refer to their scheduler, so they cannot follow the nodes and are started anew
+        const auto threadCount = other.pool_ ? static_cast<unsigned>(other.pool_->workers.size()) : 0;
+        const auto idleInterval = other.pool_ ? other.pool_->idleInterval : defaultIdleInterval;
+        other.stop();
+
+        nodes_ = std::exchange(other.nodes_, {});
+
+        if (threadCount != 0) {
+            start(threadCount, idleInterval);
+        }
+    }
+    return *this;
+}
+
+spsc::AudioRingBufferScheduler::~AudioRingBufferScheduler() noexcept { stop(); }
+
+// MARK: Graph Construction
+
+auto spsc::AudioRingBufferScheduler::makeProcessFunction(void (*_Nonnull function)(void *_Nullable context),
+                                                         void *_Nullable context) noexcept -> ProcessFunction {
+    // Two pointers fit in std::function's small buffer, so this does not allocate
+    return [function, context] { function(context); };
+}
+
+auto spsc::AudioRingBufferScheduler::addNode(ProcessFunction process, PortList inputs, PortList outputs) noexcept
+        -> SizeType {
+    if (pool_) [[unlikely]] {
+        return static_cast<SizeType>(-1);
+    }
+
+    try {
+        auto node = std::make_unique<Node>();
+        node->process = std::move(process);
+        node->inputs = std::move(inputs);
+        node->outputs = std::move(outputs);
+        nodes_.push_back(std::move(node));
+    } catch (const std::bad_alloc &) {
+        return static_cast<SizeType>(-1);
+    }
+
+    return nodes_.size() - 1;
+}
+
+auto spsc::AudioRingBufferScheduler::nodeCount() const noexcept -> SizeType { return nodes_.size(); }
+
+auto spsc::AudioRingBufferScheduler::runCount(SizeType node) const noexcept -> SizeType {
+    return node < nodes_.size() ? nodes_[node]->runCount.load(std::memory_order_relaxed) : 0;
+}
+
+// MARK: Running
+
+bool spsc::AudioRingBufferScheduler::start(unsigned threadCount, std::chrono::microseconds idleInterval) noexcept {
+    if (pool_ || threadCount == 0) [[unlikely]] {
+        return false;
+    }
+
+    try {
+        // Link each node to the nodes at the other end of its rings
+        std::unordered_map<const AudioRingBuffer *, std::vector<Node *>> readers;
+        std::unordered_map<const AudioRingBuffer *, std::vector<Node *>> writers;
+        for (const auto &node : nodes_) {
+            for (const auto &port : node->inputs) {
+                readers[port.ringBuffer].push_back(node.get());
+            }
+            for (const auto &port : node->outputs) {
+                writers[port.ringBuffer].push_back(node.get());
+            }
+        }
+        for (const auto &node : nodes_) {
+            node->neighbors.clear();
+            for (const auto &port : node->outputs) {
+                const auto &others = readers[port.ringBuffer];
+                node->neighbors.insert(node->neighbors.end(), others.begin(), others.end());
+            }
+            for (const auto &port : node->inputs) {
+                const auto &others = writers[port.ringBuffer];
+                node->neighbors.insert(node->neighbors.end(), others.begin(), others.end());
+            }
+        }
+
+        auto pool = std::make_unique<Pool>();
+        pool->idleInterval = idleInterval;
+        for (unsigned i = 0; i < threadCount; ++i) {
+            auto worker = std::make_unique<Worker>();
+            // A node is in at most one deque at a time, so a deque never fills
+            if (!worker->deque.allocate(nodes_.size())) [[unlikely]] {
+                return false;
+            }
+            worker->index = i;
+            worker->random = 0x9e3779b9u * (i + 1);
+            pool->workers.push_back(std::move(worker));
+        }
+
+        pool_ = std::move(pool);
+        for (const auto &worker : pool_->workers) {
+            worker->thread = std::thread([this, &worker = *worker] { workerLoop(worker); });
+        }
+    } catch (const std::bad_alloc &) {
+        stop();
+        return false;
+    } catch (const std::system_error &) {
+        stop();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::AudioRingBufferScheduler::stop() noexcept {
+    if (!pool_) {
+        return;
+    }
+
+    pool_->stop.store(true, std::memory_order_release);
+    for (const auto &worker : pool_->workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    pool_.reset();
+
+    // Nodes left in the deques are no longer scheduled
+    for (const auto &node : nodes_) {
+        node->scheduled.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool spsc::AudioRingBufferScheduler::isRunning() const noexcept { return pool_ != nullptr; }
+
+// MARK: Scheduling
+
+bool spsc::AudioRingBufferScheduler::isReady(const Node &node) noexcept {
+    for (const auto &port : node.inputs) {
+        if (port.ringBuffer->availableFrames() < port.frameCount) {
+            return false;
+        }
+    }
+    for (const auto &port : node.outputs) {
+        if (port.ringBuffer->freeSpace() < port.frameCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void spsc::AudioRingBufferScheduler::trySchedule(Node &node, Worker &worker) noexcept {
+    if (node.scheduled.load(std::memory_order_relaxed) || !isReady(node)) {
+        return;
+    }
+
+    // Acquire pairs with the release after the node last ran so its previous run happens before the next
+    if (node.scheduled.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    if (!worker.deque.push(&node)) [[unlikely]] {
+        run(node, worker);
+    }
+}
+
+void spsc::AudioRingBufferScheduler::run(Node &node, Worker &worker) noexcept {
+    node.process();
+    node.runCount.fetch_add(1, std::memory_order_relaxed);
+    node.scheduled.store(false, std::memory_order_release);
+
+    // The node may have work left, and its neighbors see the ring positions it changed
+    trySchedule(node, worker);
+    for (const auto neighbor : node.neighbors) {
+        trySchedule(*neighbor, worker);
+    }
+}
+
+void spsc::AudioRingBufferScheduler::workerLoop(Worker &worker) noexcept {
+    auto &pool = *pool_;
+    const auto workerCount = static_cast<unsigned>(pool.workers.size());
+    unsigned idleRounds = 0;
+
+    while (!pool.stop.load(std::memory_order_acquire)) {
+        auto node = worker.deque.pop();
+
+        // Steal from the other workers starting at a random victim
+        if (node == nullptr && workerCount > 1) {
+            worker.random ^= worker.random << 13;
+            worker.random ^= worker.random >> 17;
+            worker.random ^= worker.random << 5;
+            const auto first = worker.random % workerCount;
+            for (unsigned i = 0; i < workerCount && node == nullptr; ++i) {
+                const auto victim = (first + i) % workerCount;
+                if (victim != worker.index) {
+                    node = pool.workers[victim]->deque.steal();
+                }
+            }
+        }
+
+        if (node != nullptr) {
+            run(*node, worker);
+            idleRounds = 0;
+            continue;
+        }
+
+        // Sweep this worker's share of the nodes for audio written from outside the graph
+        for (SizeType i = worker.index; i < nodes_.size(); i += workerCount) {
+            trySchedule(*nodes_[i], worker);
+        }
+
+        if (++idleRounds < spinRoundsBeforeSleep) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(pool.idleInterval);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/AudioRingBufferTracer.hpp"
+
+#include <chrono>
+#include <utility>
+
+// MARK: Construction and Destruction
+
+spsc::AudioRingBufferTracer::AudioRingBufferTracer(AudioRingBufferTracer &&other) noexcept
+    : ringBuffer_{std::exchange(other.ringBuffer_, nullptr)}, writeEvents_{std::move(other.writeEvents_)},
+      readEvents_{std::move(other.readEvents_)},
+      droppedEventCount_{other.droppedEventCount_.exchange(0, std::memory_order_relaxed)} {}
+
+auto spsc::AudioRingBufferTracer::operator=(AudioRingBufferTracer &&other) noexcept -> AudioRingBufferTracer & {
+    if (this != &other) [[likely]] {
+        ringBuffer_ = std::exchange(other.ringBuffer_, nullptr);
+        writeEvents_ = std::move(other.writeEvents_);
+        readEvents_ = std::move(other.readEvents_);
+        droppedEventCount_.store(other.droppedEventCount_.exchange(0, std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+// MARK: Tracer Management
+
+bool spsc::AudioRingBufferTracer::allocate(AudioRingBuffer &ringBuffer, SizeType minEventCapacity) noexcept {
+    deallocate();
+
+    if (!writeEvents_.allocate(minEventCapacity) || !readEvents_.allocate(minEventCapacity)) [[unlikely]] {
+        deallocate();
+        return false;
+    }
+
+    ringBuffer_ = &ringBuffer;
+    return true;
+}
+
+void spsc::AudioRingBufferTracer::deallocate() noexcept {
+    ringBuffer_ = nullptr;
+    writeEvents_.deallocate();
+    readEvents_.deallocate();
+    droppedEventCount_.store(0, std::memory_order_relaxed);
+}
+
+// MARK: Tracing
+
+auto spsc::AudioRingBufferTracer::write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    const auto framesWritten = ringBuffer_->write(bufferList, frameCount);
+    record(writeEvents_, Operation::write, frameCount, framesWritten);
+    return framesWritten;
+}
+
+auto spsc::AudioRingBufferTracer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    const auto framesRead = ringBuffer_->read(bufferList, frameCount);
+    record(readEvents_, Operation::read, frameCount, framesRead);
+    return framesRead;
+}
+
+void spsc::AudioRingBufferTracer::recordWrite(SizeType framesRequested, SizeType framesTransferred) noexcept {
+    record(writeEvents_, Operation::write, framesRequested, framesTransferred);
+}
+
+void spsc::AudioRingBufferTracer::recordRead(SizeType framesRequested, SizeType framesTransferred) noexcept {
+    record(readEvents_, Operation::read, framesRequested, framesTransferred);
+}
+
+void spsc::AudioRingBufferTracer::record(RingBuffer<Event> &events, Operation operation, SizeType framesRequested,
+                                         SizeType framesTransferred) noexcept {
+    Event event;
+    event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+    event.framesRequested = framesRequested;
+    event.framesTransferred = framesTransferred;
+    event.operation = operation;
+
+    if (!events.push(event)) [[unlikely]] {
+        droppedEventCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// MARK: Collecting Events
+
+auto spsc::AudioRingBufferTracer::collect(Event *const _Nonnull events, SizeType maxEventCount) noexcept -> SizeType {
+    const auto writeEventCount = writeEvents_.pop(events, maxEventCount);
+    return writeEventCount + readEvents_.pop(events + writeEventCount, maxEventCount - writeEventCount);
+}
+
+bool spsc::AudioRingBufferTracer::save(std::FILE *_Nonnull file, const Event *const _Nonnull events,
+                                       SizeType eventCount) noexcept {
+    for (SizeType i = 0; i < eventCount; ++i) {
+        const auto &event = events[i];
+        if (std::fprintf(file, "%c,%lld,%llu,%llu\n", event.operation == Operation::write ? 'w' : 'r',
+                         static_cast<long long>(event.timestamp),
+                         static_cast<unsigned long long>(event.framesRequested),
+                         static_cast<unsigned long long>(event.framesTransferred)) < 0) [[unlikely]] {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,256 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "BlockCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/// The highest fixed predictor order.
+constexpr unsigned maxPredictorOrder = 4;
+/// The predictor order marking a verbatim channel.
+constexpr unsigned char verbatimMarker = 0xff;
+/// The highest Rice parameter.
+constexpr unsigned maxRiceParameter = 30;
+/// Rice quotients at or above this value are replaced by an escape code followed by the raw 32-bit value.
+constexpr unsigned escapeQuotient = 24;
+
+/// Returns the prediction residual of the fixed polynomial predictor of the specified order at x[i].
+inline std::int32_t residual(const std::int16_t *const _Nonnull x, std::size_t i, unsigned order) noexcept {
+    switch (order) {
+    case 0:
+        return x[i];
+    case 1:
+        return x[i] - x[i - 1];
+    case 2:
+        return x[i] - 2 * x[i - 1] + x[i - 2];
+    case 3:
+        return x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3];
+    default:
+        return x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+    }
+}
+
+/// Returns the prediction of the fixed polynomial predictor of the specified order for x[i].
+inline std::int32_t prediction(const std::int16_t *const _Nonnull x, std::size_t i, unsigned order) noexcept {
+    switch (order) {
+    case 0:
+        return 0;
+    case 1:
+        return x[i - 1];
+    case 2:
+        return 2 * x[i - 1] - x[i - 2];
+    case 3:
+        return 3 * x[i - 1] - 3 * x[i - 2] + x[i - 3];
+    default:
+        return 4 * x[i - 1] - 6 * x[i - 2] + 4 * x[i - 3] - x[i - 4];
+    }
+}
+
+/// Maps signed values to unsigned values so small magnitudes have small codes.
+inline std::uint32_t zigzag(std::int32_t value) noexcept {
+    return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+/// Reverses ``zigzag``.
+inline std::int32_t unzigzag(std::uint32_t value) noexcept {
+    return static_cast<std::int32_t>(value >> 1) ^ -static_cast<std::int32_t>(value & 1);
+}
+
+/// Writes bits most significant first to a bounded byte buffer.
+class BitWriter {
+  public:
+    BitWriter(unsigned char *const _Nonnull dst, std::size_t capacity) noexcept : dst_{dst}, capacity_{capacity} {}
+
+    /// Writes the low count bits of value, count <= 32.
+    void put(std::uint32_t value, unsigned count) noexcept {
+        if (count == 0) {
+            return;
+        }
+        accumulator_ = (accumulator_ << count) | (value & ((std::uint64_t{1} << count) - 1));
+        bitCount_ += count;
+        while (bitCount_ >= 8) {
+            bitCount_ -= 8;
+            emit(static_cast<unsigned char>(accumulator_ >> bitCount_));
+        }
+    }
+
+    /// Writes count 1-bits.
+    void putOnes(unsigned count) noexcept {
+        while (count > 0) {
+            const auto n = std::min(count, 32U);
+            put(0xffffffffU, n);
+            count -= n;
+        }
+    }
+
+    /// Pads to a byte boundary with 0-bits and returns the number of bytes written.
+    std::size_t finish() noexcept {
+        if (bitCount_ > 0) {
+            emit(static_cast<unsigned char>(accumulator_ << (8 - bitCount_)));
+            bitCount_ = 0;
+        }
+        return size_;
+    }
+
+    /// Returns true if the output did not fit in the buffer.
+    [[nodiscard]] bool overflowed() const noexcept { return overflowed_; }
+
+  private:
+    void emit(unsigned char byte) noexcept {
+        if (size_ < capacity_) [[likely]] {
+            dst_[size_++] = byte;
+        } else {
+            overflowed_ = true;
+        }
+    }
+
+    unsigned char *_Nonnull dst_;
+    std::size_t capacity_;
+    std::size_t size_{0};
+    std::uint64_t accumulator_{0};
+    unsigned bitCount_{0};
+    bool overflowed_{false};
+};
+
+/// Reads bits most significant first from a byte buffer.
+class BitReader {
+  public:
+    explicit BitReader(const unsigned char *const _Nonnull src) noexcept : src_{src} {}
+
+    /// Reads count bits, count <= 32.
+    std::uint32_t get(unsigned count) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+        while (bitCount_ < count) {
+            accumulator_ = (accumulator_ << 8) | src_[size_++];
+            bitCount_ += 8;
+        }
+        bitCount_ -= count;
+        return static_cast<std::uint32_t>((accumulator_ >> bitCount_) & ((std::uint64_t{1} << count) - 1));
+    }
+
+    /// Counts 1-bits up to a 0-bit or limit, consuming the 0-bit if present.
+    unsigned getOnes(unsigned limit) noexcept {
+        unsigned count = 0;
+        while (count < limit && get(1) == 1) {
+            ++count;
+        }
+        return count;
+    }
+
+    /// Returns the number of bytes consumed, discarding any bits remaining in the current byte.
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  private:
+    const unsigned char *_Nonnull src_;
+    std::size_t size_{0};
+    std::uint64_t accumulator_{0};
+    unsigned bitCount_{0};
+};
+
+/// Stores samples verbatim and returns the number of bytes written.
+std::size_t encodeVerbatim(const std::int16_t *const _Nonnull samples, std::size_t sampleCount,
+                           unsigned char *const _Nonnull dst) noexcept {
+    dst[0] = verbatimMarker;
+    dst[1] = 0;
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        const auto u = static_cast<std::uint16_t>(samples[i]);
+        dst[2 + 2 * i] = static_cast<unsigned char>(u);
+        dst[3 + 2 * i] = static_cast<unsigned char>(u >> 8);
+    }
+    return 2 + 2 * sampleCount;
+}
+
+} /* namespace */
+
+std::size_t spsc::detail::encodeChannel(const std::int16_t *const _Nonnull samples, std::size_t sampleCount,
+                                        unsigned char *const _Nonnull dst) noexcept {
+    const auto verbatimSize = maxEncodedChannelSize(sampleCount);
+
+    // Choose the predictor order minimizing the sum of absolute residuals
+    const auto orderLimit = static_cast<unsigned>(std::min<std::size_t>(maxPredictorOrder, sampleCount));
+    std::uint64_t errors[maxPredictorOrder + 1]{};
+    for (std::size_t i = maxPredictorOrder; i < sampleCount; ++i) {
+        for (unsigned order = 0; order <= orderLimit; ++order) {
+            const auto r = residual(samples, i, order);
+            errors[order] += static_cast<std::uint32_t>(r < 0 ? -r : r);
+        }
+    }
+
+    unsigned order = 0;
+    for (unsigned candidate = 1; candidate <= orderLimit; ++candidate) {
+        if (errors[candidate] < errors[order]) {
+            order = candidate;
+        }
+    }
+
+    // Choose the Rice parameter from the mean zigzag-coded residual
+    const auto residualCount = sampleCount - order;
+    std::uint64_t sum = 0;
+    for (std::size_t i = order; i < sampleCount; ++i) {
+        sum += zigzag(residual(samples, i, order));
+    }
+    unsigned k = 0;
+    while (k < maxRiceParameter && (static_cast<std::uint64_t>(residualCount) << (k + 1)) <= sum) {
+        ++k;
+    }
+
+    dst[0] = static_cast<unsigned char>(order);
+    dst[1] = static_cast<unsigned char>(k);
+
+    BitWriter writer{dst + 2, verbatimSize - 2};
+    for (std::size_t i = 0; i < order; ++i) {
+        writer.put(static_cast<std::uint16_t>(samples[i]), 16);
+    }
+    for (std::size_t i = order; i < sampleCount && !writer.overflowed(); ++i) {
+        const auto u = zigzag(residual(samples, i, order));
+        const auto quotient = u >> k;
+        if (quotient < escapeQuotient) [[likely]] {
+            writer.putOnes(quotient);
+            writer.put(0, 1);
+            writer.put(u, k);
+        } else {
+            writer.putOnes(escapeQuotient);
+            writer.put(u, 32);
+        }
+    }
+
+    const auto size = 2 + writer.finish();
+    if (writer.overflowed() || size >= verbatimSize) {
+        return encodeVerbatim(samples, sampleCount, dst);
+    }
+    return size;
+}
+
+std::size_t spsc::detail::decodeChannel(const unsigned char *const _Nonnull src, std::int16_t *const _Nonnull samples,
+                                        std::size_t sampleCount) noexcept {
+    const unsigned order = src[0];
+    const unsigned k = src[1];
+
+    if (order == verbatimMarker) {
+        for (std::size_t i = 0; i < sampleCount; ++i) {
+            samples[i] = static_cast<std::int16_t>(static_cast<std::uint16_t>(src[2 + 2 * i] | (src[3 + 2 * i] << 8)));
+        }
+        return 2 + 2 * sampleCount;
+    }
+
+    BitReader reader{src + 2};
+    for (std::size_t i = 0; i < order; ++i) {
+        samples[i] = static_cast<std::int16_t>(static_cast<std::uint16_t>(reader.get(16)));
+    }
+    for (std::size_t i = order; i < sampleCount; ++i) {
+        const auto quotient = reader.getOnes(escapeQuotient);
+        const auto u = quotient < escapeQuotient ? (quotient << k) | reader.get(k) : reader.get(32);
+        samples[i] = static_cast<std::int16_t>(prediction(samples, i, order) + unzigzag(u));
+    }
+
+    return 2 + reader.size();
+}
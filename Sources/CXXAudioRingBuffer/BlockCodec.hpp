@@ -0,0 +1,37 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spsc::detail {
+
+/// Returns the maximum number of bytes ``encodeChannel`` writes for the specified number of samples.
+constexpr std::size_t maxEncodedChannelSize(std::size_t sampleCount) noexcept { return 2 + 2 * sampleCount; }
+
+/// Losslessly encodes one channel of a block of 16-bit samples.
+///
+/// The samples are modeled with the best fixed polynomial predictor of order zero to four and the prediction
+/// residuals are Rice coded. Blocks that do not compress are stored verbatim.
+/// @param samples The samples to encode.
+/// @param sampleCount The number of samples to encode.
+/// @param dst A buffer of at least ``maxEncodedChannelSize(sampleCount)`` bytes to receive the encoded data.
+/// @return The number of bytes written to dst.
+std::size_t encodeChannel(const std::int16_t *const _Nonnull samples, std::size_t sampleCount,
+                          unsigned char *const _Nonnull dst) noexcept;
+
+/// Decodes one channel of a block encoded by ``encodeChannel``.
+/// @param src The encoded data.
+/// @param samples A buffer to receive the decoded samples.
+/// @param sampleCount The number of samples to decode.
+/// @return The number of bytes consumed from src.
+std::size_t decodeChannel(const unsigned char *const _Nonnull src, std::int16_t *const _Nonnull samples,
+                          std::size_t sampleCount) noexcept;
+
+} /* namespace spsc::detail */
@@ -0,0 +1,347 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/CompactAudioRingBuffer.hpp"
+
+#include "spsc/BitOperations.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// Returns true if format is non-interleaved native 32-bit float.
+bool isSupportedFormat(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsBigEndian) == kAudioFormatFlagsNativeEndian &&
+           format.mBitsPerChannel == 32 && format.mBytesPerFrame == sizeof(float) && format.mChannelsPerFrame != 0;
+}
+
+/// Returns the bits of a float.
+std::uint32_t floatBits(float f) noexcept {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof u);
+    return u;
+}
+
+/// Returns the float with the specified bits.
+float bitsFloat(std::uint32_t u) noexcept {
+    float f;
+    std::memcpy(&f, &u, sizeof f);
+    return f;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/// Returns true if the CPU converts between half-precision and single-precision floats (F16C).
+bool hasF16C() noexcept {
+    static const bool supported = __builtin_cpu_supports("f16c");
+    return supported;
+}
+
+/// Converts count floats to half-precision floats using F16C.
+__attribute__((target("avx,f16c"))) void convertFloatToHalfF16C(std::uint16_t *const _Nonnull dst,
+                                                                 const float *const _Nonnull src,
+                                                                 std::size_t count) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+    }
+    for (; i < count; ++i) {
+        dst[i] = _cvtss_sh(src[i], _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+}
+
+/// Converts count half-precision floats to floats using F16C.
+__attribute__((target("avx,f16c"))) void convertHalfToFloatF16C(float *const _Nonnull dst,
+                                                                 const std::uint16_t *const _Nonnull src,
+                                                                 std::size_t count) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < count; ++i) {
+        dst[i] = _cvtsh_ss(src[i]);
+    }
+}
+#endif
+
+/// Converts count floats to half-precision floats.
+void convertFloatToHalf(std::uint16_t *const _Nonnull dst, const float *const _Nonnull src,
+                        std::size_t count) noexcept {
+#if defined(__aarch64__) && defined(__FLT16_MANT_DIG__)
+    // Native conversions that the compiler vectorizes (FCVTN)
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto h = static_cast<_Float16>(src[i]);
+        std::memcpy(dst + i, &h, sizeof h);
+    }
+#else
+#if defined(__x86_64__) || defined(__i386__)
+    if (hasF16C()) [[likely]] {
+        convertFloatToHalfF16C(dst, src, count);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = spsc::detail::floatToHalf(src[i]);
+    }
+#endif
+}
+
+/// Converts count half-precision floats to floats.
+void convertHalfToFloat(float *const _Nonnull dst, const std::uint16_t *const _Nonnull src,
+                        std::size_t count) noexcept {
+#if defined(__aarch64__) && defined(__FLT16_MANT_DIG__)
+    for (std::size_t i = 0; i < count; ++i) {
+        _Float16 h;
+        std::memcpy(&h, src + i, sizeof h);
+        dst[i] = static_cast<float>(h);
+    }
+#else
+#if defined(__x86_64__) || defined(__i386__)
+    if (hasF16C()) [[likely]] {
+        convertHalfToFloatF16C(dst, src, count);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = spsc::detail::halfToFloat(src[i]);
+    }
+#endif
+}
+
+/// Converts count floats to dithered signed 16-bit integers.
+/// @param state The state of the xorshift generator used for dither.
+void convertFloatToInt16(std::uint16_t *const _Nonnull dst, const float *const _Nonnull src, std::size_t count,
+                         std::uint32_t &state) noexcept {
+    constexpr float scale = 32768.0f;
+    constexpr float unitScale = 1.0f / 4294967296.0f;
+
+    auto s = state;
+    const auto next = [&s]() noexcept {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return static_cast<float>(s) * unitScale;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        // Triangular dither with a peak amplitude of one LSB
+        const auto dither = next() - next();
+        const auto sample = std::floor(src[i] * scale + dither + 0.5f);
+        // NaN fails every comparison in std::clamp and cannot be converted to an integer, so store silence
+        const auto clipped = std::isnan(sample) ? 0.0f : std::clamp(sample, -32768.0f, 32767.0f);
+        dst[i] = static_cast<std::uint16_t>(static_cast<std::int16_t>(clipped));
+    }
+
+    state = s;
+}
+
+/// Converts count signed 16-bit integers to floats.
+void convertInt16ToFloat(float *const _Nonnull dst, const std::uint16_t *const _Nonnull src,
+                         std::size_t count) noexcept {
+    constexpr float scale = 1.0f / 32768.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<float>(static_cast<std::int16_t>(src[i])) * scale;
+    }
+}
+
+} /* namespace */
+
+// MARK: Half-Precision Conversion
+
+std::uint16_t spsc::detail::floatToHalf(float value) noexcept {
+    constexpr std::uint32_t f32Infinity = 255U << 23;
+    constexpr std::uint32_t f16Max = (127U + 16U) << 23;
+    constexpr std::uint32_t denormMagic = ((127U - 15U) + (23U - 10U) + 1U) << 23;
+
+    auto f = floatBits(value);
+    const auto sign = f & 0x80000000U;
+    f ^= sign;
+
+    std::uint32_t h;
+    if (f >= f16Max) {
+        // Overflow to infinity, preserving NaN
+        h = f > f32Infinity ? 0x7e00U : 0x7c00U;
+    } else if (f < (113U << 23)) {
+        // Subnormal or zero; let the FPU do the rounding
+        h = floatBits(bitsFloat(f) + bitsFloat(denormMagic)) - denormMagic;
+    } else {
+        const auto mantissaOdd = (f >> 13) & 1U;
+        f += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xfffU;
+        f += mantissaOdd;
+        h = f >> 13;
+    }
+
+    return static_cast<std::uint16_t>(h | (sign >> 16));
+}
+
+float spsc::detail::halfToFloat(std::uint16_t value) noexcept {
+    constexpr std::uint32_t shiftedExponent = 0x7c00U << 13;
+
+    auto f = static_cast<std::uint32_t>(value & 0x7fffU) << 13;
+    const auto exponent = shiftedExponent & f;
+    f += (127U - 15U) << 23;
+
+    if (exponent == shiftedExponent) {
+        // Infinity or NaN
+        f += (128U - 16U) << 23;
+    } else if (exponent == 0) {
+        // Zero or subnormal
+        f += 1U << 23;
+        f = floatBits(bitsFloat(f) - bitsFloat(113U << 23));
+    }
+
+    return bitsFloat(f | (static_cast<std::uint32_t>(value & 0x8000U) << 16));
+}
+
+// MARK: Construction and Destruction
+
+spsc::CompactAudioRingBuffer::CompactAudioRingBuffer(const AudioStreamBasicDescription &format,
+                                                     SizeType minFrameCapacity, StorageFormat storageFormat) {
+    if (!isSupportedFormat(format)) [[unlikely]] {
+        throw std::invalid_argument("unsupported audio format");
+    }
+    if (minFrameCapacity < minCapacity || minFrameCapacity > maxCapacity) [[unlikely]] {
+        throw std::invalid_argument("capacity out of range");
+    }
+    if (!allocate(format, minFrameCapacity, storageFormat)) [[unlikely]] {
+        throw std::bad_alloc();
+    }
+}
+
+spsc::CompactAudioRingBuffer::CompactAudioRingBuffer(CompactAudioRingBuffer &&other) noexcept
+    : buffers_{std::exchange(other.buffers_, nullptr)}, index_{std::move(other.index_)},
+      storageFormat_{std::exchange(other.storageFormat_, StorageFormat::float16)},
+      ditherState_{std::exchange(other.ditherState_, 1)}, format_{std::exchange(other.format_, {})} {}
+
+auto spsc::CompactAudioRingBuffer::operator=(CompactAudioRingBuffer &&other) noexcept -> CompactAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        std::free(buffers_);
+        buffers_ = std::exchange(other.buffers_, nullptr);
+
+        index_ = std::move(other.index_);
+
+        storageFormat_ = std::exchange(other.storageFormat_, StorageFormat::float16);
+        ditherState_ = std::exchange(other.ditherState_, 1);
+
+        format_ = std::exchange(other.format_, {});
+    }
+    return *this;
+}
+
+spsc::CompactAudioRingBuffer::~CompactAudioRingBuffer() noexcept { std::free(buffers_); }
+
+// MARK: Buffer Management
+
+bool spsc::CompactAudioRingBuffer::allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                                            StorageFormat storageFormat) noexcept {
+    if (!isSupportedFormat(format)) [[unlikely]] {
+        return false;
+    }
+    if (minFrameCapacity < minCapacity || minFrameCapacity > maxCapacity) [[unlikely]] {
+        return false;
+    }
+
+    /// Values larger than this will overflow AudioBuffer.mDataByteSize
+    const auto maxAudioBufferFrameCount = std::numeric_limits<UInt32>::max() / format.mBytesPerFrame;
+    /// Values larger than this will exceed the maximum allocation size
+    const auto maxAllocationFrameCount =
+            ((std::numeric_limits<std::size_t>::max() / format.mChannelsPerFrame) - sizeof(void *)) /
+            sizeof(StorageType);
+
+    /// The maximum size per channel buffer in audio frames
+    const auto maxChannelBufferFrameSize =
+            std::min(static_cast<std::size_t>(maxAudioBufferFrameCount), maxAllocationFrameCount);
+
+    // Round to nearest power of two
+    const auto channelBufferFrameSize = detail::bit_ceil(minFrameCapacity);
+    if (channelBufferFrameSize > maxChannelBufferFrameSize) [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    const auto channelBufferByteSize = channelBufferFrameSize * sizeof(StorageType);
+    const auto allocationSize = (channelBufferByteSize + sizeof(void *)) * format.mChannelsPerFrame;
+
+    // Large zeroed allocations are satisfied with untouched zero-fill pages, so no pages are committed here
+    auto allocation = std::calloc(1, allocationSize);
+    if (allocation == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    // Assign the channel buffers
+    auto address = reinterpret_cast<uintptr_t>(allocation);
+
+    buffers_ = reinterpret_cast<StorageType **>(address);
+    address += format.mChannelsPerFrame * sizeof(void *);
+    for (UInt32 i = 0; i < format.mChannelsPerFrame; ++i) {
+        buffers_[i] = reinterpret_cast<StorageType *>(address);
+        address += channelBufferByteSize;
+    }
+
+    index_.reset(channelBufferFrameSize);
+
+    storageFormat_ = storageFormat;
+    ditherState_ = 1;
+
+    format_ = format;
+
+    return true;
+}
+
+void spsc::CompactAudioRingBuffer::deallocate() noexcept {
+    if (buffers_) [[likely]] {
+        std::free(buffers_);
+        buffers_ = nullptr;
+
+        index_.reset(0);
+
+        storageFormat_ = StorageFormat::float16;
+
+        format_ = {};
+    }
+}
+
+// MARK: Sample Conversion
+
+void spsc::CompactAudioRingBuffer::encode(StorageType *const _Nonnull dst, const float *const _Nonnull src,
+                                          SizeType count) noexcept {
+    switch (storageFormat_) {
+    case StorageFormat::float16:
+        convertFloatToHalf(dst, src, count);
+        break;
+    case StorageFormat::int16:
+        convertFloatToInt16(dst, src, count, ditherState_);
+        break;
+    }
+}
+
+void spsc::CompactAudioRingBuffer::decode(float *const _Nonnull dst, const StorageType *const _Nonnull src,
+                                          SizeType count) const noexcept {
+    switch (storageFormat_) {
+    case StorageFormat::float16:
+        convertHalfToFloat(dst, src, count);
+        break;
+    case StorageFormat::int16:
+        convertInt16ToFloat(dst, src, count);
+        break;
+    }
+}
@@ -0,0 +1,469 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/CompressedAudioRingBuffer.hpp"
+
+#include "spsc/BitOperations.hpp"
+#include "BlockCodec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Returns true if format is non-interleaved native 32-bit float.
+bool isFloat32(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsFloat) != 0 && format.mBitsPerChannel == 32 &&
+           format.mBytesPerFrame == sizeof(float);
+}
+
+/// Returns true if format is non-interleaved native signed 16-bit integer.
+bool isInt16(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsFloat) == 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsSignedInteger) != 0 && format.mBitsPerChannel == 16 &&
+           format.mBytesPerFrame == sizeof(std::int16_t);
+}
+
+/// Returns true if format is supported.
+bool isSupportedFormat(const AudioStreamBasicDescription &format) noexcept {
+    return (format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) != 0 &&
+           (format.mFormatFlags & kAudioFormatFlagIsBigEndian) == kAudioFormatFlagsNativeEndian &&
+           format.mChannelsPerFrame != 0 && (isFloat32(format) || isInt16(format));
+}
+
+/// Converts count samples in format from src to 16-bit integers.
+void toInt16(std::int16_t *const _Nonnull dst, const void *const _Nonnull src, std::size_t count,
+             const AudioStreamBasicDescription &format) noexcept {
+    if (isInt16(format)) {
+        std::memcpy(dst, src, count * sizeof(std::int16_t));
+        return;
+    }
+    const auto samples = static_cast<const float *>(src);
+    for (std::size_t i = 0; i < count; ++i) {
+        // NaN fails every comparison in std::clamp and cannot be converted to an integer, so store silence
+        const auto sample = std::nearbyint(samples[i] * 32768.0f);
+        dst[i] = std::isnan(sample) ? 0 : static_cast<std::int16_t>(std::clamp(sample, -32768.0f, 32767.0f));
+    }
+}
+
+/// Converts count 16-bit integers from src to samples in format.
+void fromInt16(void *const _Nonnull dst, const std::int16_t *const _Nonnull src, std::size_t count,
+               const AudioStreamBasicDescription &format) noexcept {
+    if (isInt16(format)) {
+        std::memcpy(dst, src, count * sizeof(std::int16_t));
+        return;
+    }
+    auto samples = static_cast<float *>(dst);
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<float>(src[i]) * (1.0f / 32768.0f);
+    }
+}
+
+} /* namespace */
+
+struct spsc::CompressedAudioRingBuffer::Helper {
+    /// The helper thread.
+    std::thread thread;
+    /// Set to request the helper thread exit.
+    std::atomic<bool> stop{false};
+    /// The interval at which the helper thread runs.
+    std::chrono::microseconds interval{};
+    /// Held by the helper thread during a pass and by a move while it changes ``owner``.
+    std::mutex mutex;
+    /// The ring buffer the helper thread compresses audio for.
+    CompressedAudioRingBuffer *owner{nullptr};
+
+    /// Channel data for ``transfer``.
+    std::vector<unsigned char> data;
+    std::vector<unsigned char> transferStorage;
+    /// A block of audio read from the staging ring.
+    AudioBufferList *transfer{nullptr};
+    /// A block of audio converted to 16-bit integers.
+    std::vector<std::int16_t> samples;
+
+    /// An encoded block waiting for space in the compressed ring.
+    std::vector<unsigned char> encoded;
+    /// The size of the block in ``encoded`` in bytes, or zero if none.
+    SizeType encodedSize{0};
+    /// The number of audio frames in ``encoded``.
+    SizeType encodedFrameCount{0};
+
+    /// The number of staged audio frames to compress regardless of block size.
+    SizeType flushFrameCount{0};
+};
+
+// MARK: Construction and Destruction
+
+spsc::CompressedAudioRingBuffer::CompressedAudioRingBuffer() noexcept = default;
+
+spsc::CompressedAudioRingBuffer::CompressedAudioRingBuffer(CompressedAudioRingBuffer &&other) noexcept {
+    *this = std::move(other);
+}
+
+auto spsc::CompressedAudioRingBuffer::operator=(CompressedAudioRingBuffer &&other) noexcept
+        -> CompressedAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        deallocate();
+
+        // Keep the helper thread out of pump() while the rings change hands
+        std::unique_lock<std::mutex> lock;
+        if (other.helper_) {
+            lock = std::unique_lock{other.helper_->mutex};
+        }
+
+        const auto exchange = [](AtomicSizeType &from, AtomicSizeType &to) noexcept {
+            to.store(from.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        };
+
+        staging_ = std::move(other.staging_);
+
+        compressed_ = std::move(other.compressed_);
+        compressedByteCapacity_ = std::exchange(other.compressedByteCapacity_, 0);
+        exchange(other.compressedReadPosition_, compressedReadPosition_);
+        exchange(other.compressedWritePosition_, compressedWritePosition_);
+
+        blocks_ = std::move(other.blocks_);
+        blockMask_ = std::exchange(other.blockMask_, 0);
+        exchange(other.blockWritePosition_, blockWritePosition_);
+        exchange(other.blockReadPosition_, blockReadPosition_);
+
+        blockFrameCount_ = std::exchange(other.blockFrameCount_, 0);
+
+        exchange(other.writePosition_, writePosition_);
+        exchange(other.readPosition_, readPosition_);
+
+        decoded_ = std::move(other.decoded_);
+        decodedFrameCount_ = std::exchange(other.decodedFrameCount_, 0);
+        decodedOffset_ = std::exchange(other.decodedOffset_, 0);
+
+        flushRequested_.store(other.flushRequested_.exchange(false, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+
+        format_ = std::exchange(other.format_, {});
+
+        helper_ = std::move(other.helper_);
+        if (helper_) {
+            helper_->owner = this;
+        }
+    }
+    return *this;
+}
+
+spsc::CompressedAudioRingBuffer::~CompressedAudioRingBuffer() noexcept { deallocate(); }
+
+// MARK: Buffer Management
+
+bool spsc::CompressedAudioRingBuffer::allocate(const AudioStreamBasicDescription &format, SizeType blockFrameCount,
+                                               SizeType maxBlockCount, SizeType compressedByteCapacity,
+                                               std::chrono::microseconds helperInterval) noexcept {
+    if (!isSupportedFormat(format)) [[unlikely]] {
+        return false;
+    }
+    if (blockFrameCount == 0 || maxBlockCount == 0 || blockFrameCount > AudioRingBuffer::maxCapacity / 4 ||
+        maxBlockCount > AudioRingBuffer::maxCapacity) [[unlikely]] {
+        return false;
+    }
+
+    /// Values larger than this will overflow the size of an encoded block
+    const auto maxBlockFrameCount = (std::numeric_limits<SizeType>::max() / format.mChannelsPerFrame - 2) / 2;
+    if (blockFrameCount > maxBlockFrameCount) [[unlikely]] {
+        return false;
+    }
+
+    // Every block must fit in the compressed ring even if it does not compress
+    const auto maxBlockSize = detail::maxEncodedChannelSize(blockFrameCount) * format.mChannelsPerFrame;
+    if (compressedByteCapacity < maxBlockSize) [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    if (!staging_.allocate(format, blockFrameCount * 4)) [[unlikely]] {
+        return false;
+    }
+
+    try {
+        const auto blockCapacity = detail::bit_ceil(maxBlockCount);
+
+        compressed_ = std::make_unique<unsigned char[]>(compressedByteCapacity);
+        blocks_ = std::make_unique<BlockInfo[]>(blockCapacity);
+        decoded_ = std::make_unique<std::int16_t[]>(blockFrameCount * format.mChannelsPerFrame);
+
+        auto helper = std::make_unique<Helper>();
+        helper->interval = helperInterval;
+
+        const auto byteSize = blockFrameCount * format.mBytesPerFrame;
+        helper->data.resize(byteSize * format.mChannelsPerFrame);
+        helper->transferStorage.resize(offsetof(AudioBufferList, mBuffers) +
+                                       sizeof(AudioBuffer) * format.mChannelsPerFrame);
+        helper->transfer = reinterpret_cast<AudioBufferList *>(helper->transferStorage.data());
+        helper->transfer->mNumberBuffers = format.mChannelsPerFrame;
+        for (UInt32 i = 0; i < format.mChannelsPerFrame; ++i) {
+            helper->transfer->mBuffers[i].mNumberChannels = 1;
+            helper->transfer->mBuffers[i].mDataByteSize = static_cast<UInt32>(byteSize);
+            helper->transfer->mBuffers[i].mData = helper->data.data() + i * byteSize;
+        }
+        helper->samples.resize(blockFrameCount * format.mChannelsPerFrame);
+        helper->encoded.resize(maxBlockSize);
+
+        compressedByteCapacity_ = compressedByteCapacity;
+        blockMask_ = blockCapacity - 1;
+        blockFrameCount_ = blockFrameCount;
+        format_ = format;
+
+        helper->owner = this;
+        helper_ = std::move(helper);
+        helper_->thread = std::thread([helper = helper_.get()] {
+            while (!helper->stop.load(std::memory_order_acquire)) {
+                {
+                    std::lock_guard lock{helper->mutex};
+                    helper->owner->pump();
+                }
+                std::this_thread::sleep_for(helper->interval);
+            }
+        });
+    } catch (const std::bad_alloc &) {
+        deallocate();
+        return false;
+    } catch (const std::system_error &) {
+        deallocate();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::CompressedAudioRingBuffer::deallocate() noexcept {
+    if (helper_) {
+        helper_->stop.store(true, std::memory_order_release);
+        if (helper_->thread.joinable()) {
+            helper_->thread.join();
+        }
+        helper_.reset();
+    }
+
+    staging_.deallocate();
+
+    compressed_.reset();
+    compressedByteCapacity_ = 0;
+    compressedReadPosition_.store(0, std::memory_order_relaxed);
+    compressedWritePosition_.store(0, std::memory_order_relaxed);
+
+    blocks_.reset();
+    blockMask_ = 0;
+    blockWritePosition_.store(0, std::memory_order_relaxed);
+    blockReadPosition_.store(0, std::memory_order_relaxed);
+
+    blockFrameCount_ = 0;
+
+    writePosition_.store(0, std::memory_order_relaxed);
+    readPosition_.store(0, std::memory_order_relaxed);
+
+    decoded_.reset();
+    decodedFrameCount_ = 0;
+    decodedOffset_ = 0;
+
+    flushRequested_.store(false, std::memory_order_relaxed);
+
+    format_ = {};
+}
+
+// MARK: Reading Audio
+
+auto spsc::CompressedAudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || blockFrameCount_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = writePos - readPos;
+
+    if (framesAvailable == 0) [[unlikely]] {
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
+        }
+        return 0;
+    }
+
+    const auto framesToRead = std::min(framesAvailable, frameCount);
+
+    SizeType framesRead = 0;
+    while (framesRead < framesToRead) {
+        if (decodedOffset_ == decodedFrameCount_) {
+            decodeNextBlock();
+        }
+
+        const auto framesToCopy = std::min(decodedFrameCount_ - decodedOffset_, framesToRead - framesRead);
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert((framesRead + framesToCopy) * format_.mBytesPerFrame <= bufferList->mBuffers[i].mDataByteSize);
+            fromInt16(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + framesRead * format_.mBytesPerFrame,
+                      decoded_.get() + i * blockFrameCount_ + decodedOffset_, framesToCopy, format_);
+        }
+
+        decodedOffset_ += framesToCopy;
+        framesRead += framesToCopy;
+    }
+
+    readPosition_.store(readPos + framesToRead, std::memory_order_release);
+
+    // Fill remainder with silence if fewer than requested frames read
+    if (framesToRead != frameCount) {
+        const auto byteOffset = framesToRead * format_.mBytesPerFrame;
+        const auto byteCount = (frameCount - framesToRead) * format_.mBytesPerFrame;
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(byteOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memset(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + byteOffset, 0, byteCount);
+        }
+    }
+
+    return framesToRead;
+}
+
+// MARK: Discarding Audio
+
+auto spsc::CompressedAudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
+    if (frameCount == 0 || blockFrameCount_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = writePos - readPos;
+
+    if (framesAvailable == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto framesToSkip = std::min(framesAvailable, frameCount);
+
+    SizeType framesSkipped = 0;
+    while (framesSkipped < framesToSkip) {
+        if (decodedOffset_ == decodedFrameCount_) {
+            const auto &block = blocks_[blockReadPosition_.load(std::memory_order_relaxed) & blockMask_];
+            if (block.frameCount <= framesToSkip - framesSkipped) {
+                framesSkipped += discardNextBlock();
+                continue;
+            }
+            decodeNextBlock();
+        }
+
+        const auto framesInBlock = std::min(decodedFrameCount_ - decodedOffset_, framesToSkip - framesSkipped);
+        decodedOffset_ += framesInBlock;
+        framesSkipped += framesInBlock;
+    }
+
+    readPosition_.store(readPos + framesToSkip, std::memory_order_release);
+    return framesToSkip;
+}
+
+auto spsc::CompressedAudioRingBuffer::drain() noexcept -> SizeType { return skip(availableFrames()); }
+
+// MARK: Block Management
+
+void spsc::CompressedAudioRingBuffer::decodeNextBlock() noexcept {
+    const auto blockReadPos = blockReadPosition_.load(std::memory_order_relaxed);
+    const auto &block = blocks_[blockReadPos & blockMask_];
+
+    auto src = compressed_.get() + block.offset % compressedByteCapacity_;
+    for (UInt32 i = 0; i < format_.mChannelsPerFrame; ++i) {
+        src += detail::decodeChannel(src, decoded_.get() + i * blockFrameCount_, block.frameCount);
+    }
+
+    decodedFrameCount_ = block.frameCount;
+    decodedOffset_ = 0;
+
+    compressedReadPosition_.store(block.offset + block.size, std::memory_order_release);
+    blockReadPosition_.store(blockReadPos + 1, std::memory_order_release);
+}
+
+auto spsc::CompressedAudioRingBuffer::discardNextBlock() noexcept -> SizeType {
+    const auto blockReadPos = blockReadPosition_.load(std::memory_order_relaxed);
+    const auto &block = blocks_[blockReadPos & blockMask_];
+    const auto frameCount = block.frameCount;
+
+    compressedReadPosition_.store(block.offset + block.size, std::memory_order_release);
+    blockReadPosition_.store(blockReadPos + 1, std::memory_order_release);
+
+    return frameCount;
+}
+
+// MARK: Helper Thread
+
+void spsc::CompressedAudioRingBuffer::pump() noexcept {
+    auto &helper = *helper_;
+
+    if (flushRequested_.exchange(false, std::memory_order_acq_rel)) {
+        helper.flushFrameCount = staging_.availableFrames();
+    }
+
+    for (;;) {
+        // Encode the next block unless one is already waiting for space
+        if (helper.encodedSize == 0) {
+            const auto framesToEncode = std::min(staging_.availableFrames(), blockFrameCount_);
+            if (framesToEncode == 0 || (framesToEncode < blockFrameCount_ && helper.flushFrameCount == 0)) {
+                break;
+            }
+
+            staging_.read(helper.transfer, framesToEncode);
+            helper.flushFrameCount -= std::min(helper.flushFrameCount, framesToEncode);
+
+            SizeType size = 0;
+            for (UInt32 i = 0; i < format_.mChannelsPerFrame; ++i) {
+                auto samples = helper.samples.data() + i * blockFrameCount_;
+                toInt16(samples, helper.transfer->mBuffers[i].mData, framesToEncode, format_);
+                size += detail::encodeChannel(samples, framesToEncode, helper.encoded.data() + size);
+            }
+
+            helper.encodedSize = size;
+            helper.encodedFrameCount = framesToEncode;
+        }
+
+        // Append the block to the compressed ring if there is room
+        const auto blockWritePos = blockWritePosition_.load(std::memory_order_relaxed);
+        if (blockWritePos - blockReadPosition_.load(std::memory_order_acquire) > blockMask_) {
+            break;
+        }
+
+        // Blocks are contiguous so skip to the start of the ring if the block would wrap
+        auto offset = compressedWritePosition_.load(std::memory_order_relaxed);
+        const auto index = offset % compressedByteCapacity_;
+        if (index + helper.encodedSize > compressedByteCapacity_) {
+            offset += compressedByteCapacity_ - index;
+            // Once the consumer has released every block the skipped bytes are free too, so release them; otherwise
+            // a block larger than the space before the wrap could never be placed. The consumer only stores its
+            // position after decoding a block, and the write position is stored first so neither passes the other.
+            if (blockWritePos == blockReadPosition_.load(std::memory_order_acquire)) {
+                compressedWritePosition_.store(offset, std::memory_order_release);
+                compressedReadPosition_.store(offset, std::memory_order_release);
+            }
+        }
+        if (offset + helper.encodedSize - compressedReadPosition_.load(std::memory_order_acquire) >
+            compressedByteCapacity_) {
+            break;
+        }
+
+        std::memcpy(compressed_.get() + offset % compressedByteCapacity_, helper.encoded.data(), helper.encodedSize);
+        blocks_[blockWritePos & blockMask_] = {offset, helper.encodedSize, helper.encodedFrameCount};
+
+        compressedWritePosition_.store(offset + helper.encodedSize, std::memory_order_release);
+        blockWritePosition_.store(blockWritePos + 1, std::memory_order_release);
+        writePosition_.store(writePosition_.load(std::memory_order_relaxed) + helper.encodedFrameCount,
+                             std::memory_order_release);
+
+        helper.encodedSize = 0;
+        helper.encodedFrameCount = 0;
+    }
+}
@@ -0,0 +1,137 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/ExactAudioRingBuffer.hpp"
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// MARK: Construction and Destruction
+
+spsc::ExactAudioRingBuffer::ExactAudioRingBuffer(const AudioStreamBasicDescription &format, SizeType frameCapacity) {
+    if ((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 || format.mBytesPerFrame == 0 ||
+        format.mChannelsPerFrame == 0) [[unlikely]] {
+        throw std::invalid_argument("unsupported audio format");
+    }
+    if (frameCapacity < minCapacity || frameCapacity > maxCapacity) [[unlikely]] {
+        throw std::invalid_argument("capacity out of range");
+    }
+    if (!allocate(format, frameCapacity)) [[unlikely]] {
+        throw std::bad_alloc();
+    }
+}
+
+spsc::ExactAudioRingBuffer::ExactAudioRingBuffer(ExactAudioRingBuffer &&other) noexcept
+    : buffers_{std::exchange(other.buffers_, nullptr)}, allocationSize_{std::exchange(other.allocationSize_, 0)},
+      capacity_{std::exchange(other.capacity_, 0)}, positionLimit_{std::exchange(other.positionLimit_, 0)},
+      writePosition_{other.writePosition_.exchange(0, std::memory_order_relaxed)},
+      readPosition_{other.readPosition_.exchange(0, std::memory_order_relaxed)},
+      format_{std::exchange(other.format_, {})} {}
+
+auto spsc::ExactAudioRingBuffer::operator=(ExactAudioRingBuffer &&other) noexcept -> ExactAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        std::free(buffers_);
+        buffers_ = std::exchange(other.buffers_, nullptr);
+        allocationSize_ = std::exchange(other.allocationSize_, 0);
+
+        capacity_ = std::exchange(other.capacity_, 0);
+        positionLimit_ = std::exchange(other.positionLimit_, 0);
+
+        writePosition_.store(other.writePosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        readPosition_.store(other.readPosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        format_ = std::exchange(other.format_, {});
+    }
+    return *this;
+}
+
+spsc::ExactAudioRingBuffer::~ExactAudioRingBuffer() noexcept { std::free(buffers_); }
+
+// MARK: Buffer Management
+
+bool spsc::ExactAudioRingBuffer::allocate(const AudioStreamBasicDescription &format, SizeType frameCapacity) noexcept {
+    if ((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 || format.mBytesPerFrame == 0 ||
+        format.mChannelsPerFrame == 0) [[unlikely]] {
+        return false;
+    }
+    if (frameCapacity < minCapacity || frameCapacity > maxCapacity) [[unlikely]] {
+        return false;
+    }
+
+    /// Values larger than this will overflow AudioBuffer.mDataByteSize
+    const auto maxAudioBufferFrameCount = std::numeric_limits<UInt32>::max() / format.mBytesPerFrame;
+    /// Values larger than this will exceed the maximum allocation size
+    const auto maxAllocationFrameCount =
+            ((std::numeric_limits<std::size_t>::max() / format.mChannelsPerFrame) - sizeof(void *)) /
+            format.mBytesPerFrame;
+
+    /// The maximum size per channel buffer in audio frames
+    const auto maxChannelBufferFrameSize =
+            std::min(static_cast<std::size_t>(maxAudioBufferFrameCount), maxAllocationFrameCount);
+
+    const auto channelBufferFrameSize = frameCapacity;
+    if (channelBufferFrameSize > maxChannelBufferFrameSize) [[unlikely]] {
+        return false;
+    }
+
+    const auto channelBufferByteSize = channelBufferFrameSize * format.mBytesPerFrame;
+    const auto allocationSize = (channelBufferByteSize + sizeof(void *)) * format.mChannelsPerFrame;
+
+    void *allocation = buffers_;
+
+    // Reuse the existing allocation if it is large enough
+    if (allocationSize > allocationSize_) {
+        deallocate();
+
+        // Large zeroed allocations are satisfied with untouched zero-fill pages, so no pages are committed here
+        allocation = std::calloc(1, allocationSize);
+        if (allocation == nullptr) [[unlikely]] {
+            return false;
+        }
+
+        allocationSize_ = allocationSize;
+    }
+
+    // Assign the channel buffers
+    auto address = reinterpret_cast<uintptr_t>(allocation);
+
+    buffers_ = reinterpret_cast<void **>(address);
+    address += format.mChannelsPerFrame * sizeof(void *);
+    for (UInt32 i = 0; i < format.mChannelsPerFrame; ++i) {
+        buffers_[i] = reinterpret_cast<void *>(address);
+        address += channelBufferByteSize;
+    }
+
+    capacity_ = channelBufferFrameSize;
+    positionLimit_ = channelBufferFrameSize * 2;
+
+    writePosition_.store(0, std::memory_order_relaxed);
+    readPosition_.store(0, std::memory_order_relaxed);
+
+    format_ = format;
+
+    return true;
+}
+
+void spsc::ExactAudioRingBuffer::deallocate() noexcept {
+    if (buffers_) [[likely]] {
+        std::free(buffers_);
+        buffers_ = nullptr;
+        allocationSize_ = 0;
+
+        capacity_ = 0;
+        positionLimit_ = 0;
+
+        writePosition_.store(0, std::memory_order_relaxed);
+        readPosition_.store(0, std::memory_order_relaxed);
+
+        format_ = {};
+    }
+}
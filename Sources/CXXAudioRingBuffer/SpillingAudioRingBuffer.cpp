@@ -0,0 +1,378 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/SpillingAudioRingBuffer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+/// The maximum number of audio frames moved in one step and stored in one chunk of the temporary file.
+constexpr std::size_t maxChunkFrameCount = 4096;
+/// The size of the buffer used to move unconsumed chunks when compacting the temporary file.
+constexpr std::size_t compactionBufferByteSize = 65536;
+
+/// Creates an audio buffer list in storage with channelCount buffers of byteSize bytes starting at data.
+AudioBufferList *makeBufferList(std::vector<unsigned char> &storage, UInt32 channelCount, unsigned char *data,
+                                std::size_t byteSize) {
+    storage.resize(offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * channelCount);
+    auto bufferList = reinterpret_cast<AudioBufferList *>(storage.data());
+    bufferList->mNumberBuffers = channelCount;
+    for (UInt32 i = 0; i < channelCount; ++i) {
+        bufferList->mBuffers[i].mNumberChannels = 1;
+        bufferList->mBuffers[i].mDataByteSize = static_cast<UInt32>(byteSize);
+        bufferList->mBuffers[i].mData = data != nullptr ? data + i * byteSize : nullptr;
+    }
+    return bufferList;
+}
+
+} /* namespace */
+
+struct spsc::SpillingAudioRingBuffer::Helper {
+    /// The helper thread.
+    std::thread thread;
+    /// Set to request the helper thread exit.
+    std::atomic<bool> stop{false};
+    /// The interval at which the helper thread runs.
+    std::chrono::microseconds interval{};
+    /// Held by the helper thread during a pass and by a move while it changes ``owner``.
+    std::mutex mutex;
+    /// The ring buffer whose rings the helper thread services.
+    SpillingAudioRingBuffer *owner{nullptr};
+
+    /// The temporary file.
+    std::FILE *file{nullptr};
+    /// The offset of the oldest chunk in the temporary file.
+    long readOffset{0};
+    /// The offset at which the next chunk will be written.
+    long writeOffset{0};
+    /// The number of consumed bytes at the start of the temporary file above which it is compacted.
+    long compactionThreshold{0};
+    /// Scratch space for ``compact``.
+    std::vector<unsigned char> compactionBuffer;
+
+    /// The capacity of the scratch buffers in audio frames.
+    SizeType chunkFrames{0};
+    /// The number of bytes in one frame of one channel.
+    UInt32 bytesPerFrame{0};
+
+    /// Channel data for ``transfer`` and ``pending``.
+    std::vector<unsigned char> data;
+    std::vector<unsigned char> transferStorage;
+    std::vector<unsigned char> pendingStorage;
+    std::vector<unsigned char> viewStorage;
+    /// Scratch buffers for audio moving from the input ring.
+    AudioBufferList *transfer{nullptr};
+    /// A chunk read back from the temporary file.
+    AudioBufferList *pending{nullptr};
+    /// A view into the unconsumed part of ``pending``.
+    AudioBufferList *view{nullptr};
+    /// The number of audio frames in ``pending``.
+    SizeType pendingFrames{0};
+    /// The number of audio frames in ``pending`` already written to the output ring.
+    SizeType pendingOffset{0};
+
+    ~Helper() noexcept {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    /// Appends frameCount frames from ``transfer`` to the temporary file.
+    bool writeChunk(SizeType frameCount) noexcept {
+        if (std::fseek(file, writeOffset, SEEK_SET) != 0) [[unlikely]] {
+            return false;
+        }
+        if (std::fwrite(&frameCount, sizeof frameCount, 1, file) != 1) [[unlikely]] {
+            return false;
+        }
+        const auto byteCount = frameCount * bytesPerFrame;
+        for (UInt32 i = 0; i < transfer->mNumberBuffers; ++i) {
+            if (std::fwrite(transfer->mBuffers[i].mData, 1, byteCount, file) != byteCount) [[unlikely]] {
+                return false;
+            }
+        }
+        writeOffset += static_cast<long>(sizeof frameCount + byteCount * transfer->mNumberBuffers);
+        return true;
+    }
+
+    /// Reads the oldest chunk in the temporary file into ``pending``.
+    bool readChunk() noexcept {
+        SizeType frameCount = 0;
+        if (std::fseek(file, readOffset, SEEK_SET) != 0) [[unlikely]] {
+            return false;
+        }
+        if (std::fread(&frameCount, sizeof frameCount, 1, file) != 1 || frameCount > chunkFrames) [[unlikely]] {
+            return false;
+        }
+        const auto byteCount = frameCount * bytesPerFrame;
+        for (UInt32 i = 0; i < pending->mNumberBuffers; ++i) {
+            if (std::fread(pending->mBuffers[i].mData, 1, byteCount, file) != byteCount) [[unlikely]] {
+                return false;
+            }
+        }
+        readOffset += static_cast<long>(sizeof frameCount + byteCount * pending->mNumberBuffers);
+
+        // Reuse the file from the beginning once it has been consumed
+        if (readOffset == writeOffset) {
+            readOffset = 0;
+            writeOffset = 0;
+        }
+
+        pendingFrames = frameCount;
+        pendingOffset = 0;
+        return true;
+    }
+
+    /// Returns true if the consumed chunks at the start of the temporary file should be discarded.
+    ///
+    /// The file is compacted once the consumed prefix exceeds the threshold and is at least as large as the unconsumed
+    /// chunks, so each byte is copied a bounded number of times and the two ranges never overlap.
+    [[nodiscard]] bool shouldCompact() const noexcept {
+        return readOffset > compactionThreshold && readOffset >= writeOffset - readOffset;
+    }
+
+    /// Moves the unconsumed chunks to the start of the temporary file and truncates it.
+    ///
+    /// The destination precedes and does not overlap the source, so on failure the offsets are left unchanged and the
+    /// file remains valid.
+    bool compact() noexcept {
+        long source = readOffset;
+        long destination = 0;
+        while (source < writeOffset) {
+            const auto byteCount = std::min(static_cast<std::size_t>(writeOffset - source), compactionBuffer.size());
+            if (std::fseek(file, source, SEEK_SET) != 0 ||
+                std::fread(compactionBuffer.data(), 1, byteCount, file) != byteCount) [[unlikely]] {
+                return false;
+            }
+            if (std::fseek(file, destination, SEEK_SET) != 0 ||
+                std::fwrite(compactionBuffer.data(), 1, byteCount, file) != byteCount) [[unlikely]] {
+                return false;
+            }
+            source += static_cast<long>(byteCount);
+            destination += static_cast<long>(byteCount);
+        }
+
+        if (std::fflush(file) != 0 || ftruncate(fileno(file), destination) != 0) [[unlikely]] {
+            return false;
+        }
+
+        readOffset = 0;
+        writeOffset = destination;
+        return true;
+    }
+
+    /// Returns true if audio remains in the temporary file or ``pending``.
+    [[nodiscard]] bool hasSpilledAudio() const noexcept {
+        return pendingOffset < pendingFrames || readOffset != writeOffset;
+    }
+};
+
+// MARK: Construction and Destruction
+
+spsc::SpillingAudioRingBuffer::SpillingAudioRingBuffer() noexcept = default;
+
+spsc::SpillingAudioRingBuffer::SpillingAudioRingBuffer(SpillingAudioRingBuffer &&other) noexcept {
+    *this = std::move(other);
+}
+
+auto spsc::SpillingAudioRingBuffer::operator=(SpillingAudioRingBuffer &&other) noexcept -> SpillingAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        deallocate();
+
+        // Keep the helper thread out of pump() while the rings change hands
+        std::unique_lock<std::mutex> lock;
+        if (other.helper_) {
+            lock = std::unique_lock{other.helper_->mutex};
+        }
+
+        input_ = std::move(other.input_);
+        output_ = std::move(other.output_);
+        spillThreshold_ = std::exchange(other.spillThreshold_, 0);
+        spilledFrames_.store(other.spilledFrames_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        spillFailed_.store(other.spillFailed_.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+        helper_ = std::move(other.helper_);
+        if (helper_) {
+            helper_->owner = this;
+        }
+    }
+    return *this;
+}
+
+spsc::SpillingAudioRingBuffer::~SpillingAudioRingBuffer() noexcept { deallocate(); }
+
+// MARK: Buffer Management
+
+bool spsc::SpillingAudioRingBuffer::allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                                             SizeType spillThreshold, std::chrono::microseconds helperInterval,
+                                             SizeType compactionThreshold) noexcept {
+    deallocate();
+
+    if (!input_.allocate(format, minFrameCapacity) || !output_.allocate(format, minFrameCapacity)) [[unlikely]] {
+        deallocate();
+        return false;
+    }
+
+    // A threshold above the capacity could never be met, so every pass would spill all staged audio
+    if (spillThreshold > input_.capacity()) [[unlikely]] {
+        deallocate();
+        return false;
+    }
+
+    try {
+        auto helper = std::make_unique<Helper>();
+
+        helper->interval = helperInterval;
+        helper->compactionThreshold = static_cast<long>(
+                std::min(compactionThreshold, static_cast<SizeType>(std::numeric_limits<long>::max())));
+        helper->compactionBuffer.resize(compactionBufferByteSize);
+        helper->chunkFrames = std::min(input_.capacity(), maxChunkFrameCount);
+        helper->bytesPerFrame = format.mBytesPerFrame;
+
+        const auto chunkByteSize = helper->chunkFrames * format.mBytesPerFrame;
+        helper->data.resize(chunkByteSize * format.mChannelsPerFrame * 2);
+        helper->transfer =
+                makeBufferList(helper->transferStorage, format.mChannelsPerFrame, helper->data.data(), chunkByteSize);
+        helper->pending = makeBufferList(helper->pendingStorage, format.mChannelsPerFrame,
+                                         helper->data.data() + chunkByteSize * format.mChannelsPerFrame, chunkByteSize);
+        helper->view = makeBufferList(helper->viewStorage, format.mChannelsPerFrame, nullptr, 0);
+
+        helper->file = std::tmpfile();
+        if (helper->file == nullptr) [[unlikely]] {
+            deallocate();
+            return false;
+        }
+
+        spillThreshold_ = spillThreshold;
+        helper->owner = this;
+        helper_ = std::move(helper);
+        helper_->thread = std::thread([helper = helper_.get()] {
+            while (!helper->stop.load(std::memory_order_acquire)) {
+                {
+                    std::lock_guard lock{helper->mutex};
+                    helper->owner->pump();
+                }
+                std::this_thread::sleep_for(helper->interval);
+            }
+        });
+    } catch (const std::bad_alloc &) {
+        deallocate();
+        return false;
+    } catch (const std::system_error &) {
+        deallocate();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::SpillingAudioRingBuffer::deallocate() noexcept {
+    if (helper_) {
+        helper_->stop.store(true, std::memory_order_release);
+        if (helper_->thread.joinable()) {
+            helper_->thread.join();
+        }
+        helper_.reset();
+    }
+
+    input_.deallocate();
+    output_.deallocate();
+
+    spillThreshold_ = 0;
+    spilledFrames_.store(0, std::memory_order_relaxed);
+    spillFailed_.store(false, std::memory_order_relaxed);
+}
+
+// MARK: Helper Thread
+
+void spsc::SpillingAudioRingBuffer::pump() noexcept {
+    auto &helper = *helper_;
+
+    // Return spilled audio to the output ring ahead of anything still in the input ring
+    for (;;) {
+        if (helper.pendingOffset == helper.pendingFrames) {
+            if (helper.readOffset == helper.writeOffset) {
+                break;
+            }
+            if (!helper.readChunk()) [[unlikely]] {
+                // The spilled audio is unrecoverable
+                spillFailed_.store(true, std::memory_order_relaxed);
+                helper.readOffset = helper.writeOffset = 0;
+                helper.pendingFrames = helper.pendingOffset = 0;
+                spilledFrames_.store(0, std::memory_order_relaxed);
+                break;
+            }
+        }
+
+        const auto framesToWrite = std::min(output_.freeSpace(), helper.pendingFrames - helper.pendingOffset);
+        if (framesToWrite == 0) {
+            break;
+        }
+
+        const auto byteOffset = helper.pendingOffset * helper.bytesPerFrame;
+        for (UInt32 i = 0; i < helper.view->mNumberBuffers; ++i) {
+            helper.view->mBuffers[i].mData = static_cast<unsigned char *>(helper.pending->mBuffers[i].mData) + byteOffset;
+            helper.view->mBuffers[i].mDataByteSize =
+                    static_cast<UInt32>((helper.pendingFrames - helper.pendingOffset) * helper.bytesPerFrame);
+        }
+
+        const auto framesWritten = output_.write(helper.view, framesToWrite);
+        helper.pendingOffset += framesWritten;
+        spilledFrames_.store(spilledFrames_.load(std::memory_order_relaxed) - framesWritten,
+                             std::memory_order_relaxed);
+    }
+
+    // Discard consumed chunks so a sustained partial backlog does not grow the file without bound; on failure the file
+    // is intact and compaction is retried on the next pass
+    if (helper.shouldCompact()) {
+        helper.compact();
+    }
+
+    // Move staged audio directly to the output ring unless older audio is still on disk
+    if (!helper.hasSpilledAudio()) {
+        for (;;) {
+            const auto framesToMove =
+                    std::min({input_.availableFrames(), output_.freeSpace(), helper.chunkFrames});
+            if (framesToMove == 0) {
+                break;
+            }
+            input_.read(helper.transfer, framesToMove);
+            output_.write(helper.transfer, framesToMove);
+        }
+    }
+
+    // Move the oldest staged audio to disk if the input ring is filling up
+    if (!spillFailed_.load(std::memory_order_relaxed)) {
+        for (;;) {
+            const auto framesUsed = input_.availableFrames();
+            if (input_.capacity() - framesUsed >= spillThreshold_) {
+                break;
+            }
+            const auto framesToSpill = std::min(framesUsed, helper.chunkFrames);
+            if (framesToSpill == 0) {
+                break;
+            }
+            input_.read(helper.transfer, framesToSpill);
+            if (!helper.writeChunk(framesToSpill)) [[unlikely]] {
+                spillFailed_.store(true, std::memory_order_relaxed);
+                break;
+            }
+            spilledFrames_.store(spilledFrames_.load(std::memory_order_relaxed) + framesToSpill,
+                                 std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,235 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/SwappableAudioRingBuffer.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+struct spsc::SwappableAudioRingBuffer::Node {
+    /// The ring buffer.
+    AudioRingBuffer ringBuffer;
+    /// The ring buffer published after this one.
+    std::atomic<Node *> next{nullptr};
+    /// The order in which this ring buffer was published.
+    std::uint64_t epoch{0};
+};
+
+struct spsc::SwappableAudioRingBuffer::Reclaimer {
+    /// The reclaimer thread.
+    std::thread thread;
+    /// Set to request the reclaimer thread exit.
+    std::atomic<bool> stop{false};
+    /// The interval at which the reclaimer thread runs.
+    std::chrono::microseconds interval{};
+    /// Held by the reclaimer thread during a pass and by a move while it changes ``owner``.
+    std::mutex mutex;
+    /// The swappable ring buffer whose retired ring buffers the reclaimer thread frees.
+    SwappableAudioRingBuffer *owner{nullptr};
+};
+
+// MARK: Construction and Destruction
+
+spsc::SwappableAudioRingBuffer::SwappableAudioRingBuffer() noexcept = default;
+
+spsc::SwappableAudioRingBuffer::SwappableAudioRingBuffer(SwappableAudioRingBuffer &&other) noexcept {
+    *this = std::move(other);
+}
+
+auto spsc::SwappableAudioRingBuffer::operator=(SwappableAudioRingBuffer &&other) noexcept
+        -> SwappableAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        deallocate();
+
+        // Keep the reclaimer thread out of a pass while its owner changes
+        std::unique_lock<std::mutex> lock;
+        if (other.reclaimer_) {
+            lock = std::unique_lock{other.reclaimer_->mutex};
+        }
+
+        oldest_ = std::exchange(other.oldest_, nullptr);
+        epoch_ = std::exchange(other.epoch_, 0);
+        latest_.store(other.latest_.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+        producerNode_ = std::exchange(other.producerNode_, nullptr);
+        producerEpoch_.store(other.producerEpoch_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        consumerNode_ = std::exchange(other.consumerNode_, nullptr);
+        consumerEpoch_.store(other.consumerEpoch_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        reclaimer_ = std::move(other.reclaimer_);
+        if (reclaimer_) {
+            reclaimer_->owner = this;
+        }
+    }
+    return *this;
+}
+
+spsc::SwappableAudioRingBuffer::~SwappableAudioRingBuffer() noexcept { deallocate(); }
+
+// MARK: Buffer Management
+
+bool spsc::SwappableAudioRingBuffer::allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                                              std::chrono::microseconds reclaimInterval) noexcept {
+    deallocate();
+
+    auto node = new (std::nothrow) Node;
+    if (node == nullptr) [[unlikely]] {
+        return false;
+    }
+    if (!node->ringBuffer.allocate(format, minFrameCapacity)) [[unlikely]] {
+        delete node;
+        return false;
+    }
+
+    oldest_ = node;
+    latest_.store(node, std::memory_order_relaxed);
+    producerNode_ = node;
+    consumerNode_ = node;
+
+    try {
+        auto reclaimer = std::make_unique<Reclaimer>();
+        reclaimer->interval = reclaimInterval;
+        reclaimer->owner = this;
+
+        reclaimer_ = std::move(reclaimer);
+        if (reclaimInterval == manualReclaimInterval) {
+            return true;
+        }
+        reclaimer_->thread = std::thread([reclaimer = reclaimer_.get()] {
+            while (!reclaimer->stop.load(std::memory_order_acquire)) {
+                {
+                    std::lock_guard lock{reclaimer->mutex};
+                    reclaimer->owner->reclaim();
+                }
+                std::this_thread::sleep_for(reclaimer->interval);
+            }
+        });
+    } catch (const std::bad_alloc &) {
+        deallocate();
+        return false;
+    } catch (const std::system_error &) {
+        deallocate();
+        return false;
+    }
+
+    return true;
+}
+
+void spsc::SwappableAudioRingBuffer::deallocate() noexcept {
+    if (reclaimer_) {
+        reclaimer_->stop.store(true, std::memory_order_release);
+        if (reclaimer_->thread.joinable()) {
+            reclaimer_->thread.join();
+        }
+        reclaimer_.reset();
+    }
+
+    while (oldest_ != nullptr) {
+        delete std::exchange(oldest_, oldest_->next.load(std::memory_order_relaxed));
+    }
+
+    epoch_ = 0;
+    latest_.store(nullptr, std::memory_order_relaxed);
+    producerNode_ = nullptr;
+    producerEpoch_.store(0, std::memory_order_relaxed);
+    consumerNode_ = nullptr;
+    consumerEpoch_.store(0, std::memory_order_relaxed);
+}
+
+// MARK: Reconfiguration
+
+bool spsc::SwappableAudioRingBuffer::reconfigure(const AudioStreamBasicDescription &format,
+                                                 SizeType minFrameCapacity) noexcept {
+    auto node = new (std::nothrow) Node;
+    if (node == nullptr) [[unlikely]] {
+        return false;
+    }
+    if (!node->ringBuffer.allocate(format, minFrameCapacity)) [[unlikely]] {
+        delete node;
+        return false;
+    }
+
+    std::lock_guard lock{mutex_};
+
+    const auto latest = latest_.load(std::memory_order_relaxed);
+    if (latest == nullptr) [[unlikely]] {
+        delete node;
+        return false;
+    }
+
+    node->epoch = ++epoch_;
+
+    // Link before publishing so the consumer can always follow the chain to the producer's ring buffer
+    latest->next.store(node, std::memory_order_release);
+    latest_.store(node, std::memory_order_release);
+
+    return true;
+}
+
+auto spsc::SwappableAudioRingBuffer::reclaim() noexcept -> SizeType {
+    std::lock_guard lock{mutex_};
+
+    // The producer and consumer only ever move to ring buffers with a later epoch, and the consumer never passes the
+    // producer, so a ring buffer older than both epochs can no longer be reached
+    const auto minEpoch = std::min(producerEpoch_.load(std::memory_order_acquire),
+                                   consumerEpoch_.load(std::memory_order_acquire));
+
+    SizeType count = 0;
+    while (oldest_ != nullptr && oldest_->epoch < minEpoch) {
+        delete std::exchange(oldest_, oldest_->next.load(std::memory_order_acquire));
+        ++count;
+    }
+
+    return count;
+}
+
+// MARK: Access
+
+auto spsc::SwappableAudioRingBuffer::producerBuffer() noexcept -> AudioRingBuffer * {
+    if (producerNode_ == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+
+    const auto latest = latest_.load(std::memory_order_acquire);
+    if (latest != producerNode_) [[unlikely]] {
+        producerNode_ = latest;
+        // Release so the consumer sees every write to the previous ring buffer once it sees the new epoch
+        producerEpoch_.store(latest->epoch, std::memory_order_release);
+    }
+
+    return &producerNode_->ringBuffer;
+}
+
+auto spsc::SwappableAudioRingBuffer::consumerBuffer() noexcept -> AudioRingBuffer * {
+    if (consumerNode_ == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+
+    for (;;) {
+        const auto next = consumerNode_->next.load(std::memory_order_acquire);
+        if (next == nullptr) [[likely]] {
+            break;
+        }
+
+        // The producer may still be writing to this ring buffer
+        if (producerEpoch_.load(std::memory_order_acquire) <= consumerNode_->epoch) {
+            break;
+        }
+
+        if (!consumerNode_->ringBuffer.isEmpty()) {
+            break;
+        }
+
+        consumerNode_ = next;
+        consumerEpoch_.store(next->epoch, std::memory_order_release);
+    }
+
+    return &consumerNode_->ringBuffer;
+}
@@ -0,0 +1,227 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#include "spsc/UnboundedAudioRingBuffer.hpp"
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// MARK: Construction and Destruction
+
+spsc::UnboundedAudioRingBuffer::UnboundedAudioRingBuffer(const AudioStreamBasicDescription &format,
+                                                         SizeType segmentFrameCapacity) {
+    if ((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 || format.mBytesPerFrame == 0 ||
+        format.mChannelsPerFrame == 0) [[unlikely]] {
+        throw std::invalid_argument("unsupported audio format");
+    }
+    if (segmentFrameCapacity < minSegmentCapacity || segmentFrameCapacity > maxSegmentCapacity) [[unlikely]] {
+        throw std::invalid_argument("capacity out of range");
+    }
+    if (!allocate(format, segmentFrameCapacity)) [[unlikely]] {
+        throw std::bad_alloc();
+    }
+}
+
+spsc::UnboundedAudioRingBuffer::UnboundedAudioRingBuffer(UnboundedAudioRingBuffer &&other) noexcept
+    : first_{std::exchange(other.first_, nullptr)}, tail_{std::exchange(other.tail_, nullptr)},
+      spare_{std::exchange(other.spare_, nullptr)}, tailOffset_{std::exchange(other.tailOffset_, 0)},
+      segmentCount_{std::exchange(other.segmentCount_, 0)},
+      head_{other.head_.exchange(nullptr, std::memory_order_relaxed)},
+      headOffset_{std::exchange(other.headOffset_, 0)},
+      segmentCapacity_{std::exchange(other.segmentCapacity_, 0)},
+      writePosition_{other.writePosition_.exchange(0, std::memory_order_relaxed)},
+      readPosition_{other.readPosition_.exchange(0, std::memory_order_relaxed)},
+      format_{std::exchange(other.format_, {})} {}
+
+auto spsc::UnboundedAudioRingBuffer::operator=(UnboundedAudioRingBuffer &&other) noexcept
+        -> UnboundedAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        deallocate();
+
+        first_ = std::exchange(other.first_, nullptr);
+        tail_ = std::exchange(other.tail_, nullptr);
+        spare_ = std::exchange(other.spare_, nullptr);
+        tailOffset_ = std::exchange(other.tailOffset_, 0);
+        segmentCount_ = std::exchange(other.segmentCount_, 0);
+
+        head_.store(other.head_.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+        headOffset_ = std::exchange(other.headOffset_, 0);
+
+        segmentCapacity_ = std::exchange(other.segmentCapacity_, 0);
+
+        writePosition_.store(other.writePosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        readPosition_.store(other.readPosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        format_ = std::exchange(other.format_, {});
+    }
+    return *this;
+}
+
+spsc::UnboundedAudioRingBuffer::~UnboundedAudioRingBuffer() noexcept { deallocate(); }
+
+// MARK: Buffer Management
+
+bool spsc::UnboundedAudioRingBuffer::allocate(const AudioStreamBasicDescription &format,
+                                              SizeType segmentFrameCapacity) noexcept {
+    if ((format.mFormatFlags & kAudioFormatFlagIsNonInterleaved) == 0 || format.mBytesPerFrame == 0 ||
+        format.mChannelsPerFrame == 0) [[unlikely]] {
+        return false;
+    }
+    if (segmentFrameCapacity < minSegmentCapacity || segmentFrameCapacity > maxSegmentCapacity) [[unlikely]] {
+        return false;
+    }
+
+    /// Values larger than this will overflow AudioBuffer.mDataByteSize
+    const auto maxAudioBufferFrameCount = std::numeric_limits<UInt32>::max() / format.mBytesPerFrame;
+    /// Values larger than this will exceed the maximum allocation size
+    const auto maxAllocationFrameCount =
+            (((std::numeric_limits<std::size_t>::max() - sizeof(Segment)) / format.mChannelsPerFrame) -
+             sizeof(void *)) /
+            format.mBytesPerFrame;
+
+    if (segmentFrameCapacity > std::min(static_cast<std::size_t>(maxAudioBufferFrameCount), maxAllocationFrameCount))
+            [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    segmentCapacity_ = segmentFrameCapacity;
+    format_ = format;
+
+    auto segment = allocateSegment();
+    if (segment == nullptr) [[unlikely]] {
+        segmentCapacity_ = 0;
+        format_ = {};
+        return false;
+    }
+
+    first_ = segment;
+    tail_ = segment;
+    tailOffset_ = 0;
+    segmentCount_ = 1;
+
+    head_.store(segment, std::memory_order_relaxed);
+    headOffset_ = 0;
+
+    writePosition_.store(0, std::memory_order_relaxed);
+    readPosition_.store(0, std::memory_order_relaxed);
+
+    return true;
+}
+
+void spsc::UnboundedAudioRingBuffer::deallocate() noexcept {
+    if (tail_) [[likely]] {
+        const auto freeChain = [](Segment *segment) noexcept {
+            while (segment != nullptr) {
+                auto next = segment->next.load(std::memory_order_relaxed);
+                segment->~Segment();
+                std::free(segment);
+                segment = next;
+            }
+        };
+
+        freeChain(first_);
+        freeChain(spare_);
+
+        first_ = nullptr;
+        tail_ = nullptr;
+        spare_ = nullptr;
+        tailOffset_ = 0;
+        segmentCount_ = 0;
+
+        head_.store(nullptr, std::memory_order_relaxed);
+        headOffset_ = 0;
+
+        segmentCapacity_ = 0;
+
+        writePosition_.store(0, std::memory_order_relaxed);
+        readPosition_.store(0, std::memory_order_relaxed);
+
+        format_ = {};
+    }
+}
+
+bool spsc::UnboundedAudioRingBuffer::reserve(SizeType frameCount) noexcept {
+    if (segmentCapacity_ == 0) [[unlikely]] {
+        return false;
+    }
+
+    // Count the frames that may be written without allocating
+    auto framesAvailable = segmentCapacity_ - tailOffset_;
+    for (auto segment = spare_; segment != nullptr; segment = segment->next.load(std::memory_order_relaxed)) {
+        framesAvailable += segmentCapacity_;
+    }
+    const auto head = head_.load(std::memory_order_acquire);
+    for (auto segment = first_; segment != head; segment = segment->next.load(std::memory_order_relaxed)) {
+        framesAvailable += segmentCapacity_;
+    }
+
+    while (framesAvailable < frameCount) {
+        auto segment = allocateSegment();
+        if (segment == nullptr) [[unlikely]] {
+            return false;
+        }
+        segment->next.store(spare_, std::memory_order_relaxed);
+        spare_ = segment;
+        ++segmentCount_;
+        framesAvailable += segmentCapacity_;
+    }
+
+    return true;
+}
+
+auto spsc::UnboundedAudioRingBuffer::trim() noexcept -> SizeType {
+    SizeType segmentsFreed = 0;
+
+    while (spare_ != nullptr) {
+        auto next = spare_->next.load(std::memory_order_relaxed);
+        spare_->~Segment();
+        std::free(spare_);
+        spare_ = next;
+        ++segmentsFreed;
+    }
+
+    const auto head = head_.load(std::memory_order_acquire);
+    while (first_ != nullptr && first_ != head) {
+        auto next = first_->next.load(std::memory_order_relaxed);
+        first_->~Segment();
+        std::free(first_);
+        first_ = next;
+        ++segmentsFreed;
+    }
+
+    segmentCount_ -= segmentsFreed;
+    return segmentsFreed;
+}
+
+auto spsc::UnboundedAudioRingBuffer::allocateSegment() const noexcept -> Segment * {
+    const auto channelBufferByteSize = segmentCapacity_ * format_.mBytesPerFrame;
+    const auto allocationSize = sizeof(Segment) + (channelBufferByteSize + sizeof(void *)) * format_.mChannelsPerFrame;
+
+    auto allocation = std::malloc(allocationSize);
+    if (allocation == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+
+    auto segment = new (allocation) Segment;
+
+    // Assign the channel buffers
+    auto address = reinterpret_cast<uintptr_t>(allocation) + sizeof(Segment);
+
+    segment->buffers = reinterpret_cast<void **>(address);
+    address += format_.mChannelsPerFrame * sizeof(void *);
+    for (UInt32 i = 0; i < format_.mChannelsPerFrame; ++i) {
+        segment->buffers[i] = reinterpret_cast<void *>(address);
+        address += channelBufferByteSize;
+    }
+
+    return segment;
+}
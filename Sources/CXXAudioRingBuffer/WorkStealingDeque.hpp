@@ -0,0 +1,124 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "spsc/BitOperations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace spsc::detail {
+
+/// A fixed-capacity Chase-Lev work-stealing deque of pointers.
+///
+/// The owning thread pushes and pops at the bottom; any other thread may steal from the top. The memory orderings
+/// follow Lê, Pop, Cohen, and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models" (2013).
+template <typename T> class WorkStealingDeque final {
+  public:
+    /// Allocates space for at least minCapacity items.
+    /// @return true on success, false if memory could not be allocated.
+    bool allocate(std::size_t minCapacity) noexcept;
+
+    /// Adds an item at the bottom.
+    /// @note This method is only safe to call from the owning thread.
+    /// @return true on success, false if the deque is full.
+    bool push(T *_Nonnull item) noexcept;
+
+    /// Removes the item at the bottom.
+    /// @note This method is only safe to call from the owning thread.
+    /// @return The item or nullptr if the deque is empty.
+    T *_Nullable pop() noexcept;
+
+    /// Removes the item at the top.
+    /// @note This method is safe to call from any thread.
+    /// @return The item or nullptr if the deque is empty or another thread took the item first.
+    T *_Nullable steal() noexcept;
+
+  private:
+    /// The item slots.
+    std::unique_ptr<std::atomic<T *>[]> buffer_;
+    /// The number of slots.
+    std::int64_t capacity_{0};
+    /// The number of slots minus one.
+    std::int64_t mask_{0};
+    /// The index of the next item to steal.
+    std::atomic<std::int64_t> top_{0};
+    /// The index one past the last pushed item.
+    std::atomic<std::int64_t> bottom_{0};
+};
+
+// MARK: - Implementation -
+
+template <typename T> inline bool WorkStealingDeque<T>::allocate(std::size_t minCapacity) noexcept {
+    const auto capacity = bit_ceil(std::max(minCapacity, std::size_t{2}));
+    buffer_.reset(new (std::nothrow) std::atomic<T *>[capacity]);
+    if (!buffer_) [[unlikely]] {
+        return false;
+    }
+    capacity_ = static_cast<std::int64_t>(capacity);
+    mask_ = capacity_ - 1;
+    top_.store(0, std::memory_order_relaxed);
+    bottom_.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T> inline bool WorkStealingDeque<T>::push(T *_Nonnull item) noexcept {
+    const auto b = bottom_.load(std::memory_order_relaxed);
+    const auto t = top_.load(std::memory_order_acquire);
+    if (b - t >= capacity_) [[unlikely]] {
+        return false;
+    }
+    buffer_[b & mask_].store(item, std::memory_order_relaxed);
+    // A release store rather than a release fence and relaxed store, which is equivalent but visible to TSan
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T> inline T *_Nullable WorkStealingDeque<T>::pop() noexcept {
+    const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto item = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last item: race any thief for it
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            item = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template <typename T> inline T *_Nullable WorkStealingDeque<T>::steal() noexcept {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto b = bottom_.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+
+    auto item = buffer_[t & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return item;
+}
+
+} /* namespace spsc::detail */
@@ -0,0 +1,194 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace spsc {
+
+/// A lock-free queue of fixed-size blocks of non-interleaved audio with one producer and multiple consumers.
+///
+/// The producer fills the next free block and publishes it. Each consumer claims the next whole published block,
+/// reads it in place, and completes it to return the slot to the producer. Blocks may be claimed by several consumers
+/// at once and completed in any order; each block carries its sequence number so results can be put back in order with
+/// ``ReorderBuffer``.
+///
+/// Channel storage is laid out as in ``AudioRingBuffer``, with slot `i` occupying audio frames
+/// [i × blockFrameCount, (i + 1) × blockFrameCount) of each channel buffer. Each slot has a sequence number recording
+/// whether it is free, published, or claimed for a given pass around the queue.
+///
+/// This class is thread safe when used with a single producer and any number of consumers.
+class AudioBlockQueue final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+
+    /// A block reserved by the producer or claimed by a consumer.
+    struct Block {
+        /// The position of the block in the stream of blocks pushed to the queue.
+        SizeType sequence{0};
+        /// The slot holding the block.
+        SizeType slot{0};
+        /// The number of valid audio frames in the block.
+        SizeType frameCount{0};
+    };
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty queue.
+    /// @note ``allocate`` must be called before the object may be used.
+    AudioBlockQueue() noexcept;
+
+    // This class is non-copyable
+    AudioBlockQueue(const AudioBlockQueue &) = delete;
+
+    /// Creates a queue by moving the contents of another queue.
+    /// @note This method is not thread safe for the queue being moved.
+    /// @param other The queue to move.
+    AudioBlockQueue(AudioBlockQueue &&other) noexcept;
+
+    // This class is non-assignable
+    AudioBlockQueue &operator=(const AudioBlockQueue &) = delete;
+
+    /// Moves the contents of another queue into this queue.
+    /// @note This method is not thread safe.
+    /// @param other The queue to move.
+    AudioBlockQueue &operator=(AudioBlockQueue &&other) noexcept;
+
+    /// Destroys the queue and releases all associated resources.
+    ~AudioBlockQueue() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for audio blocks of the specified format.
+    ///
+    /// The actual number of slots will be the smallest integral power of two that is not less than the specified
+    /// minimum.
+    /// @note Only non-interleaved formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be pushed to and claimed from the queue.
+    /// @param blockFrameCount The capacity of one block in audio frames.
+    /// @param minSlotCount The desired minimum number of blocks the queue can hold.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// queue size is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType blockFrameCount, SizeType minSlotCount) noexcept;
+
+    /// Frees any space allocated for audio blocks.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the queue has allocated space for audio blocks.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Queue Information
+
+    /// Returns the format of the audio stored in the queue.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the capacity of one block in audio frames.
+    [[nodiscard]] SizeType blockFrameCount() const noexcept;
+
+    /// Returns the number of blocks the queue can hold.
+    [[nodiscard]] SizeType slotCount() const noexcept;
+
+    // MARK: Block Access
+
+    /// Returns the audio of one channel of a block.
+    ///
+    /// The returned buffer holds ``blockFrameCount`` audio frames.
+    /// @param block A block reserved by the producer or claimed by a consumer.
+    /// @param channel The channel index.
+    /// @return The channel data for the block.
+    [[nodiscard]] void *_Nonnull channelData(const Block &block, UInt32 channel) const noexcept;
+
+    // MARK: Producing
+
+    /// Reserves the next free block for writing.
+    /// @note This method is only safe to call from the producer.
+    /// @param block Receives the reserved block.
+    /// @return true on success, false if every slot holds a block that has not been completed.
+    bool reserve(Block &block) noexcept;
+
+    /// Publishes a reserved block to the consumers.
+    /// @note This method is only safe to call from the producer.
+    /// @param block The block returned by ``reserve``.
+    /// @param frameCount The number of valid audio frames written to the block.
+    void publish(const Block &block, SizeType frameCount) noexcept;
+
+    /// Copies audio into the next free block and publishes it.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The number of audio frames to copy, which must not exceed ``blockFrameCount``.
+    /// @return true on success, false if no block was free.
+    bool push(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Consuming
+
+    /// Claims the oldest published block that no other consumer has claimed.
+    /// @note This method is safe to call from any number of consumers.
+    /// @param block Receives the claimed block.
+    /// @return true on success, false if no published block is available.
+    bool claim(Block &block) noexcept;
+
+    /// Returns a claimed block's slot to the producer.
+    /// @note This method is safe to call from any number of consumers.
+    /// @param block The block returned by ``claim``.
+    void complete(const Block &block) noexcept;
+
+  private:
+    /// Per-slot state.
+    struct Slot;
+
+    /// The memory buffers holding the data, consisting of channel pointers and buffers allocated in one chunk.
+    void *_Nonnull *_Nullable buffers_{nullptr};
+    /// Per-slot state.
+    std::unique_ptr<Slot[]> slots_;
+
+    /// The capacity of one block in audio frames.
+    SizeType blockFrameCount_{0};
+    /// The number of slots.
+    SizeType slotCount_{0};
+    /// The number of slots minus one.
+    SizeType slotMask_{0};
+
+    /// The sequence number of the next block reserved by the producer.
+    SizeType pushPosition_{0};
+    /// The sequence number of the next block to be claimed.
+    std::atomic<SizeType> claimPosition_{0};
+
+    /// The format of the audio this queue contains.
+    AudioStreamBasicDescription format_{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline AudioBlockQueue::operator bool() const noexcept { return buffers_ != nullptr; }
+
+// MARK: Queue Information
+
+inline const AudioStreamBasicDescription &AudioBlockQueue::format() const noexcept { return format_; }
+
+inline auto AudioBlockQueue::blockFrameCount() const noexcept -> SizeType { return blockFrameCount_; }
+
+inline auto AudioBlockQueue::slotCount() const noexcept -> SizeType { return slotCount_; }
+
+// MARK: Block Access
+
+inline void *AudioBlockQueue::channelData(const Block &block, UInt32 channel) const noexcept {
+    assert(buffers_ != nullptr && channel < format_.mChannelsPerFrame && block.slot < slotCount_);
+    return static_cast<unsigned char *>(buffers_[channel]) + block.slot * blockFrameCount_ * format_.mBytesPerFrame;
+}
+
+} /* namespace spsc */
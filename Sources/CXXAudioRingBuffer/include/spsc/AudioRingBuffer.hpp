@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include "AudioRingBufferCostTimer.hpp"
+#include "AudioRingBufferProbes.hpp"
+#include "RingBufferIndex.hpp"
+
 #include <CoreAudioTypes/CoreAudioTypes.h>
 
 #include <algorithm>
@@ -27,6 +31,8 @@ class AudioRingBuffer final {
     using SizeType = std::size_t;
     /// Atomic unsigned integer type.
     using AtomicSizeType = std::atomic<SizeType>;
+    /// A range of audio frames in the channel buffers that may wrap around the end of the buffer.
+    using Region = detail::RingBufferIndex::Region;
 
     /// The minimum supported buffer capacity in audio frames.
     static constexpr SizeType minCapacity = SizeType{2};
@@ -75,6 +81,10 @@ class AudioRingBuffer final {
     ///
     /// The actual buffer capacity will be the smallest integral power of two that is not less than the specified
     /// minimum capacity.
+    ///
+    /// If the existing allocation is large enough for the new format and capacity it is reused and no memory is
+    /// allocated. Any audio in the buffer is discarded. A reused allocation is never shrunk, so memory obtained for a
+    /// larger format or capacity stays allocated until ``deallocate`` is called.
     /// @note Only non-interleaved formats are supported.
     /// @note This method is not thread safe.
     /// @param format The format of the audio that will be written to and read from this buffer.
@@ -87,6 +97,23 @@ class AudioRingBuffer final {
     /// @note This method is not thread safe.
     void deallocate() noexcept;
 
+    /// Touches every page of the allocation so no page faults occur on first use.
+    ///
+    /// Memory obtained by ``allocate`` is zero-filled on demand by the operating system. Call this method before
+    /// handing the buffer to a realtime thread to avoid faulting in pages during ``write`` or ``read``.
+    /// @note This method is not thread safe.
+    void prefault() noexcept;
+
+    /// Returns memory holding no audio to the operating system.
+    ///
+    /// Whole pages of each channel buffer lying in the free region, excluding the `keepFrames` audio frames following
+    /// the write position, are released with `madvise`. Released pages are faulted back in, zero-filled or with their
+    /// previous contents, when next written.
+    /// @note This method is only safe to call from the producer.
+    /// @param keepFrames The number of audio frames following the write position to keep resident.
+    /// @return The number of bytes released.
+    SizeType reclaimFreeSpace(SizeType keepFrames = 0) noexcept;
+
     /// Returns true if the buffer has allocated space for audio data.
     [[nodiscard]] explicit operator bool() const noexcept;
 
@@ -143,6 +170,39 @@ class AudioRingBuffer final {
     /// @return The number of audio frames actually read.
     SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
 
+    // MARK: Zero-Copy Access
+
+    /// Returns the channel buffer for a channel.
+    ///
+    /// The audio frames of a ``Region`` begin at `Region::index` and, if the region wraps, continue at the start of the
+    /// channel buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @param channel The channel index.
+    /// @return The channel buffer.
+    [[nodiscard]] void *_Nonnull channelBuffer(UInt32 channel) const noexcept;
+
+    /// Returns the free space to which up to frameCount audio frames may be written in place.
+    /// @note This method is only safe to call from the producer.
+    /// @param frameCount The desired number of audio frames.
+    /// @return A region holding no more than frameCount audio frames.
+    [[nodiscard]] Region reserveWrite(SizeType frameCount) const noexcept;
+
+    /// Advances the write position past audio written in place.
+    /// @note This method is only safe to call from the producer.
+    /// @param frameCount The number of audio frames written, which must not exceed the size of the reserved region.
+    void commitWrite(SizeType frameCount) noexcept;
+
+    /// Returns the audio from which up to frameCount audio frames may be read in place.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames.
+    /// @return A region holding no more than frameCount audio frames.
+    [[nodiscard]] Region reserveRead(SizeType frameCount) const noexcept;
+
+    /// Advances the read position past audio read in place.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The number of audio frames read, which must not exceed the size of the reserved region.
+    void commitRead(SizeType frameCount) noexcept;
+
     // MARK: Discarding Audio
 
     /// Skips audio and advances the read position.
@@ -156,24 +216,52 @@ class AudioRingBuffer final {
     /// @return The number of audio frames discarded.
     SizeType drain() noexcept;
 
+    // MARK: Monitoring
+
+    /// Returns the free-running write position.
+    /// @note This method is safe to call from any thread, but the result may be stale except on the producer.
+    [[nodiscard]] SizeType writePosition() const noexcept;
+
+    /// Returns the free-running read position.
+    /// @note This method is safe to call from any thread, but the result may be stale except on the consumer.
+    [[nodiscard]] SizeType readPosition() const noexcept;
+
+    /// Returns the number of calls to ``read`` that returned fewer audio frames than requested.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] SizeType underrunCount() const noexcept;
+
+    /// Returns the number of calls to ``write`` that wrote fewer audio frames than requested.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] SizeType overrunCount() const noexcept;
+
+    /// Starts or stops recording the cost of each phase of ``write`` and ``read``.
+    /// @note This method is safe to call from any thread, but histograms must outlive any call to ``write`` or
+    /// ``read`` that may have observed them.
+    /// @param histograms The histograms receiving the costs, or nullptr to stop recording.
+    void setCostHistograms(AudioRingBufferCostHistograms *_Nullable histograms) noexcept;
+
+    /// Returns the histograms receiving the cost of each phase of ``write`` and ``read``, or nullptr if none.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] AudioRingBufferCostHistograms *_Nullable costHistograms() const noexcept;
+
   private:
     /// The memory buffers holding the data, consisting of channel pointers and buffers allocated in one chunk.
     void *_Nonnull *_Nullable buffers_{nullptr};
+    /// The size of the allocation pointed to by ``buffers_`` in bytes.
+    SizeType allocationSize_{0};
 
-    /// The per-channel capacity of ``buffers_`` in audio frames.
-    SizeType capacity_{0};
-    /// The per-channel capacity of ``buffers_`` in audio frames minus one.
-    SizeType capacityMask_{0};
-
-    /// The free-running write location.
-    AtomicSizeType writePosition_{0};
-    /// The free-running read location.
-    AtomicSizeType readPosition_{0};
-
-    static_assert(AtomicSizeType::is_always_lock_free, "Lock-free AtomicSizeType required");
+    /// The capacity, write position, and read position of ``buffers_`` in audio frames.
+    detail::RingBufferIndex index_;
 
     /// The format of the audio this buffer contains.
     AudioStreamBasicDescription format_{};
+
+    /// The number of short reads, written only by the consumer.
+    AtomicSizeType underrunCount_{0};
+    /// The number of short writes, written only by the producer.
+    AtomicSizeType overrunCount_{0};
+    /// The histograms receiving the cost of each phase of ``write`` and ``read``, or nullptr.
+    std::atomic<AudioRingBufferCostHistograms *> costHistograms_{nullptr};
 };
 
 // MARK: - Implementation -
@@ -186,49 +274,39 @@ inline AudioRingBuffer::operator bool() const noexcept { return buffers_ != null
 
 inline const AudioStreamBasicDescription &AudioRingBuffer::format() const noexcept { return format_; }
 
-inline auto AudioRingBuffer::capacity() const noexcept -> SizeType { return capacity_; }
+inline auto AudioRingBuffer::capacity() const noexcept -> SizeType { return index_.capacity(); }
 
 // MARK: Buffer Usage
 
-inline auto AudioRingBuffer::freeSpace() const noexcept -> SizeType {
-    const auto writePos = writePosition_.load(std::memory_order_relaxed);
-    const auto readPos = readPosition_.load(std::memory_order_acquire);
-    return capacity_ - (writePos - readPos);
-}
+inline auto AudioRingBuffer::freeSpace() const noexcept -> SizeType { return index_.freeSpace(); }
 
-inline bool AudioRingBuffer::isFull() const noexcept {
-    const auto writePos = writePosition_.load(std::memory_order_relaxed);
-    const auto readPos = readPosition_.load(std::memory_order_acquire);
-    return (writePos - readPos) == capacity_;
-}
+inline bool AudioRingBuffer::isFull() const noexcept { return index_.freeSpace() == 0; }
 
-inline auto AudioRingBuffer::availableFrames() const noexcept -> SizeType {
-    const auto writePos = writePosition_.load(std::memory_order_acquire);
-    const auto readPos = readPosition_.load(std::memory_order_relaxed);
-    return writePos - readPos;
-}
+inline auto AudioRingBuffer::availableFrames() const noexcept -> SizeType { return index_.availableElements(); }
 
-inline bool AudioRingBuffer::isEmpty() const noexcept {
-    const auto writePos = writePosition_.load(std::memory_order_acquire);
-    const auto readPos = readPosition_.load(std::memory_order_relaxed);
-    return writePos == readPos;
-}
+inline bool AudioRingBuffer::isEmpty() const noexcept { return index_.availableElements() == 0; }
 
 // MARK: Writing and Reading Audio
 
 inline auto AudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
         -> SizeType {
-    if (bufferList == nullptr || frameCount == 0 || capacity_ == 0) [[unlikely]] {
+    if (bufferList == nullptr || frameCount == 0 || buffers_ == nullptr) [[unlikely]] {
         return 0;
     }
 
-    const auto writePos = writePosition_.load(std::memory_order_relaxed);
-    const auto readPos = readPosition_.load(std::memory_order_acquire);
-    const auto framesUsed = writePos - readPos;
-    const auto framesFree = capacity_ - framesUsed;
-
-    if (framesFree == 0) [[unlikely]] {
-        return 0;
+    using Phase = AudioRingBufferCostPhase;
+    detail::CostTimer timer{costHistograms_.load(std::memory_order_relaxed)};
+
+    const auto region = index_.reserveWrite(frameCount);
+    timer.mark(Phase::writeReserve);
+    if (region.count() != frameCount) [[unlikely]] {
+        // Only the producer writes the counter, so it need not be read-modify-write
+        overrunCount_.store(overrunCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (region.count() == 0) {
+            SPSC_PROBE5(overrun, this, frameCount, 0, index_.writePosition(), index_.readPosition());
+            SPSC_PROBE5(write, this, frameCount, 0, index_.writePosition(), index_.readPosition());
+            return 0;
+        }
     }
 
     /// Copies non-interleaved audio to a buffer array from an AudioBufferList struct.
@@ -242,38 +320,45 @@ inline auto AudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferL
         }
     };
 
-    const auto framesToWrite = std::min(framesFree, frameCount);
-    const auto writeIndex = writePos & capacityMask_;
-    const auto framesToEnd = capacity_ - writeIndex;
-
-    if (framesToWrite <= framesToEnd) [[likely]] {
-        copyToBuffersFromAudioBufferList(buffers_, writeIndex * format_.mBytesPerFrame, bufferList, 0,
-                                         framesToWrite * format_.mBytesPerFrame);
-    } else [[unlikely]] {
-        const auto bytesToEnd = framesToEnd * format_.mBytesPerFrame;
-        copyToBuffersFromAudioBufferList(buffers_, writeIndex * format_.mBytesPerFrame, bufferList, 0, bytesToEnd);
+    const auto bytesToEnd = region.firstCount * format_.mBytesPerFrame;
+    copyToBuffersFromAudioBufferList(buffers_, region.index * format_.mBytesPerFrame, bufferList, 0, bytesToEnd);
+    if (region.secondCount != 0) [[unlikely]] {
         copyToBuffersFromAudioBufferList(buffers_, 0, bufferList, bytesToEnd,
-                                         (framesToWrite - framesToEnd) * format_.mBytesPerFrame);
+                                         region.secondCount * format_.mBytesPerFrame);
     }
+    timer.mark(Phase::writeCopy);
 
-    writePosition_.store(writePos + framesToWrite, std::memory_order_release);
-    return framesToWrite;
+    index_.commitWrite(region.count());
+    timer.mark(Phase::writeCommit);
+    if (region.count() != frameCount) [[unlikely]] {
+        SPSC_PROBE5(overrun, this, frameCount, region.count(), index_.writePosition(), index_.readPosition());
+    }
+    SPSC_PROBE5(write, this, frameCount, region.count(), index_.writePosition(), index_.readPosition());
+    return region.count();
 }
 
 inline auto AudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
         -> SizeType {
-    if (bufferList == nullptr || frameCount == 0 || capacity_ == 0) [[unlikely]] {
+    if (bufferList == nullptr || frameCount == 0 || buffers_ == nullptr) [[unlikely]] {
         return 0;
     }
 
-    const auto writePos = writePosition_.load(std::memory_order_acquire);
-    const auto readPos = readPosition_.load(std::memory_order_relaxed);
-    const auto framesAvailable = writePos - readPos;
+    using Phase = AudioRingBufferCostPhase;
+    detail::CostTimer timer{costHistograms_.load(std::memory_order_relaxed)};
 
-    if (framesAvailable == 0) [[unlikely]] {
+    const auto region = index_.reserveRead(frameCount);
+    timer.mark(Phase::readReserve);
+    if (region.count() != frameCount) [[unlikely]] {
+        // Only the consumer writes the counter, so it need not be read-modify-write
+        underrunCount_.store(underrunCount_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    if (region.count() == 0) [[unlikely]] {
         for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
             std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
         }
+        timer.mark(Phase::readSilence);
+        SPSC_PROBE5(underrun, this, frameCount, 0, index_.writePosition(), index_.readPosition());
+        SPSC_PROBE5(read, this, frameCount, 0, index_.writePosition(), index_.readPosition());
         return 0;
     }
 
@@ -288,21 +373,21 @@ inline auto AudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, Si
         }
     };
 
-    const auto framesToRead = std::min(framesAvailable, frameCount);
-    const auto readIndex = readPos & capacityMask_;
-    const auto framesToEnd = capacity_ - readIndex;
-
-    if (framesToRead <= framesToEnd) [[likely]] {
-        copyToAudioBufferListFromBuffers(bufferList, 0, buffers_, readIndex * format_.mBytesPerFrame,
-                                         framesToRead * format_.mBytesPerFrame);
-    } else [[unlikely]] {
-        const auto bytesToEnd = framesToEnd * format_.mBytesPerFrame;
-        copyToAudioBufferListFromBuffers(bufferList, 0, buffers_, readIndex * format_.mBytesPerFrame, bytesToEnd);
+    const auto framesToRead = region.count();
+    const auto bytesToEnd = region.firstCount * format_.mBytesPerFrame;
+    copyToAudioBufferListFromBuffers(bufferList, 0, buffers_, region.index * format_.mBytesPerFrame, bytesToEnd);
+    if (region.secondCount != 0) [[unlikely]] {
         copyToAudioBufferListFromBuffers(bufferList, bytesToEnd, buffers_, 0,
-                                         (framesToRead - framesToEnd) * format_.mBytesPerFrame);
+                                         region.secondCount * format_.mBytesPerFrame);
     }
+    timer.mark(Phase::readCopy);
 
-    readPosition_.store(readPos + framesToRead, std::memory_order_release);
+    index_.commitRead(framesToRead);
+    timer.mark(Phase::readCommit);
+    if (framesToRead != frameCount) [[unlikely]] {
+        SPSC_PROBE5(underrun, this, frameCount, framesToRead, index_.writePosition(), index_.readPosition());
+    }
+    SPSC_PROBE5(read, this, frameCount, framesToRead, index_.writePosition(), index_.readPosition());
 
     // Fill remainder with silence if fewer than requested frames read
     if (framesToRead != frameCount) {
@@ -312,47 +397,65 @@ inline auto AudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, Si
             assert(byteOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
             std::memset(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + byteOffset, 0, byteCount);
         }
+        timer.mark(Phase::readSilence);
     }
 
     return framesToRead;
 }
 
-// MARK: Discarding Audio
+// MARK: Zero-Copy Access
 
-inline auto AudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
-    if (frameCount == 0 || capacity_ == 0) [[unlikely]] {
-        return 0;
-    }
+inline void *AudioRingBuffer::channelBuffer(UInt32 channel) const noexcept {
+    assert(buffers_ != nullptr && channel < format_.mChannelsPerFrame);
+    return buffers_[channel];
+}
 
-    const auto writePos = writePosition_.load(std::memory_order_acquire);
-    const auto readPos = readPosition_.load(std::memory_order_relaxed);
-    const auto framesAvailable = writePos - readPos;
+inline auto AudioRingBuffer::reserveWrite(SizeType frameCount) const noexcept -> Region {
+    return index_.reserveWrite(frameCount);
+}
 
-    if (framesAvailable == 0) [[unlikely]] {
-        return 0;
-    }
+inline void AudioRingBuffer::commitWrite(SizeType frameCount) noexcept { index_.commitWrite(frameCount); }
 
-    const auto framesToSkip = std::min(framesAvailable, frameCount);
+inline auto AudioRingBuffer::reserveRead(SizeType frameCount) const noexcept -> Region {
+    return index_.reserveRead(frameCount);
+}
 
-    readPosition_.store(readPos + framesToSkip, std::memory_order_release);
-    return framesToSkip;
+inline void AudioRingBuffer::commitRead(SizeType frameCount) noexcept { index_.commitRead(frameCount); }
+
+// MARK: Discarding Audio
+
+inline auto AudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
+    const auto framesSkipped = index_.skip(frameCount);
+    SPSC_PROBE4(skip, this, frameCount, framesSkipped, index_.readPosition());
+    return framesSkipped;
 }
 
 inline auto AudioRingBuffer::drain() noexcept -> SizeType {
-    if (capacity_ == 0) [[unlikely]] {
-        return 0;
-    }
+    const auto framesDiscarded = index_.drain();
+    SPSC_PROBE3(drain, this, framesDiscarded, index_.readPosition());
+    return framesDiscarded;
+}
 
-    const auto writePos = writePosition_.load(std::memory_order_acquire);
-    const auto readPos = readPosition_.load(std::memory_order_relaxed);
-    const auto framesAvailable = writePos - readPos;
+// MARK: Monitoring
 
-    if (framesAvailable == 0) [[unlikely]] {
-        return 0;
-    }
+inline auto AudioRingBuffer::writePosition() const noexcept -> SizeType { return index_.writePosition(); }
+
+inline auto AudioRingBuffer::readPosition() const noexcept -> SizeType { return index_.readPosition(); }
+
+inline auto AudioRingBuffer::underrunCount() const noexcept -> SizeType {
+    return underrunCount_.load(std::memory_order_relaxed);
+}
+
+inline auto AudioRingBuffer::overrunCount() const noexcept -> SizeType {
+    return overrunCount_.load(std::memory_order_relaxed);
+}
+
+inline void AudioRingBuffer::setCostHistograms(AudioRingBufferCostHistograms *_Nullable histograms) noexcept {
+    costHistograms_.store(histograms, std::memory_order_relaxed);
+}
 
-    readPosition_.store(writePos, std::memory_order_release);
-    return framesAvailable;
+inline auto AudioRingBuffer::costHistograms() const noexcept -> AudioRingBufferCostHistograms * {
+    return costHistograms_.load(std::memory_order_relaxed);
 }
 
 } /* namespace spsc */
@@ -0,0 +1,165 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBufferCostTimer.hpp"
+#include "BitOperations.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace spsc {
+
+/// Per-phase histograms of the ticks ``AudioRingBuffer::write`` and ``AudioRingBuffer::read`` spend loading positions,
+/// copying, publishing positions, and filling with silence.
+///
+/// Instrumentation is opt-in per ring: ``AudioRingBuffer::setCostHistograms`` makes each call sample the tick counter
+/// at the boundaries of its phases and add the intervals to these histograms. Without histograms a call pays one
+/// relaxed load and a few not-taken branches.
+///
+/// The histograms are log-linear: values below 8 have a bucket each, and every power-of-two range above is split into
+/// 8 equal buckets, so a bucket is never wider than 1/8 of its lower bound. The producer records the write phases and
+/// the consumer the read phases, each with relaxed stores, so a monitoring thread may read or ``save`` the histograms
+/// at any time.
+class AudioRingBufferCostHistograms final {
+  public:
+    /// A part of a write or read call.
+    using Phase = AudioRingBufferCostPhase;
+
+    /// The number of phases.
+    static constexpr std::size_t phaseCount = 7;
+    /// The number of buckets dividing each power-of-two range.
+    static constexpr std::size_t subBucketCount = 8;
+    /// The number of buckets in each histogram, covering every 64-bit value.
+    static constexpr std::size_t bucketCount = subBucketCount * (64 - 2);
+
+    /// Returns the name of a phase.
+    static const char *_Nonnull name(Phase phase) noexcept;
+
+    /// Returns the bucket holding a value.
+    static constexpr std::size_t bucketIndex(std::uint64_t ticks) noexcept;
+
+    /// Returns the smallest value held by a bucket.
+    static constexpr std::uint64_t bucketLowerBound(std::size_t bucket) noexcept;
+
+    /// Returns the approximate number of ticks per second of the tick counter.
+    ///
+    /// The counter is the time stamp counter on x86, the virtual counter `cntvct_el0` on arm64, and nanoseconds of
+    /// `std::chrono::steady_clock` elsewhere. The read is not serializing, so a single interval may be off by a few
+    /// dozen ticks; aggregated intervals are accurate.
+    /// @note The first call on x86 takes about 10 ms to calibrate the time stamp counter.
+    static double ticksPerSecond() noexcept;
+
+    // MARK: Construction and Destruction
+
+    /// Creates empty histograms.
+    AudioRingBufferCostHistograms() noexcept = default;
+
+    // This class is non-copyable
+    AudioRingBufferCostHistograms(const AudioRingBufferCostHistograms &) = delete;
+
+    /// Creates histograms by moving the contents of other histograms.
+    /// @note This method is not thread safe for the histograms being moved.
+    /// @param other The histograms to move.
+    AudioRingBufferCostHistograms(AudioRingBufferCostHistograms &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferCostHistograms &operator=(const AudioRingBufferCostHistograms &) = delete;
+
+    /// Moves the contents of other histograms into these histograms.
+    /// @note This method is not thread safe.
+    /// @param other The histograms to move.
+    AudioRingBufferCostHistograms &operator=(AudioRingBufferCostHistograms &&other) noexcept;
+
+    /// Destroys the histograms.
+    ~AudioRingBufferCostHistograms() noexcept = default;
+
+    // MARK: Recording
+
+    /// Adds an interval to a phase's histogram.
+    /// @note Write phases may only be recorded by the producer and read phases only by the consumer.
+    void record(Phase phase, std::uint64_t ticks) noexcept;
+
+    /// Empties the histograms.
+    /// @note This method is not thread safe.
+    void reset() noexcept;
+
+    // MARK: Exporting
+
+    /// Returns the number of intervals in a bucket of a phase's histogram.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] std::uint64_t count(Phase phase, std::size_t bucket) const noexcept;
+
+    /// Returns the number of intervals recorded for a phase.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] std::uint64_t totalCount(Phase phase) const noexcept;
+
+    /// Returns the sum of the intervals recorded for a phase.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] std::uint64_t totalTicks(Phase phase) const noexcept;
+
+    /// Returns the lower bound of the bucket holding a percentile of a phase's intervals, or 0 if there are none.
+    /// @note This method is safe to call from any thread.
+    /// @param percentile A value on the interval (0, 100].
+    [[nodiscard]] std::uint64_t percentile(Phase phase, double percentile) const noexcept;
+
+    /// Appends the nonempty buckets to a file as comma-separated `phase,lowerBound,count` lines, with bounds in ticks.
+    /// @note This method is safe to call from any thread.
+    /// @return true on success, false on an I/O error.
+    bool save(std::FILE *_Nonnull file) const noexcept;
+
+  private:
+    /// One phase's histogram.
+    struct Histogram {
+        /// The number of intervals in each bucket.
+        std::atomic<std::uint64_t> counts[bucketCount]{};
+        /// The sum of the intervals.
+        std::atomic<std::uint64_t> ticks{0};
+    };
+
+    /// The histograms, indexed by phase.
+    Histogram histograms_[phaseCount];
+};
+
+// MARK: - Implementation -
+
+constexpr std::size_t AudioRingBufferCostHistograms::bucketIndex(std::uint64_t ticks) noexcept {
+    if (ticks < subBucketCount) {
+        return static_cast<std::size_t>(ticks);
+    }
+    const auto exponent = static_cast<std::size_t>(63 - detail::clz(ticks));
+    return (exponent - 2) * subBucketCount + static_cast<std::size_t>((ticks >> (exponent - 3)) & (subBucketCount - 1));
+}
+
+constexpr std::uint64_t AudioRingBufferCostHistograms::bucketLowerBound(std::size_t bucket) noexcept {
+    if (bucket < subBucketCount) {
+        return bucket;
+    }
+    const auto exponent = bucket / subBucketCount + 2;
+    return (subBucketCount + bucket % subBucketCount) << (exponent - 3);
+}
+
+inline void AudioRingBufferCostHistograms::record(Phase phase, std::uint64_t ticks) noexcept {
+    auto &histogram = histograms_[static_cast<std::size_t>(phase)];
+    auto &count = histogram.counts[bucketIndex(ticks)];
+    // Each phase has a single writer, so the updates need not be read-modify-write
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    histogram.ticks.store(histogram.ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+}
+
+inline auto AudioRingBufferCostHistograms::count(Phase phase, std::size_t bucket) const noexcept -> std::uint64_t {
+    return histograms_[static_cast<std::size_t>(phase)].counts[bucket].load(std::memory_order_relaxed);
+}
+
+inline auto AudioRingBufferCostHistograms::totalTicks(Phase phase) const noexcept -> std::uint64_t {
+    return histograms_[static_cast<std::size_t>(phase)].ticks.load(std::memory_order_relaxed);
+}
+
+} /* namespace spsc */
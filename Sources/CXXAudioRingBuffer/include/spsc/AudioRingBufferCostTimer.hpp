@@ -0,0 +1,78 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace spsc {
+
+class AudioRingBufferCostHistograms;
+
+/// A part of an ``AudioRingBuffer`` write or read call.
+enum class AudioRingBufferCostPhase : std::uint8_t {
+    /// Loading the positions to reserve space for a write.
+    writeReserve,
+    /// Copying audio into the ring.
+    writeCopy,
+    /// Publishing the write position.
+    writeCommit,
+    /// Loading the positions to reserve audio for a read.
+    readReserve,
+    /// Copying audio out of the ring.
+    readCopy,
+    /// Publishing the read position.
+    readCommit,
+    /// Filling the remainder of a short read with silence.
+    readSilence,
+};
+
+namespace detail {
+
+/// Records the ticks between successive marks to ``AudioRingBufferCostHistograms``, or does nothing without them.
+///
+/// Only the check for histograms is inline. The tick counter is read out of line so its platform intrinsics stay out
+/// of this header.
+class CostTimer final {
+  public:
+    /// Creates a timer and samples the tick counter if histograms is not nullptr.
+    explicit CostTimer(AudioRingBufferCostHistograms *_Nullable histograms) noexcept;
+
+    /// Records the ticks since the previous mark as phase.
+    void mark(AudioRingBufferCostPhase phase) noexcept;
+
+  private:
+    /// Returns the value of the tick counter.
+    static std::uint64_t now() noexcept;
+
+    /// Records the ticks since the previous mark as phase and samples the tick counter.
+    void record(AudioRingBufferCostPhase phase) noexcept;
+
+    /// The histograms receiving the intervals.
+    AudioRingBufferCostHistograms *_Nullable histograms_{nullptr};
+    /// The tick count at the previous mark.
+    std::uint64_t ticks_{0};
+};
+
+} /* namespace detail */
+
+// MARK: - Implementation -
+
+inline detail::CostTimer::CostTimer(AudioRingBufferCostHistograms *_Nullable histograms) noexcept
+    : histograms_{histograms} {
+    if (histograms_ != nullptr) [[unlikely]] {
+        ticks_ = now();
+    }
+}
+
+inline void detail::CostTimer::mark(AudioRingBufferCostPhase phase) noexcept {
+    if (histograms_ != nullptr) [[unlikely]] {
+        record(phase);
+    }
+}
+
+} /* namespace spsc */
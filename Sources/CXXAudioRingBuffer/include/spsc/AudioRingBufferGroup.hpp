@@ -0,0 +1,116 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace spsc {
+
+/// Writes the same audio to several ``AudioRingBuffer`` instances, each with its own consumer.
+///
+/// ``writeAll`` reserves space in every member, then copies the source one cache-sized chunk at a time to every member
+/// before moving to the next chunk, so the source is read from memory once regardless of the number of members.
+/// Finally each member's write position is published.
+///
+/// The group acts as the producer of every member. Members must share the same channel count and frame size.
+class AudioRingBufferGroup final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The number of bytes of each channel copied to every member before moving on.
+    static constexpr SizeType chunkByteSize = 4096;
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty group.
+    /// @note ``allocate`` must be called before the object may be used.
+    AudioRingBufferGroup() noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferGroup(const AudioRingBufferGroup &) = delete;
+
+    /// Creates a group by moving the members of another group.
+    /// @note This method must not be called during ``writeAll`` of the group being moved.
+    /// @param other The group to move.
+    AudioRingBufferGroup(AudioRingBufferGroup &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferGroup &operator=(const AudioRingBufferGroup &) = delete;
+
+    /// Moves the members of another group into this group.
+    /// @note This method is not thread safe.
+    /// @param other The group to move.
+    AudioRingBufferGroup &operator=(AudioRingBufferGroup &&other) noexcept;
+
+    /// Destroys the group.
+    ~AudioRingBufferGroup() noexcept;
+
+    // MARK: Group Management
+
+    /// Allocates the member slots.
+    /// @note This method is not thread safe.
+    /// @param maxMemberCount The maximum number of members.
+    /// @return true on success, false if memory could not be allocated.
+    bool allocate(SizeType maxMemberCount) noexcept;
+
+    /// Removes all members and frees the member slots.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the member slots have been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Returns the number of members.
+    [[nodiscard]] SizeType memberCount() const noexcept;
+
+    /// Adds a member.
+    /// @note This method must not be called during ``writeAll``.
+    /// @param ringBuffer The ring buffer to add.
+    /// @return true on success, false if the group is full or the ring buffer's layout differs from the other members.
+    bool add(AudioRingBuffer &ringBuffer) noexcept;
+
+    /// Removes a member.
+    /// @note This method must not be called during ``writeAll``.
+    /// @param ringBuffer The ring buffer to remove.
+    void remove(const AudioRingBuffer &ringBuffer) noexcept;
+
+    // MARK: Writing Audio
+
+    /// Writes audio to every member and advances each member's write position.
+    ///
+    /// Each member receives as many of the frames as it has space for.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The smallest number of audio frames written to any member.
+    SizeType writeAll(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+  private:
+    /// A member slot.
+    struct Member;
+
+    /// The member slots, of which the first ``memberCount_`` are occupied.
+    std::unique_ptr<Member[]> members_;
+    /// The number of member slots.
+    SizeType maxMemberCount_{0};
+    /// The number of members.
+    SizeType memberCount_{0};
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferGroup::operator bool() const noexcept { return members_ != nullptr; }
+
+inline auto AudioRingBufferGroup::memberCount() const noexcept -> SizeType { return memberCount_; }
+
+} /* namespace spsc */
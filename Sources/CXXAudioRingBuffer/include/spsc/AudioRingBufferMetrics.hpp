@@ -0,0 +1,270 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace spsc {
+
+/// A point-in-time copy of one ring's metrics.
+struct AudioRingBufferMetricsSnapshot {
+    /// The label given when the ring was registered.
+    char label[32]{};
+    /// The capacity in audio frames.
+    std::uint64_t capacity{0};
+    /// The free-running write position.
+    std::uint64_t writePosition{0};
+    /// The free-running read position.
+    std::uint64_t readPosition{0};
+    /// The smallest fill level sampled, in audio frames.
+    std::uint64_t minFill{0};
+    /// The largest fill level sampled, in audio frames.
+    std::uint64_t maxFill{0};
+    /// The sum of the fill levels sampled, in audio frames.
+    std::uint64_t fillSum{0};
+    /// The number of fill levels sampled.
+    std::uint64_t sampleCount{0};
+    /// The number of short reads.
+    std::uint64_t underrunCount{0};
+    /// The number of short writes.
+    std::uint64_t overrunCount{0};
+    /// The sample rate.
+    double sampleRate{0};
+    /// The format ID.
+    std::uint32_t formatID{0};
+    /// The format flags.
+    std::uint32_t formatFlags{0};
+    /// The bytes per audio frame in each channel buffer.
+    std::uint32_t bytesPerFrame{0};
+    /// The number of channels.
+    std::uint32_t channelsPerFrame{0};
+    /// The bits per channel.
+    std::uint32_t bitsPerChannel{0};
+};
+
+/// The fixed layout of one ring's metrics in shared memory.
+///
+/// Slots are updated under a sequence lock: the sequence number is odd while the publisher writes, so a reader in
+/// another process retries if the number was odd or changed while it copied the fields.
+struct AudioRingBufferMetricsSlot {
+    /// The sequence number, odd while the slot is being written.
+    std::atomic<std::uint32_t> sequence;
+    /// Nonzero while the slot describes a ring.
+    std::atomic<std::uint32_t> inUse;
+    /// The label given when the ring was registered.
+    std::atomic<char> label[32];
+    /// The capacity in audio frames.
+    std::atomic<std::uint64_t> capacity;
+    /// The free-running write position.
+    std::atomic<std::uint64_t> writePosition;
+    /// The free-running read position.
+    std::atomic<std::uint64_t> readPosition;
+    /// The smallest fill level sampled.
+    std::atomic<std::uint64_t> minFill;
+    /// The largest fill level sampled.
+    std::atomic<std::uint64_t> maxFill;
+    /// The sum of the fill levels sampled.
+    std::atomic<std::uint64_t> fillSum;
+    /// The number of fill levels sampled.
+    std::atomic<std::uint64_t> sampleCount;
+    /// The number of short reads.
+    std::atomic<std::uint64_t> underrunCount;
+    /// The number of short writes.
+    std::atomic<std::uint64_t> overrunCount;
+    /// The bit pattern of the sample rate.
+    std::atomic<std::uint64_t> sampleRateBits;
+    /// The format ID.
+    std::atomic<std::uint32_t> formatID;
+    /// The format flags.
+    std::atomic<std::uint32_t> formatFlags;
+    /// The bytes per audio frame in each channel buffer.
+    std::atomic<std::uint32_t> bytesPerFrame;
+    /// The number of channels.
+    std::atomic<std::uint32_t> channelsPerFrame;
+    /// The bits per channel.
+    std::atomic<std::uint32_t> bitsPerChannel;
+
+    /// Copies the slot.
+    /// @return true on success, false if the slot is unused or was updated too often to obtain a consistent copy.
+    bool read(AudioRingBufferMetricsSnapshot &snapshot) const noexcept;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Lock-free 64-bit atomics required");
+};
+
+/// The fixed layout of a shared-memory metrics page.
+struct AudioRingBufferMetricsPage {
+    /// The value of ``magic`` in a valid page.
+    static constexpr std::uint32_t magicValue = 0x53505243; // 'SPRC'
+    /// The layout version.
+    static constexpr std::uint32_t currentVersion = 1;
+    /// The number of slots.
+    static constexpr std::size_t slotCount = 64;
+
+    /// ``magicValue`` once the page is initialized.
+    std::atomic<std::uint32_t> magic;
+    /// The layout version.
+    std::atomic<std::uint32_t> version;
+    /// The ID of the publishing process.
+    std::atomic<std::uint32_t> processID;
+    /// The interval between updates in milliseconds.
+    std::atomic<std::uint32_t> updateInterval;
+    /// The number of updates published.
+    std::atomic<std::uint64_t> updateCount;
+    /// The slots.
+    AudioRingBufferMetricsSlot slots[slotCount];
+};
+
+/// Publishes the metrics of registered ``AudioRingBuffer`` instances to a shared-memory page.
+///
+/// A publisher thread samples each registered ring at a fixed interval, reading its positions and counters with
+/// relaxed loads, and copies them with its format and fill statistics into the ring's slot of a POSIX shared-memory
+/// page. The audio threads do no additional work, so monitoring has no effect on them. Another process maps the page
+/// read-only with ``AudioRingBufferMetricsReader``, as the `ringtop` tool does.
+class AudioRingBufferMetricsRegistry final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The default interval between updates.
+    static constexpr std::chrono::milliseconds defaultUpdateInterval = std::chrono::milliseconds{100};
+
+    /// Writes the default shared-memory object name for a process, `/spsc-metrics.<pid>`, to name.
+    /// @return true on success, false if size is too small.
+    static bool defaultName(int processID, char *_Nonnull name, std::size_t size) noexcept;
+
+    // MARK: Construction and Destruction
+
+    /// Creates a closed registry.
+    AudioRingBufferMetricsRegistry() noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferMetricsRegistry(const AudioRingBufferMetricsRegistry &) = delete;
+
+    /// Creates a registry by moving the contents of another registry.
+    ///
+    /// A running publisher thread continues with this registry.
+    /// @note This method is not thread safe for the registry being moved.
+    /// @param other The registry to move.
+    AudioRingBufferMetricsRegistry(AudioRingBufferMetricsRegistry &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferMetricsRegistry &operator=(const AudioRingBufferMetricsRegistry &) = delete;
+
+    /// Moves the contents of another registry into this registry.
+    /// @note This method is not thread safe.
+    /// @param other The registry to move.
+    AudioRingBufferMetricsRegistry &operator=(AudioRingBufferMetricsRegistry &&other) noexcept;
+
+    /// Closes the registry.
+    ~AudioRingBufferMetricsRegistry() noexcept;
+
+    // MARK: Registry Management
+
+    /// Creates the shared-memory page and starts the publisher thread.
+    /// @param name The shared-memory object name, or nullptr for ``defaultName`` of the calling process.
+    /// @param updateInterval The interval between updates.
+    /// @return true on success, false if the registry is already open or the page or thread could not be created.
+    bool open(const char *_Nullable name = nullptr,
+              std::chrono::milliseconds updateInterval = defaultUpdateInterval) noexcept;
+
+    /// Stops the publisher thread and removes the shared-memory page.
+    void close() noexcept;
+
+    /// Returns true if the registry is open.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Starts publishing a ring's metrics.
+    /// @note The ring must be removed before it is destroyed or reallocated.
+    /// @param ringBuffer The ring buffer.
+    /// @param label A label identifying the ring, truncated to 31 characters.
+    /// @return The slot index or ``SizeType(-1)`` if the registry is closed or full.
+    SizeType add(const AudioRingBuffer &ringBuffer, const char *_Nonnull label) noexcept;
+
+    /// Stops publishing a ring's metrics.
+    /// @param slot The slot index returned by ``add``.
+    void remove(SizeType slot) noexcept;
+
+  private:
+    /// The publisher thread and its state.
+    struct Publisher;
+
+    /// The publisher while open.
+    std::unique_ptr<Publisher> publisher_;
+};
+
+/// Maps another process's metrics page read-only.
+class AudioRingBufferMetricsReader final {
+  public:
+    /// Creates a closed reader.
+    AudioRingBufferMetricsReader() noexcept = default;
+
+    // This class is non-copyable
+    AudioRingBufferMetricsReader(const AudioRingBufferMetricsReader &) = delete;
+
+    /// Creates a reader by moving the contents of another reader.
+    /// @note This method is not thread safe for the reader being moved.
+    /// @param other The reader to move.
+    AudioRingBufferMetricsReader(AudioRingBufferMetricsReader &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferMetricsReader &operator=(const AudioRingBufferMetricsReader &) = delete;
+
+    /// Moves the contents of another reader into this reader.
+    /// @note This method is not thread safe.
+    /// @param other The reader to move.
+    AudioRingBufferMetricsReader &operator=(AudioRingBufferMetricsReader &&other) noexcept;
+
+    /// Unmaps the page.
+    ~AudioRingBufferMetricsReader() noexcept;
+
+    /// Maps a metrics page.
+    /// @param name The shared-memory object name.
+    /// @return true on success, false if the page does not exist or is not a compatible metrics page.
+    bool open(const char *_Nonnull name) noexcept;
+
+    /// Unmaps the page.
+    void close() noexcept;
+
+    /// Returns the mapped page, or nullptr if the reader is closed.
+    [[nodiscard]] const AudioRingBufferMetricsPage *_Nullable page() const noexcept;
+
+    /// Copies a slot of the mapped page.
+    /// @param slot The slot index.
+    /// @param snapshot The destination of the copy.
+    /// @return true on success, false if the reader is closed, the slot is out of range or unused, or a consistent copy
+    /// could not be obtained.
+    bool read(std::size_t slot, AudioRingBufferMetricsSnapshot &snapshot) const noexcept;
+
+  private:
+    /// The mapped page.
+    const AudioRingBufferMetricsPage *_Nullable page_{nullptr};
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferMetricsRegistry::operator bool() const noexcept { return publisher_ != nullptr; }
+
+inline auto AudioRingBufferMetricsReader::page() const noexcept -> const AudioRingBufferMetricsPage * {
+    return page_;
+}
+
+inline bool AudioRingBufferMetricsReader::read(std::size_t slot,
+                                               AudioRingBufferMetricsSnapshot &snapshot) const noexcept {
+    if (page_ == nullptr || slot >= AudioRingBufferMetricsPage::slotCount) [[unlikely]] {
+        return false;
+    }
+    return page_->slots[slot].read(snapshot);
+}
+
+} /* namespace spsc */
@@ -0,0 +1,141 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace spsc {
+
+/// Mixes many ``AudioRingBuffer`` streams of 32-bit float audio into one output.
+///
+/// ``mix`` acts as the consumer of every attached ring buffer. It reads the available audio of each stream in place
+/// from the channel buffers, scales it by the stream's gain, and accumulates it into the output one tile of
+/// ``tileFrameCount`` audio frames at a time so the tile stays in cache while every stream is added to it. A stream
+/// holding fewer frames than requested contributes what it has and records an underrun.
+///
+/// Streams are attached to numbered slots. Gains and underrun counts may be accessed from any thread; attaching and
+/// detaching streams must not happen during ``mix``.
+class AudioRingBufferMixer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The number of audio frames accumulated for every stream before moving to the next part of the output.
+    static constexpr SizeType tileFrameCount = 256;
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty mixer.
+    /// @note ``allocate`` must be called before the object may be used.
+    AudioRingBufferMixer() noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferMixer(const AudioRingBufferMixer &) = delete;
+
+    /// Creates a mixer by moving the streams of another mixer.
+    /// @note This method must not be called during ``mix`` of the mixer being moved.
+    /// @param other The mixer to move.
+    AudioRingBufferMixer(AudioRingBufferMixer &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferMixer &operator=(const AudioRingBufferMixer &) = delete;
+
+    /// Moves the streams of another mixer into this mixer.
+    /// @note This method is not thread safe.
+    /// @param other The mixer to move.
+    AudioRingBufferMixer &operator=(AudioRingBufferMixer &&other) noexcept;
+
+    /// Destroys the mixer.
+    ~AudioRingBufferMixer() noexcept;
+
+    // MARK: Mixer Management
+
+    /// Allocates the stream slots.
+    /// @note This method is not thread safe.
+    /// @param maxStreamCount The number of stream slots.
+    /// @return true on success, false if memory could not be allocated.
+    bool allocate(SizeType maxStreamCount) noexcept;
+
+    /// Detaches all streams and frees the stream slots.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the stream slots have been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Returns the number of stream slots.
+    [[nodiscard]] SizeType maxStreamCount() const noexcept;
+
+    // MARK: Streams
+
+    /// Attaches a ring buffer of non-interleaved 32-bit float audio to a free slot.
+    ///
+    /// The mixer becomes the ring buffer's consumer.
+    /// @note This method must not be called during ``mix``.
+    /// @param ringBuffer The ring buffer to mix.
+    /// @param gain The linear gain applied to the stream.
+    /// @return The slot index or ``maxStreamCount`` if no slot is free or the format is not 32-bit float.
+    SizeType attach(AudioRingBuffer &ringBuffer, float gain = 1) noexcept;
+
+    /// Detaches the stream in a slot.
+    /// @note This method must not be called during ``mix``.
+    /// @param slot The slot index.
+    void detach(SizeType slot) noexcept;
+
+    /// Sets the gain of a stream.
+    /// @note This method is safe to call from any thread.
+    /// @param slot The slot index.
+    /// @param gain The linear gain applied to the stream.
+    void setGain(SizeType slot, float gain) noexcept;
+
+    /// Returns the gain of a stream.
+    /// @note This method is safe to call from any thread.
+    /// @param slot The slot index.
+    [[nodiscard]] float gain(SizeType slot) const noexcept;
+
+    /// Returns the number of calls to ``mix`` in which a stream held fewer frames than requested.
+    /// @note This method is safe to call from any thread.
+    /// @param slot The slot index.
+    [[nodiscard]] SizeType underrunCount(SizeType slot) const noexcept;
+
+    // MARK: Mixing
+
+    /// Reads up to frameCount audio frames from every attached stream and sums them into bufferList.
+    ///
+    /// Channels beyond those of a stream receive nothing from it, and stream channels beyond those of bufferList are
+    /// discarded. Output frames no stream reaches are set to zero.
+    /// @param bufferList An audio buffer list of non-interleaved 32-bit float audio to receive the mix.
+    /// @param frameCount The number of audio frames to mix.
+    /// @return The number of streams that contributed audio.
+    SizeType mix(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+  private:
+    /// A stream slot.
+    struct Stream;
+
+    /// The stream slots.
+    std::unique_ptr<Stream[]> streams_;
+    /// The number of stream slots.
+    SizeType maxStreamCount_{0};
+    /// One more than the highest occupied slot index.
+    SizeType streamLimit_{0};
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferMixer::operator bool() const noexcept { return streams_ != nullptr; }
+
+inline auto AudioRingBufferMixer::maxStreamCount() const noexcept -> SizeType { return maxStreamCount_; }
+
+} /* namespace spsc */
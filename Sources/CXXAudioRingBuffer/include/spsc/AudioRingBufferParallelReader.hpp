@@ -0,0 +1,139 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+#include "ChannelGroupCountdown.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace spsc {
+
+/// Lets several threads read disjoint channel groups of an ``AudioRingBuffer`` in parallel.
+///
+/// One thread calls ``begin`` to select a frame range and hands the range to the workers. Each worker reads its
+/// channels directly from the ring buffer, either in place through ``AudioRingBuffer::channelBuffer`` or with
+/// ``readChannels``, and then calls ``commit``. The worker that commits last releases the frames to the producer, so no
+/// thread has to read every channel and redistribute it.
+///
+/// The threads taken together act as the ring buffer's consumer: nothing else may read from it while a reader is in
+/// use. The range returned by ``begin`` must be passed to the workers through a mechanism that synchronizes, such as a
+/// task queue or a semaphore.
+class AudioRingBufferParallelReader final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+    /// A range of audio frames in the channel buffers.
+    using Region = AudioRingBuffer::Region;
+
+    /// Creates a reader.
+    /// @param ringBuffer The ring buffer to read.
+    /// @param groupCount The number of channel groups that must commit before frames are released.
+    AudioRingBufferParallelReader(AudioRingBuffer &ringBuffer, UInt32 groupCount) noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferParallelReader(const AudioRingBufferParallelReader &) = delete;
+
+    /// Creates a reader by moving the state of another reader.
+    ///
+    /// The new reader uses the same ring buffer, and a region in flight continues with it.
+    /// @note This method is not thread safe for the reader being moved.
+    /// @param other The reader to move.
+    AudioRingBufferParallelReader(AudioRingBufferParallelReader &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferParallelReader &operator=(const AudioRingBufferParallelReader &) = delete;
+
+    // This class is non-move-assignable
+    AudioRingBufferParallelReader &operator=(AudioRingBufferParallelReader &&) = delete;
+
+    /// Selects up to frameCount audio frames for the channel groups to read.
+    /// @param frameCount The desired number of audio frames.
+    /// @return The selected region, which is empty if the buffer is empty or the previous region has not been committed
+    /// by every group.
+    Region begin(SizeType frameCount) noexcept;
+
+    /// Returns true if a region has been selected and not yet committed by every group.
+    [[nodiscard]] bool inFlight() const noexcept;
+
+    /// Copies a channel group out of a selected region.
+    /// @param region The region returned by ``begin``.
+    /// @param bufferList An audio buffer list with one buffer per channel in the group to receive the data.
+    /// @param firstChannel The ring buffer channel corresponding to the first buffer in bufferList.
+    void readChannels(const Region &region, AudioBufferList *const _Nonnull bufferList,
+                      UInt32 firstChannel) const noexcept;
+
+    /// Marks one channel group as read.
+    ///
+    /// When the last group commits the selected frames are released to the producer and ``begin`` may be called again.
+    /// @note Each channel group must call this method exactly once per ``begin``. A missing call leaves the region in
+    /// flight, and an extra call would finish the region before every group is done.
+    /// @return true if this call released the frames.
+    bool commit() noexcept;
+
+  private:
+    /// The ring buffer being read.
+    AudioRingBuffer &ringBuffer_;
+    /// The in-flight region and the channel groups yet to commit it.
+    detail::ChannelGroupCountdown countdown_;
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferParallelReader::AudioRingBufferParallelReader(AudioRingBuffer &ringBuffer,
+                                                                    UInt32 groupCount) noexcept
+    : ringBuffer_{ringBuffer}, countdown_{groupCount} {}
+
+inline AudioRingBufferParallelReader::AudioRingBufferParallelReader(AudioRingBufferParallelReader &&other) noexcept
+    : ringBuffer_{other.ringBuffer_}, countdown_{std::move(other.countdown_)} {}
+
+inline auto AudioRingBufferParallelReader::begin(SizeType frameCount) noexcept -> Region {
+    if (countdown_.inFlight()) [[unlikely]] {
+        return {};
+    }
+
+    const auto region = ringBuffer_.reserveRead(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        return {};
+    }
+
+    countdown_.start(region.count());
+    return region;
+}
+
+inline bool AudioRingBufferParallelReader::inFlight() const noexcept {
+    return countdown_.inFlight();
+}
+
+inline void AudioRingBufferParallelReader::readChannels(const Region &region, AudioBufferList *const _Nonnull bufferList,
+                                                        UInt32 firstChannel) const noexcept {
+    const auto bytesPerFrame = ringBuffer_.format().mBytesPerFrame;
+    const auto bytesToEnd = region.firstCount * bytesPerFrame;
+    const auto bytesAfterWrap = region.secondCount * bytesPerFrame;
+
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+        assert(firstChannel + i < ringBuffer_.format().mChannelsPerFrame);
+        assert(bytesToEnd + bytesAfterWrap <= bufferList->mBuffers[i].mDataByteSize);
+        const auto src = static_cast<const unsigned char *>(ringBuffer_.channelBuffer(firstChannel + i));
+        const auto dst = static_cast<unsigned char *>(bufferList->mBuffers[i].mData);
+        std::memcpy(dst, src + region.index * bytesPerFrame, bytesToEnd);
+        if (bytesAfterWrap != 0) [[unlikely]] {
+            std::memcpy(dst + bytesToEnd, src, bytesAfterWrap);
+        }
+    }
+}
+
+inline bool AudioRingBufferParallelReader::commit() noexcept {
+    return countdown_.finish([this](SizeType frameCount) noexcept { ringBuffer_.commitRead(frameCount); });
+}
+
+} /* namespace spsc */
@@ -0,0 +1,140 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+#include "ChannelGroupCountdown.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace spsc {
+
+/// Lets several threads write disjoint channel groups of an ``AudioRingBuffer`` in parallel.
+///
+/// One thread calls ``begin`` to reserve a frame range and hands the range to the workers. Each worker writes its
+/// channels directly into the ring buffer, either in place through ``AudioRingBuffer::channelBuffer`` or with
+/// ``writeChannels``, and then calls ``commit``. The worker that commits last publishes the frames to the consumer, so
+/// no thread has to gather the channels into a single `AudioBufferList`.
+///
+/// The threads taken together act as the ring buffer's producer: nothing else may write to it while a writer is in use.
+/// The range returned by ``begin`` must be passed to the workers through a mechanism that synchronizes, such as a task
+/// queue or a semaphore.
+class AudioRingBufferParallelWriter final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+    /// A range of audio frames in the channel buffers.
+    using Region = AudioRingBuffer::Region;
+
+    /// Creates a writer.
+    /// @param ringBuffer The ring buffer to write.
+    /// @param groupCount The number of channel groups that must commit before frames are published.
+    AudioRingBufferParallelWriter(AudioRingBuffer &ringBuffer, UInt32 groupCount) noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferParallelWriter(const AudioRingBufferParallelWriter &) = delete;
+
+    /// Creates a writer by moving the state of another writer.
+    ///
+    /// The new writer uses the same ring buffer, and a region in flight continues with it.
+    /// @note This method is not thread safe for the writer being moved.
+    /// @param other The writer to move.
+    AudioRingBufferParallelWriter(AudioRingBufferParallelWriter &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferParallelWriter &operator=(const AudioRingBufferParallelWriter &) = delete;
+
+    // This class is non-move-assignable
+    AudioRingBufferParallelWriter &operator=(AudioRingBufferParallelWriter &&) = delete;
+
+    /// Reserves up to frameCount audio frames for the channel groups to write.
+    /// @param frameCount The desired number of audio frames.
+    /// @return The reserved region, which is empty if the buffer is full or the previous region has not been committed
+    /// by every group.
+    Region begin(SizeType frameCount) noexcept;
+
+    /// Returns true if a region has been reserved and not yet committed by every group.
+    [[nodiscard]] bool inFlight() const noexcept;
+
+    /// Copies a channel group into a reserved region.
+    /// @param region The region returned by ``begin``.
+    /// @param bufferList An audio buffer list holding one buffer per channel in the group.
+    /// @param firstChannel The ring buffer channel corresponding to the first buffer in bufferList.
+    void writeChannels(const Region &region, const AudioBufferList *const _Nonnull bufferList,
+                       UInt32 firstChannel) const noexcept;
+
+    /// Marks one channel group as written.
+    ///
+    /// When the last group commits the reserved frames are published to the consumer and ``begin`` may be called again.
+    /// @note Each channel group must call this method exactly once per ``begin``. A missing call leaves the region in
+    /// flight, and an extra call would finish the region before every group is done.
+    /// @return true if this call published the frames.
+    bool commit() noexcept;
+
+  private:
+    /// The ring buffer being written.
+    AudioRingBuffer &ringBuffer_;
+    /// The in-flight region and the channel groups yet to commit it.
+    detail::ChannelGroupCountdown countdown_;
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferParallelWriter::AudioRingBufferParallelWriter(AudioRingBuffer &ringBuffer,
+                                                                    UInt32 groupCount) noexcept
+    : ringBuffer_{ringBuffer}, countdown_{groupCount} {}
+
+inline AudioRingBufferParallelWriter::AudioRingBufferParallelWriter(AudioRingBufferParallelWriter &&other) noexcept
+    : ringBuffer_{other.ringBuffer_}, countdown_{std::move(other.countdown_)} {}
+
+inline auto AudioRingBufferParallelWriter::begin(SizeType frameCount) noexcept -> Region {
+    if (countdown_.inFlight()) [[unlikely]] {
+        return {};
+    }
+
+    const auto region = ringBuffer_.reserveWrite(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        return {};
+    }
+
+    countdown_.start(region.count());
+    return region;
+}
+
+inline bool AudioRingBufferParallelWriter::inFlight() const noexcept {
+    return countdown_.inFlight();
+}
+
+inline void AudioRingBufferParallelWriter::writeChannels(const Region &region,
+                                                         const AudioBufferList *const _Nonnull bufferList,
+                                                         UInt32 firstChannel) const noexcept {
+    const auto bytesPerFrame = ringBuffer_.format().mBytesPerFrame;
+    const auto bytesToEnd = region.firstCount * bytesPerFrame;
+    const auto bytesAfterWrap = region.secondCount * bytesPerFrame;
+
+    for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+        assert(firstChannel + i < ringBuffer_.format().mChannelsPerFrame);
+        assert(bytesToEnd + bytesAfterWrap <= bufferList->mBuffers[i].mDataByteSize);
+        const auto src = static_cast<const unsigned char *>(bufferList->mBuffers[i].mData);
+        const auto dst = static_cast<unsigned char *>(ringBuffer_.channelBuffer(firstChannel + i));
+        std::memcpy(dst + region.index * bytesPerFrame, src, bytesToEnd);
+        if (bytesAfterWrap != 0) [[unlikely]] {
+            std::memcpy(dst, src + bytesToEnd, bytesAfterWrap);
+        }
+    }
+}
+
+inline bool AudioRingBufferParallelWriter::commit() noexcept {
+    return countdown_.finish([this](SizeType frameCount) noexcept { ringBuffer_.commitWrite(frameCount); });
+}
+
+} /* namespace spsc */
@@ -0,0 +1,232 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spsc {
+
+/// A linear chain of processing stages connected by ``AudioRingBuffer`` instances.
+///
+/// An external producer writes to ``input``, each stage reads a block from its input ring, processes it, and writes the
+/// result to its output ring, and an external consumer reads from ``output``. The capacity of each ring is derived from
+/// the block sizes and latencies declared by the stages on either side of it, so a ring is always large enough for its
+/// producer to write a full block while its consumer waits for one.
+///
+/// A stage runs only when its input holds a full block and its output has space for a full block, so a slow stage or
+/// consumer fills the rings upstream of it and stalls the stages feeding it. Stages run on a dedicated thread each,
+/// optionally pinned to a CPU, or on a shared ``AudioRingBufferScheduler`` pool.
+///
+/// Per-stage counters record throughput, processing time, how often a stage was starved or blocked, and input ring
+/// depth. A bottleneck shows up as a stage with high processing time whose input ring stays full while the stages
+/// after it are starved.
+class AudioRingBufferPipeline final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// A stage's processing function.
+    ///
+    /// The function receives a full block of input and an output buffer list sized for ``Stage::maxOutputFrameCount``
+    /// audio frames, and returns the number of audio frames written to the output.
+    using ProcessFunction = std::function<SizeType(const AudioBufferList *_Nonnull input,
+                                                   AudioBufferList *_Nonnull output, SizeType frameCount)>;
+
+    /// A processing stage.
+    struct Stage {
+        /// The processing function.
+        ProcessFunction process;
+        /// The format of the audio the stage produces.
+        AudioStreamBasicDescription outputFormat{};
+        /// The number of audio frames the stage consumes per call.
+        SizeType blockFrameCount{0};
+        /// The maximum number of audio frames the stage produces per call, or 0 for ``blockFrameCount``.
+        SizeType maxOutputFrameCount{0};
+        /// The additional audio frames the stage's input ring should hold to absorb scheduling jitter.
+        SizeType latencyFrameCount{0};
+        /// The CPU to pin the stage's dedicated thread to, or -1 for none.
+        int cpu{-1};
+    };
+
+    /// The stages of a pipeline in processing order.
+    using StageList = std::vector<Stage>;
+
+    /// The external producer or consumer at one end of the pipeline.
+    struct Endpoint {
+        /// The number of audio frames the endpoint writes or reads at a time.
+        SizeType blockFrameCount{0};
+        /// The additional audio frames the endpoint's ring should hold to absorb scheduling jitter.
+        SizeType latencyFrameCount{0};
+    };
+
+    /// How stages are assigned to threads.
+    enum class Threading {
+        /// Each stage runs on its own thread.
+        dedicated,
+        /// Stages run on a shared pool of worker threads.
+        pooled,
+    };
+
+    /// Counters for a stage.
+    struct StageStatistics {
+        /// The number of blocks processed.
+        SizeType blockCount{0};
+        /// The number of audio frames consumed.
+        SizeType framesConsumed{0};
+        /// The number of audio frames produced.
+        SizeType framesProduced{0};
+        /// The time spent in the processing function.
+        std::chrono::nanoseconds processingTime{0};
+        /// The number of times the stage found less than a block of input.
+        SizeType starvedCount{0};
+        /// The number of times the stage had input but its output lacked space.
+        SizeType blockedCount{0};
+        /// The number of audio frames in the input ring.
+        SizeType inputDepth{0};
+        /// The largest number of audio frames observed in the input ring before a block was read.
+        SizeType maxInputDepth{0};
+        /// The capacity of the input ring in audio frames.
+        SizeType inputCapacity{0};
+    };
+
+    /// The default interval an idle thread sleeps.
+    static constexpr std::chrono::microseconds defaultIdleInterval = std::chrono::microseconds{200};
+
+    /// Returns the minimum capacity of a ring between a producer and a consumer.
+    ///
+    /// The ring holds one producer block and one consumer block plus both latencies, so the producer can always
+    /// complete a write while the consumer waits for a full block.
+    /// @param producerBlockFrameCount The maximum number of audio frames the producer writes at a time.
+    /// @param producerLatencyFrameCount The producer's additional latency in audio frames.
+    /// @param consumerBlockFrameCount The number of audio frames the consumer reads at a time.
+    /// @param consumerLatencyFrameCount The consumer's additional latency in audio frames.
+    [[nodiscard]] static constexpr SizeType ringCapacity(SizeType producerBlockFrameCount,
+                                                         SizeType producerLatencyFrameCount,
+                                                         SizeType consumerBlockFrameCount,
+                                                         SizeType consumerLatencyFrameCount) noexcept {
+        return producerBlockFrameCount + producerLatencyFrameCount + consumerBlockFrameCount +
+               consumerLatencyFrameCount;
+    }
+
+    /// Returns a processing function that calls a C function with a context pointer.
+    ///
+    /// This allows callers that cannot form a `std::function`, such as Swift, to supply a stage's processing function.
+    /// @param function The function to call.
+    /// @param context The first argument passed to function.
+    static ProcessFunction makeProcessFunction(SizeType (*_Nonnull function)(void *_Nullable context,
+                                                                             const AudioBufferList *_Nonnull input,
+                                                                             AudioBufferList *_Nonnull output,
+                                                                             SizeType frameCount),
+                                               void *_Nullable context) noexcept;
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty pipeline.
+    /// @note ``allocate`` must be called before the object may be used.
+    AudioRingBufferPipeline() noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferPipeline(const AudioRingBufferPipeline &) = delete;
+
+    /// Creates a pipeline by moving the rings and stages of another pipeline.
+    ///
+    /// The rings, stages, and threads are heap allocated, so a running pipeline keeps running.
+    /// @note This method is not thread safe for the pipeline being moved.
+    /// @param other The pipeline to move.
+    AudioRingBufferPipeline(AudioRingBufferPipeline &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferPipeline &operator=(const AudioRingBufferPipeline &) = delete;
+
+    /// Stops this pipeline and moves the rings and stages of another pipeline into it.
+    /// @note This method is not thread safe.
+    /// @param other The pipeline to move.
+    AudioRingBufferPipeline &operator=(AudioRingBufferPipeline &&other) noexcept;
+
+    /// Stops the stage threads and destroys the pipeline.
+    ~AudioRingBufferPipeline() noexcept;
+
+    // MARK: Pipeline Management
+
+    /// Allocates the rings and processing buffers for a chain of stages.
+    /// @note This method must not be called while the pipeline is running.
+    /// @param format The format of the audio written to ``input``.
+    /// @param source The external producer writing to ``input``.
+    /// @param stages The stages in processing order.
+    /// @param sink The external consumer reading from ``output``.
+    /// @return true on success, false if a format or block size is invalid or memory could not be allocated.
+    bool allocate(const AudioStreamBasicDescription &format, Endpoint source, StageList stages, Endpoint sink) noexcept;
+
+    /// Stops the stage threads and frees the rings and stages.
+    void deallocate() noexcept;
+
+    /// Returns true if the pipeline has been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Returns the number of stages.
+    [[nodiscard]] SizeType stageCount() const noexcept;
+
+    /// Returns the ring the external producer writes.
+    /// @note The pipeline must be allocated.
+    [[nodiscard]] AudioRingBuffer &input() const noexcept;
+
+    /// Returns the ring the external consumer reads.
+    /// @note The pipeline must be allocated.
+    [[nodiscard]] AudioRingBuffer &output() const noexcept;
+
+    // MARK: Running
+
+    /// Starts running the stages.
+    /// @param threading How stages are assigned to threads.
+    /// @param poolThreadCount The number of pool worker threads for ``Threading::pooled``.
+    /// @param idleInterval The interval an idle thread sleeps.
+    /// @return true on success, false if the pipeline is not allocated, is already running, or a thread could not be
+    /// started.
+    bool start(Threading threading = Threading::dedicated, unsigned poolThreadCount = 1,
+               std::chrono::microseconds idleInterval = defaultIdleInterval) noexcept;
+
+    /// Stops the stage threads after their current blocks finish.
+    void stop() noexcept;
+
+    /// Returns true if the stages are running.
+    [[nodiscard]] bool isRunning() const noexcept;
+
+    // MARK: Instrumentation
+
+    /// Returns a stage's counters.
+    /// @note This method is safe to call from any thread.
+    /// @param stage The stage index.
+    [[nodiscard]] StageStatistics statistics(SizeType stage) const noexcept;
+
+  private:
+    /// A stage's function, buffers, and counters.
+    struct StageState;
+    /// Thread state while running.
+    struct Runner;
+
+    /// Processes as many blocks as possible.
+    /// @return true if at least one block was processed.
+    static bool runStage(StageState &stage) noexcept;
+
+    /// The rings, of which there is one more than there are stages.
+    std::vector<std::unique_ptr<AudioRingBuffer>> rings_;
+    /// The stages.
+    std::vector<std::unique_ptr<StageState>> stages_;
+    /// Thread state while running.
+    std::unique_ptr<Runner> runner_;
+};
+
+} /* namespace spsc */
@@ -0,0 +1,105 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+// Static probes on the AudioRingBuffer hot path.
+//
+// On Linux with <sys/sdt.h> (systemtap-sdt-dev) available, each probe is a SystemTap-style USDT probe of provider
+// `spsc` guarded by a semaphore. Until a tracer such as `perf` or `bpftrace` attaches and increments the semaphore, a
+// probe site costs one load and a not-taken branch and its arguments are not evaluated. The probes themselves are
+// placed in AudioRingBufferProbes.cpp, so <sys/sdt.h> is included only there. Elsewhere, or with SPSC_DISABLE_PROBES
+// defined, the probes compile to nothing.
+//
+// Every probe's first argument is the address of the ring buffer, which identifies it:
+//
+//   spsc:write     ring, frames requested, frames written, write position, read position
+//   spsc:read      ring, frames requested, frames read, write position, read position
+//   spsc:overrun   ring, frames requested, frames written, write position, read position
+//   spsc:underrun  ring, frames requested, frames read, write position, read position
+//   spsc:skip      ring, frames requested, frames skipped, read position
+//   spsc:drain     ring, frames discarded, read position
+//
+// Positions are free-running frame counts sampled after the operation. For example,
+//
+//   bpftrace -e 'usdt:/path/to/binary:spsc:underrun { printf("%p %d/%d\n", arg0, arg2, arg1); }'
+
+#if !defined(SPSC_DISABLE_PROBES) && defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define SPSC_PROBES 1
+#endif
+#endif
+
+#if defined(SPSC_PROBES)
+
+#include <cstddef>
+
+// Incremented by a tracer while a probe is attached; defined in AudioRingBufferProbes.cpp
+#define SPSC_DECLARE_PROBE_SEMAPHORE(name) extern "C" unsigned short spsc_##name##_semaphore
+
+SPSC_DECLARE_PROBE_SEMAPHORE(write);
+SPSC_DECLARE_PROBE_SEMAPHORE(read);
+SPSC_DECLARE_PROBE_SEMAPHORE(overrun);
+SPSC_DECLARE_PROBE_SEMAPHORE(underrun);
+SPSC_DECLARE_PROBE_SEMAPHORE(skip);
+SPSC_DECLARE_PROBE_SEMAPHORE(drain);
+
+namespace spsc::detail {
+
+// The probe sites. These are defined in AudioRingBufferProbes.cpp so <sys/sdt.h> stays out of client code.
+
+void writeProbe(const void *ring, std::size_t requested, std::size_t written, std::size_t writePosition,
+                std::size_t readPosition) noexcept;
+void readProbe(const void *ring, std::size_t requested, std::size_t read, std::size_t writePosition,
+               std::size_t readPosition) noexcept;
+void overrunProbe(const void *ring, std::size_t requested, std::size_t written, std::size_t writePosition,
+                  std::size_t readPosition) noexcept;
+void underrunProbe(const void *ring, std::size_t requested, std::size_t read, std::size_t writePosition,
+                   std::size_t readPosition) noexcept;
+void skipProbe(const void *ring, std::size_t requested, std::size_t skipped, std::size_t readPosition) noexcept;
+void drainProbe(const void *ring, std::size_t discarded, std::size_t readPosition) noexcept;
+
+} /* namespace spsc::detail */
+
+/// Evaluates to true while a tracer is attached to the probe.
+#define SPSC_PROBE_ENABLED(name) __builtin_expect(spsc_##name##_semaphore, 0)
+
+#define SPSC_PROBE3(name, a1, a2, a3)                                                                                 \
+    do {                                                                                                               \
+        if (SPSC_PROBE_ENABLED(name)) [[unlikely]] {                                                                   \
+            spsc::detail::name##Probe(a1, a2, a3);                                                                     \
+        }                                                                                                              \
+    } while (0)
+
+#define SPSC_PROBE4(name, a1, a2, a3, a4)                                                                             \
+    do {                                                                                                               \
+        if (SPSC_PROBE_ENABLED(name)) [[unlikely]] {                                                                   \
+            spsc::detail::name##Probe(a1, a2, a3, a4);                                                                 \
+        }                                                                                                              \
+    } while (0)
+
+#define SPSC_PROBE5(name, a1, a2, a3, a4, a5)                                                                         \
+    do {                                                                                                               \
+        if (SPSC_PROBE_ENABLED(name)) [[unlikely]] {                                                                   \
+            spsc::detail::name##Probe(a1, a2, a3, a4, a5);                                                             \
+        }                                                                                                              \
+    } while (0)
+
+#else
+
+#define SPSC_PROBE_ENABLED(name) 0
+#define SPSC_PROBE3(name, a1, a2, a3)                                                                                 \
+    do {                                                                                                               \
+    } while (0)
+#define SPSC_PROBE4(name, a1, a2, a3, a4)                                                                             \
+    do {                                                                                                               \
+    } while (0)
+#define SPSC_PROBE5(name, a1, a2, a3, a4, a5)                                                                         \
+    do {                                                                                                               \
+    } while (0)
+
+#endif
@@ -0,0 +1,87 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <chrono>
+
+namespace spsc {
+
+/// A policy releasing the memory of an ``AudioRingBuffer`` that has stayed nearly empty.
+///
+/// Once the buffer has held no more than a low number of audio frames for a configured time, the pages outside the live
+/// region are released with ``AudioRingBuffer::reclaimFreeSpace``. This is repeated once per idle period for as long
+/// as the buffer stays idle.
+///
+/// Because `madvise` is a system call, ``update`` is best called from a producer that is not a realtime thread or at a
+/// low rate from a realtime one.
+class AudioRingBufferReclaimer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+    /// The clock used to measure idle time.
+    using Clock = std::chrono::steady_clock;
+
+    /// Creates a reclaimer.
+    /// @param lowFillFrames The number of audio frames at or below which the buffer is considered idle.
+    /// @param idleDuration The time the buffer must stay idle before memory is released.
+    /// @param keepFrames The number of audio frames following the write position to keep resident.
+    AudioRingBufferReclaimer(SizeType lowFillFrames, Clock::duration idleDuration, SizeType keepFrames = 0) noexcept;
+
+    /// Samples the fill level of a buffer and releases memory if it has been idle long enough.
+    /// @note This method is only safe to call from the producer of ringBuffer.
+    /// @param ringBuffer The ring buffer to manage.
+    /// @param now The current time.
+    /// @return The number of bytes released.
+    SizeType update(AudioRingBuffer &ringBuffer, Clock::time_point now = Clock::now()) noexcept;
+
+  private:
+    /// The number of audio frames at or below which the buffer is considered idle.
+    SizeType lowFillFrames_;
+    /// The time the buffer must stay idle before memory is released.
+    Clock::duration idleDuration_;
+    /// The number of audio frames following the write position to keep resident.
+    SizeType keepFrames_;
+
+    /// True if the buffer was idle when last sampled.
+    bool idle_{false};
+    /// The start of the current idle period.
+    Clock::time_point idleSince_{};
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferReclaimer::AudioRingBufferReclaimer(SizeType lowFillFrames, Clock::duration idleDuration,
+                                                          SizeType keepFrames) noexcept
+    : lowFillFrames_{lowFillFrames}, idleDuration_{idleDuration}, keepFrames_{keepFrames} {}
+
+inline auto AudioRingBufferReclaimer::update(AudioRingBuffer &ringBuffer, Clock::time_point now) noexcept
+        -> SizeType {
+    const auto framesUsed = ringBuffer.capacity() - ringBuffer.freeSpace();
+    if (framesUsed > lowFillFrames_) {
+        idle_ = false;
+        return 0;
+    }
+
+    if (!idle_) {
+        idle_ = true;
+        idleSince_ = now;
+        return 0;
+    }
+
+    if (now - idleSince_ < idleDuration_) {
+        return 0;
+    }
+
+    // Start a new idle period so pages touched since are released again later
+    idleSince_ = now;
+    return ringBuffer.reclaimFreeSpace(keepFrames_);
+}
+
+} /* namespace spsc */
@@ -0,0 +1,150 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spsc {
+
+/// Runs a graph of processing nodes connected by ``AudioRingBuffer`` instances on a pool of worker threads.
+///
+/// A node is runnable when each of its input rings holds at least a threshold number of audio frames and each of its
+/// output rings has at least a threshold amount of free space. Runnable nodes are pushed to per-worker work-stealing
+/// deques; a worker with an empty deque steals from the others.
+///
+/// Readiness is detected by reading ring positions, without system calls. After a node runs, the nodes reading its
+/// output rings and writing its input rings are checked, since those are the rings whose positions it changed. Each
+/// worker also sweeps a share of the nodes when it finds no work, which picks up audio written to the graph from
+/// outside. A worker that finds no work for a while sleeps for a short interval.
+///
+/// A node is never run by two workers at once, so a node may act as the producer of its output rings and the consumer
+/// of its input rings even though it may run on a different worker each time.
+class AudioRingBufferScheduler final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+    /// A node's processing function.
+    using ProcessFunction = std::function<void()>;
+
+    /// A ring buffer connected to a node and the number of audio frames the node needs from or in it.
+    struct Port {
+        /// The ring buffer.
+        AudioRingBuffer *_Nonnull ringBuffer;
+        /// For an input, the audio frames that must be available; for an output, the free space required.
+        SizeType frameCount;
+    };
+
+    /// The rings connected to one side of a node.
+    using PortList = std::vector<Port>;
+
+    /// The default interval a worker sleeps after finding no work.
+    static constexpr std::chrono::microseconds defaultIdleInterval = std::chrono::microseconds{200};
+
+    // MARK: Construction and Destruction
+
+    /// Creates a scheduler with no nodes.
+    AudioRingBufferScheduler() noexcept;
+
+    // This class is non-copyable
+    AudioRingBufferScheduler(const AudioRingBufferScheduler &) = delete;
+
+    /// Creates a scheduler by moving the nodes of another scheduler.
+    ///
+    /// If the other scheduler is running its workers are stopped after their current nodes finish and restarted on this
+    /// scheduler with the same thread count and idle interval.
+    /// @note This method is not thread safe for the scheduler being moved.
+    /// @param other The scheduler to move.
+    AudioRingBufferScheduler(AudioRingBufferScheduler &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferScheduler &operator=(const AudioRingBufferScheduler &) = delete;
+
+    /// Stops this scheduler and moves the nodes of another scheduler into it.
+    ///
+    /// If the other scheduler is running its workers are stopped after their current nodes finish and restarted on this
+    /// scheduler with the same thread count and idle interval.
+    /// @note This method is not thread safe.
+    /// @param other The scheduler to move.
+    AudioRingBufferScheduler &operator=(AudioRingBufferScheduler &&other) noexcept;
+
+    /// Stops the worker threads and destroys the scheduler.
+    ~AudioRingBufferScheduler() noexcept;
+
+    // MARK: Graph Construction
+
+    /// Returns a processing function that calls a C function with a context pointer.
+    ///
+    /// This allows callers that cannot form a `std::function`, such as Swift, to supply a node's processing function.
+    /// @param function The function to call.
+    /// @param context The argument passed to function.
+    static ProcessFunction makeProcessFunction(void (*_Nonnull function)(void *_Nullable context),
+                                               void *_Nullable context) noexcept;
+
+    /// Adds a node.
+    /// @note This method must not be called while the scheduler is running.
+    /// @param process The node's processing function, which should consume and produce as much audio as it can.
+    /// @param inputs The rings the node reads.
+    /// @param outputs The rings the node writes.
+    /// @return The node index or ``SizeType(-1)`` if memory could not be allocated.
+    SizeType addNode(ProcessFunction process, PortList inputs, PortList outputs) noexcept;
+
+    /// Returns the number of nodes.
+    [[nodiscard]] SizeType nodeCount() const noexcept;
+
+    /// Returns the number of times a node has run.
+    /// @note This method is safe to call from any thread.
+    /// @param node The node index.
+    [[nodiscard]] SizeType runCount(SizeType node) const noexcept;
+
+    // MARK: Running
+
+    /// Starts the worker threads.
+    /// @param threadCount The number of worker threads.
+    /// @param idleInterval The interval a worker sleeps after finding no work.
+    /// @return true on success, false if the scheduler is already running or a thread could not be started.
+    bool start(unsigned threadCount, std::chrono::microseconds idleInterval = defaultIdleInterval) noexcept;
+
+    /// Stops the worker threads after their current nodes finish.
+    void stop() noexcept;
+
+    /// Returns true if the worker threads are running.
+    [[nodiscard]] bool isRunning() const noexcept;
+
+  private:
+    /// A processing node.
+    struct Node;
+    /// A worker thread and its deque.
+    struct Worker;
+    /// State shared by the worker threads.
+    struct Pool;
+
+    /// Returns true if every input of node holds enough audio and every output has enough space.
+    static bool isReady(const Node &node) noexcept;
+
+    /// Pushes node to worker's deque if it is ready and not already scheduled.
+    void trySchedule(Node &node, Worker &worker) noexcept;
+
+    /// Runs node and schedules it and its neighbors if they became ready.
+    void run(Node &node, Worker &worker) noexcept;
+
+    /// The body of a worker thread.
+    void workerLoop(Worker &worker) noexcept;
+
+    /// The nodes.
+    std::vector<std::unique_ptr<Node>> nodes_;
+    /// Worker thread state while running.
+    std::unique_ptr<Pool> pool_;
+};
+
+} /* namespace spsc */
@@ -0,0 +1,161 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+#include "RingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+namespace spsc {
+
+/// Records the time and size of each write and read on an ``AudioRingBuffer``.
+///
+/// The producer calls ``write`` and the consumer calls ``read`` in place of the ring buffer's own methods; each call
+/// is forwarded and an event is appended to a preallocated per-side ``RingBuffer``. Recording takes one clock read and
+/// one push, and never allocates or blocks. A third thread periodically calls ``collect`` to drain the events, for
+/// example to ``save`` them for the capacity planner. Events that do not fit are counted and dropped.
+///
+/// Timestamps are nanoseconds of `std::chrono::steady_clock`, so traces from different tracers in the same process
+/// can be merged.
+class AudioRingBufferTracer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The operation an event records.
+    enum class Operation : std::uint8_t {
+        /// A write by the producer.
+        write,
+        /// A read by the consumer.
+        read,
+    };
+
+    /// A recorded call.
+    struct Event {
+        /// The time the call was made, in nanoseconds of `std::chrono::steady_clock`.
+        std::int64_t timestamp{0};
+        /// The number of audio frames the caller asked to transfer.
+        SizeType framesRequested{0};
+        /// The number of audio frames actually transferred.
+        SizeType framesTransferred{0};
+        /// The operation.
+        Operation operation{Operation::write};
+    };
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty tracer.
+    /// @note ``allocate`` must be called before the object may be used.
+    AudioRingBufferTracer() noexcept = default;
+
+    // This class is non-copyable
+    AudioRingBufferTracer(const AudioRingBufferTracer &) = delete;
+
+    /// Creates a tracer by moving the events of another tracer.
+    /// @note This method is not thread safe for the tracer being moved.
+    /// @param other The tracer to move.
+    AudioRingBufferTracer(AudioRingBufferTracer &&other) noexcept;
+
+    // This class is non-assignable
+    AudioRingBufferTracer &operator=(const AudioRingBufferTracer &) = delete;
+
+    /// Moves the events of another tracer into this tracer.
+    /// @note This method is not thread safe.
+    /// @param other The tracer to move.
+    AudioRingBufferTracer &operator=(AudioRingBufferTracer &&other) noexcept;
+
+    /// Destroys the tracer.
+    ~AudioRingBufferTracer() noexcept = default;
+
+    // MARK: Tracer Management
+
+    /// Allocates space for events.
+    /// @note This method is not thread safe.
+    /// @param ringBuffer The ring buffer to trace.
+    /// @param minEventCapacity The minimum number of events buffered per side between calls to ``collect``.
+    /// @return true on success, false if memory could not be allocated.
+    bool allocate(AudioRingBuffer &ringBuffer, SizeType minEventCapacity) noexcept;
+
+    /// Frees the event storage.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the tracer has been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Returns the number of events dropped because the event storage was full.
+    /// @note This method is safe to call from any thread.
+    [[nodiscard]] SizeType droppedEventCount() const noexcept;
+
+    // MARK: Tracing
+
+    /// Writes audio to the ring buffer and records the call.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads audio from the ring buffer and records the call.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Records a write made through another path, such as ``AudioRingBuffer::commitWrite``.
+    /// @note This method is only safe to call from the producer.
+    void recordWrite(SizeType framesRequested, SizeType framesTransferred) noexcept;
+
+    /// Records a read made through another path, such as ``AudioRingBuffer::commitRead``.
+    /// @note This method is only safe to call from the consumer.
+    void recordRead(SizeType framesRequested, SizeType framesTransferred) noexcept;
+
+    // MARK: Collecting Events
+
+    /// Removes recorded events, producer events first.
+    /// @note This method is only safe to call from a single collecting thread.
+    /// @param events An array to receive the events.
+    /// @param maxEventCount The capacity of events.
+    /// @return The number of events removed.
+    SizeType collect(Event *const _Nonnull events, SizeType maxEventCount) noexcept;
+
+    /// Appends events to a file as comma-separated `operation,timestamp,framesRequested,framesTransferred` lines, where
+    /// operation is `w` or `r`.
+    /// @return true on success, false on an I/O error.
+    static bool save(std::FILE *_Nonnull file, const Event *const _Nonnull events, SizeType eventCount) noexcept;
+
+  private:
+    /// Appends an event to events, counting it as dropped if there is no space.
+    void record(RingBuffer<Event> &events, Operation operation, SizeType framesRequested,
+                SizeType framesTransferred) noexcept;
+
+    /// The traced ring buffer.
+    AudioRingBuffer *_Nullable ringBuffer_{nullptr};
+    /// Events recorded by the producer.
+    RingBuffer<Event> writeEvents_;
+    /// Events recorded by the consumer.
+    RingBuffer<Event> readEvents_;
+    /// The number of events dropped.
+    std::atomic<SizeType> droppedEventCount_{0};
+};
+
+// MARK: - Implementation -
+
+inline AudioRingBufferTracer::operator bool() const noexcept { return ringBuffer_ != nullptr; }
+
+inline auto AudioRingBufferTracer::droppedEventCount() const noexcept -> SizeType {
+    return droppedEventCount_.load(std::memory_order_relaxed);
+}
+
+} /* namespace spsc */
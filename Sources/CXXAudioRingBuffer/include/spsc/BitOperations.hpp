@@ -0,0 +1,47 @@
+//
+// SPDX-FileCopyrightText: 2013 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <cassert>
+#include <climits>
+#include <limits>
+#include <type_traits>
+
+namespace spsc::detail {
+
+/// Returns the number of leading 0-bits in x, starting at the most significant bit position.
+template <typename T> constexpr int clz(T x) noexcept {
+    static_assert(std::is_unsigned_v<T>, "Only unsigned types supported");
+    if (x == 0) {
+        return sizeof(T) * CHAR_BIT;
+    }
+    if constexpr (sizeof(T) < sizeof(unsigned int)) {
+        return __builtin_clz(x) - (sizeof(unsigned int) - sizeof(T)) * CHAR_BIT;
+    } else if constexpr (sizeof(T) == sizeof(unsigned int)) {
+        return __builtin_clz(x);
+    } else if constexpr (sizeof(T) == sizeof(unsigned long)) {
+        return __builtin_clzl(x);
+    } else {
+        return __builtin_clzll(x);
+    }
+}
+
+/// Calculates and returns the smallest integral power of two not less than x.
+/// @param x A value on the closed interval [0, 2147483648].
+/// @return The smallest integral power of two not less than x.
+template <typename T> constexpr T bit_ceil(T x) noexcept {
+    static_assert(std::is_unsigned_v<T>, "Only unsigned types supported");
+    if (x < 2) {
+        return 1;
+    }
+    const auto n = std::numeric_limits<T>::digits - clz(x - 1);
+    assert(n != std::numeric_limits<T>::digits);
+    return T{1} << n;
+}
+
+} /* namespace spsc::detail */
@@ -0,0 +1,112 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace spsc::detail {
+
+/// The in-flight region and countdown shared by ``AudioRingBufferParallelWriter`` and
+/// ``AudioRingBufferParallelReader``.
+///
+/// One thread starts a region of audio frames, then each of a fixed number of channel groups finishes it once. The
+/// group that finishes last commits the region to the ring buffer, and only then may another region start.
+class ChannelGroupCountdown final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+
+    /// Creates a countdown.
+    /// @param groupCount The number of channel groups that must finish each region.
+    explicit ChannelGroupCountdown(UInt32 groupCount) noexcept;
+
+    // This class is non-copyable
+    ChannelGroupCountdown(const ChannelGroupCountdown &) = delete;
+
+    /// Creates a countdown by moving the state of another countdown.
+    /// @note This method is not thread safe for the countdown being moved.
+    /// @param other The countdown to move.
+    ChannelGroupCountdown(ChannelGroupCountdown &&other) noexcept;
+
+    // This class is non-assignable
+    ChannelGroupCountdown &operator=(const ChannelGroupCountdown &) = delete;
+
+    // This class is non-move-assignable
+    ChannelGroupCountdown &operator=(ChannelGroupCountdown &&) = delete;
+
+    /// Returns true if a region has been started and not yet finished by every group.
+    ///
+    /// A false result synchronizes with the commit of the previous region.
+    [[nodiscard]] bool inFlight() const noexcept;
+
+    /// Starts a region.
+    /// @note This method may only be called when ``inFlight`` returns false.
+    /// @param frameCount The number of audio frames in the region, which must not be zero.
+    void start(SizeType frameCount) noexcept;
+
+    /// Marks one channel group as finished, and if it is the last calls commit with the number of audio frames in the
+    /// region before another region may start.
+    /// @note Each group must call this method exactly once per ``start``.
+    /// @return true if this call committed the region.
+    template <typename Commit> bool finish(Commit &&commit) noexcept;
+
+  private:
+    /// The number of channel groups.
+    UInt32 groupCount_;
+
+    /// The number of audio frames in the started region.
+    SizeType frameCount_{0};
+    /// The number of groups that have not yet finished the started region.
+    std::atomic<UInt32> pendingGroups_{0};
+    /// Set while a region is started.
+    std::atomic<bool> inFlight_{false};
+};
+
+// MARK: - Implementation -
+
+inline ChannelGroupCountdown::ChannelGroupCountdown(UInt32 groupCount) noexcept : groupCount_{groupCount} {
+    assert(groupCount > 0);
+}
+
+inline ChannelGroupCountdown::ChannelGroupCountdown(ChannelGroupCountdown &&other) noexcept
+    : groupCount_{other.groupCount_}, frameCount_{std::exchange(other.frameCount_, 0)},
+      pendingGroups_{other.pendingGroups_.exchange(0, std::memory_order_relaxed)},
+      inFlight_{other.inFlight_.exchange(false, std::memory_order_relaxed)} {}
+
+inline bool ChannelGroupCountdown::inFlight() const noexcept {
+    // Acquire pairs with the release in finish so the previous region's commit is complete
+    return inFlight_.load(std::memory_order_acquire);
+}
+
+inline void ChannelGroupCountdown::start(SizeType frameCount) noexcept {
+    assert(frameCount > 0);
+    frameCount_ = frameCount;
+    pendingGroups_.store(groupCount_, std::memory_order_relaxed);
+    inFlight_.store(true, std::memory_order_relaxed);
+}
+
+template <typename Commit> inline bool ChannelGroupCountdown::finish(Commit &&commit) noexcept {
+    // More calls than groups for one region would wrap the count
+    assert(pendingGroups_.load(std::memory_order_relaxed) != 0);
+
+    // Acquire-release orders every group's accesses to the region before the commit by the group that finishes last
+    if (pendingGroups_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return false;
+    }
+
+    commit(frameCount_);
+    inFlight_.store(false, std::memory_order_release);
+    return true;
+}
+
+} /* namespace spsc::detail */
@@ -0,0 +1,324 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "RingBufferIndex.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace spsc {
+
+namespace detail {
+
+/// Converts a float to a half-precision float in software, rounding to nearest even.
+///
+/// ``CompactAudioRingBuffer`` uses this conversion when the CPU has no half-precision instructions.
+std::uint16_t floatToHalf(float value) noexcept;
+
+/// Converts a half-precision float to a float in software.
+float halfToFloat(std::uint16_t value) noexcept;
+
+} /* namespace detail */
+
+/// A lock-free SPSC ring buffer supporting non-interleaved 32-bit float audio stored at reduced precision.
+///
+/// Audio is converted to 16-bit samples when written and back to 32-bit float when read, halving the memory and
+/// bandwidth needed compared with ``AudioRingBuffer``.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class CompactAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = std::atomic<SizeType>;
+    /// The type of a stored sample.
+    using StorageType = std::uint16_t;
+
+    /// Sample storage formats.
+    enum class StorageFormat {
+        /// IEEE 754 half-precision float.
+        float16,
+        /// Signed 16-bit integer with triangular dither.
+        int16,
+    };
+
+    /// The minimum supported buffer capacity in audio frames.
+    static constexpr SizeType minCapacity = SizeType{2};
+    /// The maximum supported buffer capacity in audio frames.
+    static constexpr SizeType maxCapacity = SizeType{1} << (std::numeric_limits<SizeType>::digits - 1);
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    CompactAudioRingBuffer() noexcept = default;
+
+    /// Creates a ring buffer with the specified format, minimum audio frame capacity, and storage format.
+    ///
+    /// The actual buffer capacity will be the smallest integral power of two that is not less than the specified
+    /// minimum capacity.
+    /// @note Only non-interleaved native 32-bit float formats are supported.
+    /// @param format The format of the audio that will be written to and read from the buffer.
+    /// @param minFrameCapacity The desired minimum capacity in audio frames.
+    /// @param storageFormat The format used to store samples.
+    /// @throw std::bad_alloc if memory could not be allocated or std::invalid_argument if the audio format or buffer
+    /// capacity is not supported.
+    CompactAudioRingBuffer(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                           StorageFormat storageFormat);
+
+    // This class is non-copyable
+    CompactAudioRingBuffer(const CompactAudioRingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    /// @note This method is not thread safe for the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    CompactAudioRingBuffer(CompactAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    CompactAudioRingBuffer &operator=(const CompactAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    CompactAudioRingBuffer &operator=(CompactAudioRingBuffer &&other) noexcept;
+
+    /// Destroys the ring buffer and releases all associated resources.
+    ~CompactAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for audio data of the specified format.
+    ///
+    /// The actual buffer capacity will be the smallest integral power of two that is not less than the specified
+    /// minimum capacity.
+    /// @note Only non-interleaved native 32-bit float formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from this buffer.
+    /// @param minFrameCapacity The desired minimum capacity in audio frames.
+    /// @param storageFormat The format used to store samples.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// buffer capacity is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                  StorageFormat storageFormat) noexcept;
+
+    /// Frees any space allocated for audio data.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the buffer has allocated space for audio data.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the format of the audio written to and read from the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The audio format of the buffer.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the format used to store samples.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The sample storage format.
+    [[nodiscard]] StorageFormat storageFormat() const noexcept;
+
+    /// Returns the capacity of the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The buffer capacity in audio frames.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the buffer.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of audio frames of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns true if the buffer is full.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return true if the buffer is full.
+    [[nodiscard]] bool isFull() const noexcept;
+
+    /// Returns the amount of audio in the buffer.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns true if the buffer is empty.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return true if the buffer contains no data.
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Converts and writes audio and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads and converts audio and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Advances the read position to the write position, emptying the buffer.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// Converts count samples from src to the storage format and stores them in dst.
+    /// @note This method is only called from the producer.
+    void encode(StorageType *const _Nonnull dst, const float *const _Nonnull src, SizeType count) noexcept;
+
+    /// Converts count stored samples from src to 32-bit float and stores them in dst.
+    void decode(float *const _Nonnull dst, const StorageType *const _Nonnull src, SizeType count) const noexcept;
+
+    /// The memory buffers holding the data, consisting of channel pointers and buffers allocated in one chunk.
+    StorageType *_Nonnull *_Nullable buffers_{nullptr};
+
+    /// The capacity, write position, and read position of ``buffers_`` in audio frames.
+    detail::RingBufferIndex index_;
+
+    /// The format used to store samples.
+    StorageFormat storageFormat_{StorageFormat::float16};
+    /// The dither generator state, owned by the producer.
+    std::uint32_t ditherState_{1};
+
+    /// The format of the audio written to and read from this buffer.
+    AudioStreamBasicDescription format_{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline CompactAudioRingBuffer::operator bool() const noexcept { return buffers_ != nullptr; }
+
+// MARK: Buffer Information
+
+inline const AudioStreamBasicDescription &CompactAudioRingBuffer::format() const noexcept { return format_; }
+
+inline auto CompactAudioRingBuffer::storageFormat() const noexcept -> StorageFormat { return storageFormat_; }
+
+inline auto CompactAudioRingBuffer::capacity() const noexcept -> SizeType { return index_.capacity(); }
+
+// MARK: Buffer Usage
+
+inline auto CompactAudioRingBuffer::freeSpace() const noexcept -> SizeType { return index_.freeSpace(); }
+
+inline bool CompactAudioRingBuffer::isFull() const noexcept { return index_.freeSpace() == 0; }
+
+inline auto CompactAudioRingBuffer::availableFrames() const noexcept -> SizeType { return index_.availableElements(); }
+
+inline bool CompactAudioRingBuffer::isEmpty() const noexcept { return index_.availableElements() == 0; }
+
+// MARK: Writing and Reading Audio
+
+inline auto CompactAudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList,
+                                          SizeType frameCount) noexcept -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || buffers_ == nullptr) [[unlikely]] {
+        return 0;
+    }
+
+    const auto region = index_.reserveWrite(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        return 0;
+    }
+
+    /// Converts non-interleaved audio to the buffer array from an AudioBufferList struct.
+    const auto encodeToBuffersFromAudioBufferList = [this](SizeType dstIndex, const AudioBufferList *const _Nonnull src,
+                                                           SizeType srcIndex, SizeType count) noexcept {
+        for (UInt32 i = 0; i < src->mNumberBuffers; ++i) {
+            assert((srcIndex + count) * sizeof(float) <= src->mBuffers[i].mDataByteSize);
+            encode(buffers_[i] + dstIndex, static_cast<const float *>(src->mBuffers[i].mData) + srcIndex, count);
+        }
+    };
+
+    encodeToBuffersFromAudioBufferList(region.index, bufferList, 0, region.firstCount);
+    if (region.secondCount != 0) [[unlikely]] {
+        encodeToBuffersFromAudioBufferList(0, bufferList, region.firstCount, region.secondCount);
+    }
+
+    index_.commitWrite(region.count());
+    return region.count();
+}
+
+inline auto CompactAudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || buffers_ == nullptr) [[unlikely]] {
+        return 0;
+    }
+
+    const auto region = index_.reserveRead(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
+        }
+        return 0;
+    }
+
+    /// Converts non-interleaved audio to an AudioBufferList struct from the buffer array.
+    const auto decodeToAudioBufferListFromBuffers = [this](AudioBufferList *const _Nonnull dst, SizeType dstIndex,
+                                                           SizeType srcIndex, SizeType count) noexcept {
+        for (UInt32 i = 0; i < dst->mNumberBuffers; ++i) {
+            assert((dstIndex + count) * sizeof(float) <= dst->mBuffers[i].mDataByteSize);
+            decode(static_cast<float *>(dst->mBuffers[i].mData) + dstIndex, buffers_[i] + srcIndex, count);
+        }
+    };
+
+    const auto framesToRead = region.count();
+    decodeToAudioBufferListFromBuffers(bufferList, 0, region.index, region.firstCount);
+    if (region.secondCount != 0) [[unlikely]] {
+        decodeToAudioBufferListFromBuffers(bufferList, region.firstCount, 0, region.secondCount);
+    }
+
+    index_.commitRead(framesToRead);
+
+    // Fill remainder with silence if fewer than requested frames read
+    if (framesToRead != frameCount) {
+        const auto byteOffset = framesToRead * sizeof(float);
+        const auto byteCount = (frameCount - framesToRead) * sizeof(float);
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(byteOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memset(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + byteOffset, 0, byteCount);
+        }
+    }
+
+    return framesToRead;
+}
+
+// MARK: Discarding Audio
+
+inline auto CompactAudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType { return index_.skip(frameCount); }
+
+inline auto CompactAudioRingBuffer::drain() noexcept -> SizeType { return index_.drain(); }
+
+} /* namespace spsc */
@@ -0,0 +1,282 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace spsc {
+
+/// A lock-free SPSC ring buffer supporting non-interleaved 16-bit audio stored with lossless compression.
+///
+/// Audio written by the producer is staged in an ``AudioRingBuffer``. A helper thread encodes each block of staged
+/// audio with a fixed polynomial predictor and Rice coded residuals and appends it to a compressed ring with a block
+/// index. Blocks are decoded by the consumer on demand.
+///
+/// Native signed 16-bit integer audio round-trips exactly. Native 32-bit float audio is rounded to 16 bits before
+/// compression.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class CompressedAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = AudioRingBuffer::AtomicSizeType;
+
+    /// The default interval at which the helper thread encodes audio.
+    static constexpr std::chrono::microseconds defaultHelperInterval = std::chrono::milliseconds{5};
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    CompressedAudioRingBuffer() noexcept;
+
+    // This class is non-copyable
+    CompressedAudioRingBuffer(const CompressedAudioRingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    ///
+    /// A running helper thread is paused between passes and continues with this ring buffer.
+    /// @note This method is not thread safe for the producer and consumer of the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    CompressedAudioRingBuffer(CompressedAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    CompressedAudioRingBuffer &operator=(const CompressedAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    CompressedAudioRingBuffer &operator=(CompressedAudioRingBuffer &&other) noexcept;
+
+    /// Stops the helper thread and releases all associated resources.
+    ~CompressedAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for audio data of the specified format and starts the helper thread.
+    ///
+    /// The staging ring holds four blocks of audio.
+    /// @note Only non-interleaved native signed 16-bit integer and native 32-bit float formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from this buffer.
+    /// @param blockFrameCount The number of audio frames in each compressed block.
+    /// @param maxBlockCount The maximum number of compressed blocks held.
+    /// @param compressedByteCapacity The capacity of the compressed ring in bytes.
+    /// @param helperInterval The interval at which the helper thread encodes audio.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// buffer capacity is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType blockFrameCount, SizeType maxBlockCount,
+                  SizeType compressedByteCapacity,
+                  std::chrono::microseconds helperInterval = defaultHelperInterval) noexcept;
+
+    /// Stops the helper thread and frees any space allocated for audio data.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the buffer has allocated space for audio data.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the format of the audio stored in the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The audio format of the buffer.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the number of audio frames in each compressed block.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The block size in audio frames.
+    [[nodiscard]] SizeType blockFrameCount() const noexcept;
+
+    /// Returns the capacity of the compressed ring.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The compressed ring capacity in bytes.
+    [[nodiscard]] SizeType compressedByteCapacity() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the staging ring.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of audio frames of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns the amount of compressed audio in the buffer.
+    ///
+    /// Audio still in the staging ring is not included.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns the number of bytes used in the compressed ring.
+    /// @note This method is safe to call from any thread.
+    /// @return The number of bytes of compressed audio.
+    [[nodiscard]] SizeType compressedBytes() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Writes audio to the staging ring and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Requests that staged audio be compressed even if it does not fill a block.
+    /// @note This method is only safe to call from the producer.
+    void flush() noexcept;
+
+    /// Reads and decodes audio and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio and advances the read position.
+    ///
+    /// Whole blocks are skipped without decoding.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Advances the read position to the write position, emptying the compressed ring.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// The location of a compressed block.
+    struct BlockInfo {
+        /// The free-running byte position of the block in the compressed ring.
+        SizeType offset;
+        /// The size of the block in bytes.
+        SizeType size;
+        /// The number of audio frames in the block.
+        SizeType frameCount;
+    };
+
+    /// State owned by the helper thread.
+    struct Helper;
+
+    /// Encodes staged audio into the compressed ring.
+    /// @note This method is only called from the helper thread.
+    void pump() noexcept;
+
+    /// Decodes the next block into ``decoded_`` and releases its space in the compressed ring.
+    /// @note This method is only called from the consumer.
+    void decodeNextBlock() noexcept;
+
+    /// Releases the next block without decoding it and returns its frame count.
+    /// @note This method is only called from the consumer.
+    SizeType discardNextBlock() noexcept;
+
+    /// Ring written by the producer and read by the helper thread.
+    AudioRingBuffer staging_;
+
+    /// The compressed ring.
+    std::unique_ptr<unsigned char[]> compressed_;
+    /// The capacity of ``compressed_`` in bytes.
+    SizeType compressedByteCapacity_{0};
+    /// The free-running byte position of the end of the last block released by the consumer.
+    AtomicSizeType compressedReadPosition_{0};
+    /// The free-running byte position of the end of the last block written by the helper thread.
+    AtomicSizeType compressedWritePosition_{0};
+
+    /// The block index.
+    std::unique_ptr<BlockInfo[]> blocks_;
+    /// The capacity of ``blocks_`` minus one.
+    SizeType blockMask_{0};
+    /// The free-running index of the next block to be written.
+    AtomicSizeType blockWritePosition_{0};
+    /// The free-running index of the next block to be read.
+    AtomicSizeType blockReadPosition_{0};
+
+    /// The number of audio frames in each block.
+    SizeType blockFrameCount_{0};
+
+    /// The free-running location of the end of the compressed audio.
+    AtomicSizeType writePosition_{0};
+    /// The free-running read location.
+    AtomicSizeType readPosition_{0};
+
+    /// Decoded samples for each channel of the current block, owned by the consumer.
+    std::unique_ptr<std::int16_t[]> decoded_;
+    /// The number of audio frames in ``decoded_``.
+    SizeType decodedFrameCount_{0};
+    /// The number of audio frames in ``decoded_`` already read.
+    SizeType decodedOffset_{0};
+
+    /// Set by the producer to request a partial block be compressed.
+    std::atomic<bool> flushRequested_{false};
+
+    /// Helper thread state.
+    std::unique_ptr<Helper> helper_;
+
+    /// The format of the audio this buffer contains.
+    AudioStreamBasicDescription format_{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline CompressedAudioRingBuffer::operator bool() const noexcept { return helper_ != nullptr; }
+
+// MARK: Buffer Information
+
+inline const AudioStreamBasicDescription &CompressedAudioRingBuffer::format() const noexcept { return format_; }
+
+inline auto CompressedAudioRingBuffer::blockFrameCount() const noexcept -> SizeType { return blockFrameCount_; }
+
+inline auto CompressedAudioRingBuffer::compressedByteCapacity() const noexcept -> SizeType {
+    return compressedByteCapacity_;
+}
+
+// MARK: Buffer Usage
+
+inline auto CompressedAudioRingBuffer::freeSpace() const noexcept -> SizeType { return staging_.freeSpace(); }
+
+inline auto CompressedAudioRingBuffer::availableFrames() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return writePos - readPos;
+}
+
+inline auto CompressedAudioRingBuffer::compressedBytes() const noexcept -> SizeType {
+    // The consumer releases a block only after observing its end, so loading the read position first is sufficient
+    const auto readPos = compressedReadPosition_.load(std::memory_order_acquire);
+    const auto writePos = compressedWritePosition_.load(std::memory_order_acquire);
+    return writePos - readPos;
+}
+
+// MARK: Writing and Reading Audio
+
+inline auto CompressedAudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList,
+                                             SizeType frameCount) noexcept -> SizeType {
+    return staging_.write(bufferList, frameCount);
+}
+
+inline void CompressedAudioRingBuffer::flush() noexcept { flushRequested_.store(true, std::memory_order_release); }
+
+} /* namespace spsc */
@@ -0,0 +1,380 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+namespace spsc {
+
+/// A lock-free SPSC ring buffer supporting non-interleaved audio with an exact capacity.
+///
+/// Unlike ``AudioRingBuffer`` the capacity is not rounded to a power of two. Positions are kept on the interval
+/// [0, 2 × capacity) and wrapped with a comparison and conditional subtraction instead of a mask, so no memory is
+/// wasted at the cost of a few extra instructions per call.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class ExactAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = std::atomic<SizeType>;
+
+    /// The minimum supported buffer capacity in audio frames.
+    static constexpr SizeType minCapacity = SizeType{2};
+    /// The maximum supported buffer capacity in audio frames.
+    static constexpr SizeType maxCapacity = SizeType{1} << (std::numeric_limits<SizeType>::digits - 2);
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    ExactAudioRingBuffer() noexcept = default;
+
+    /// Creates a ring buffer with the specified format and audio frame capacity.
+    /// @note Only non-interleaved formats are supported.
+    /// @param format The format of the audio that will be written to and read from the buffer.
+    /// @param frameCapacity The capacity in audio frames.
+    /// @throw std::bad_alloc if memory could not be allocated or std::invalid_argument if the buffer capacity is not
+    /// supported.
+    ExactAudioRingBuffer(const AudioStreamBasicDescription &format, SizeType frameCapacity);
+
+    // This class is non-copyable
+    ExactAudioRingBuffer(const ExactAudioRingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    /// @note This method is not thread safe for the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    ExactAudioRingBuffer(ExactAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    ExactAudioRingBuffer &operator=(const ExactAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    ExactAudioRingBuffer &operator=(ExactAudioRingBuffer &&other) noexcept;
+
+    /// Destroys the ring buffer and releases all associated resources.
+    ~ExactAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for audio data of the specified format.
+    /// @note Only non-interleaved formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from this buffer.
+    /// @param frameCapacity The capacity in audio frames.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// buffer capacity is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType frameCapacity) noexcept;
+
+    /// Frees any space allocated for audio data.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the buffer has allocated space for audio data.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the format of the audio stored in the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The audio format of the buffer.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the capacity of the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The buffer capacity in audio frames.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the buffer.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of audio frames of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns true if the buffer is full.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return true if the buffer is full.
+    [[nodiscard]] bool isFull() const noexcept;
+
+    /// Returns the amount of audio in the buffer.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns true if the buffer is empty.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return true if the buffer contains no data.
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Writes audio and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads audio and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Advances the read position to the write position, emptying the buffer.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// Returns the number of audio frames between readPos and writePos.
+    [[nodiscard]] SizeType distance(SizeType writePos, SizeType readPos) const noexcept;
+    /// Returns the buffer index corresponding to position.
+    [[nodiscard]] SizeType bufferIndex(SizeType position) const noexcept;
+    /// Returns position advanced by frameCount, which must not exceed the capacity.
+    [[nodiscard]] SizeType advance(SizeType position, SizeType frameCount) const noexcept;
+
+    /// The memory buffers holding the data, consisting of channel pointers and buffers allocated in one chunk.
+    void *_Nonnull *_Nullable buffers_{nullptr};
+    /// The size of the allocation pointed to by ``buffers_`` in bytes.
+    SizeType allocationSize_{0};
+
+    /// The per-channel capacity of ``buffers_`` in audio frames.
+    SizeType capacity_{0};
+    /// Twice ``capacity_``, the period of the write and read positions.
+    SizeType positionLimit_{0};
+
+    /// The write location on the interval [0, 2 × capacity).
+    AtomicSizeType writePosition_{0};
+    /// The read location on the interval [0, 2 × capacity).
+    AtomicSizeType readPosition_{0};
+
+    static_assert(AtomicSizeType::is_always_lock_free, "Lock-free AtomicSizeType required");
+
+    /// The format of the audio this buffer contains.
+    AudioStreamBasicDescription format_{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline ExactAudioRingBuffer::operator bool() const noexcept { return buffers_ != nullptr; }
+
+// MARK: Buffer Information
+
+inline const AudioStreamBasicDescription &ExactAudioRingBuffer::format() const noexcept { return format_; }
+
+inline auto ExactAudioRingBuffer::capacity() const noexcept -> SizeType { return capacity_; }
+
+// MARK: Position Arithmetic
+
+inline auto ExactAudioRingBuffer::distance(SizeType writePos, SizeType readPos) const noexcept -> SizeType {
+    return writePos >= readPos ? writePos - readPos : writePos + positionLimit_ - readPos;
+}
+
+inline auto ExactAudioRingBuffer::bufferIndex(SizeType position) const noexcept -> SizeType {
+    return position >= capacity_ ? position - capacity_ : position;
+}
+
+inline auto ExactAudioRingBuffer::advance(SizeType position, SizeType frameCount) const noexcept -> SizeType {
+    const auto next = position + frameCount;
+    return next >= positionLimit_ ? next - positionLimit_ : next;
+}
+
+// MARK: Buffer Usage
+
+inline auto ExactAudioRingBuffer::freeSpace() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    const auto readPos = readPosition_.load(std::memory_order_acquire);
+    return capacity_ - distance(writePos, readPos);
+}
+
+inline bool ExactAudioRingBuffer::isFull() const noexcept {
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    const auto readPos = readPosition_.load(std::memory_order_acquire);
+    return distance(writePos, readPos) == capacity_;
+}
+
+inline auto ExactAudioRingBuffer::availableFrames() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return distance(writePos, readPos);
+}
+
+inline bool ExactAudioRingBuffer::isEmpty() const noexcept {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return writePos == readPos;
+}
+
+// MARK: Writing and Reading Audio
+
+inline auto ExactAudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || capacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    const auto readPos = readPosition_.load(std::memory_order_acquire);
+    const auto framesUsed = distance(writePos, readPos);
+    const auto framesFree = capacity_ - framesUsed;
+
+    if (framesFree == 0) [[unlikely]] {
+        return 0;
+    }
+
+    /// Copies non-interleaved audio to a buffer array from an AudioBufferList struct.
+    const auto copyToBuffersFromAudioBufferList = [](void *const _Nonnull *const _Nonnull dst, std::size_t dstOffset,
+                                                     const AudioBufferList *const _Nonnull src, std::size_t srcOffset,
+                                                     std::size_t byteCount) noexcept {
+        for (UInt32 i = 0; i < src->mNumberBuffers; ++i) {
+            assert(srcOffset + byteCount <= src->mBuffers[i].mDataByteSize);
+            std::memcpy(static_cast<unsigned char *>(dst[i]) + dstOffset,
+                        static_cast<const unsigned char *>(src->mBuffers[i].mData) + srcOffset, byteCount);
+        }
+    };
+
+    const auto framesToWrite = std::min(framesFree, frameCount);
+    const auto writeIndex = bufferIndex(writePos);
+    const auto framesToEnd = capacity_ - writeIndex;
+
+    if (framesToWrite <= framesToEnd) [[likely]] {
+        copyToBuffersFromAudioBufferList(buffers_, writeIndex * format_.mBytesPerFrame, bufferList, 0,
+                                         framesToWrite * format_.mBytesPerFrame);
+    } else [[unlikely]] {
+        const auto bytesToEnd = framesToEnd * format_.mBytesPerFrame;
+        copyToBuffersFromAudioBufferList(buffers_, writeIndex * format_.mBytesPerFrame, bufferList, 0, bytesToEnd);
+        copyToBuffersFromAudioBufferList(buffers_, 0, bufferList, bytesToEnd,
+                                         (framesToWrite - framesToEnd) * format_.mBytesPerFrame);
+    }
+
+    writePosition_.store(advance(writePos, framesToWrite), std::memory_order_release);
+    return framesToWrite;
+}
+
+inline auto ExactAudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || capacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = distance(writePos, readPos);
+
+    if (framesAvailable == 0) [[unlikely]] {
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
+        }
+        return 0;
+    }
+
+    /// Copies non-interleaved audio to an AudioBufferList struct from a buffer array.
+    const auto copyToAudioBufferListFromBuffers = [](AudioBufferList *const _Nonnull dst, std::size_t dstOffset,
+                                                     const void *const _Nonnull *const _Nonnull src,
+                                                     std::size_t srcOffset, std::size_t byteCount) noexcept {
+        for (UInt32 i = 0; i < dst->mNumberBuffers; ++i) {
+            assert(dstOffset + byteCount <= dst->mBuffers[i].mDataByteSize);
+            std::memcpy(static_cast<unsigned char *>(dst->mBuffers[i].mData) + dstOffset,
+                        static_cast<const unsigned char *>(src[i]) + srcOffset, byteCount);
+        }
+    };
+
+    const auto framesToRead = std::min(framesAvailable, frameCount);
+    const auto readIndex = bufferIndex(readPos);
+    const auto framesToEnd = capacity_ - readIndex;
+
+    if (framesToRead <= framesToEnd) [[likely]] {
+        copyToAudioBufferListFromBuffers(bufferList, 0, buffers_, readIndex * format_.mBytesPerFrame,
+                                         framesToRead * format_.mBytesPerFrame);
+    } else [[unlikely]] {
+        const auto bytesToEnd = framesToEnd * format_.mBytesPerFrame;
+        copyToAudioBufferListFromBuffers(bufferList, 0, buffers_, readIndex * format_.mBytesPerFrame, bytesToEnd);
+        copyToAudioBufferListFromBuffers(bufferList, bytesToEnd, buffers_, 0,
+                                         (framesToRead - framesToEnd) * format_.mBytesPerFrame);
+    }
+
+    readPosition_.store(advance(readPos, framesToRead), std::memory_order_release);
+
+    // Fill remainder with silence if fewer than requested frames read
+    if (framesToRead != frameCount) {
+        const auto byteOffset = framesToRead * format_.mBytesPerFrame;
+        const auto byteCount = (frameCount - framesToRead) * format_.mBytesPerFrame;
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(byteOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memset(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + byteOffset, 0, byteCount);
+        }
+    }
+
+    return framesToRead;
+}
+
+// MARK: Discarding Audio
+
+inline auto ExactAudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
+    if (frameCount == 0 || capacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = distance(writePos, readPos);
+
+    if (framesAvailable == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto framesToSkip = std::min(framesAvailable, frameCount);
+
+    readPosition_.store(advance(readPos, framesToSkip), std::memory_order_release);
+    return framesToSkip;
+}
+
+inline auto ExactAudioRingBuffer::drain() noexcept -> SizeType {
+    if (capacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = distance(writePos, readPos);
+
+    if (framesAvailable == 0) [[unlikely]] {
+        return 0;
+    }
+
+    readPosition_.store(writePos, std::memory_order_release);
+    return framesAvailable;
+}
+
+} /* namespace spsc */
@@ -0,0 +1,207 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "BitOperations.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace spsc {
+
+/// A lock-free window that accepts results tagged with sequence numbers in any order and releases them in order.
+///
+/// Workers processing blocks claimed from an ``AudioBlockQueue`` insert each result with the block's sequence number.
+/// A single consumer pops results strictly in sequence order. A result more than ``capacity`` positions ahead of the
+/// next one to be popped is refused until the window advances.
+///
+/// This class is thread safe when used with any number of inserting threads and a single consumer.
+/// @tparam T The result type, which must be default constructible and move assignable.
+template <typename T> class ReorderBuffer final {
+    static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
+    static_assert(std::is_nothrow_move_assignable_v<T>, "T must be nothrow move assignable");
+
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty reorder buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    ReorderBuffer() noexcept = default;
+
+    /// Creates a reorder buffer with the specified minimum window size.
+    /// @param minCapacity The desired minimum number of results held at once.
+    /// @throw std::bad_alloc if memory could not be allocated or std::invalid_argument if the capacity is not
+    /// supported.
+    explicit ReorderBuffer(SizeType minCapacity);
+
+    // This class is non-copyable
+    ReorderBuffer(const ReorderBuffer &) = delete;
+
+    /// Creates a reorder buffer by moving the contents of another reorder buffer.
+    /// @note This method is not thread safe for the reorder buffer being moved.
+    /// @param other The reorder buffer to move.
+    ReorderBuffer(ReorderBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    ReorderBuffer &operator=(const ReorderBuffer &) = delete;
+
+    /// Moves the contents of another reorder buffer into this reorder buffer.
+    /// @note This method is not thread safe.
+    /// @param other The reorder buffer to move.
+    ReorderBuffer &operator=(ReorderBuffer &&other) noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates the window.
+    ///
+    /// The actual capacity will be the smallest integral power of two that is not less than the specified minimum.
+    /// @note This method is not thread safe.
+    /// @param minCapacity The desired minimum number of results held at once.
+    /// @param firstSequence The sequence number of the first result to be popped.
+    /// @return true on success, false if memory could not be allocated or the capacity is not supported.
+    bool allocate(SizeType minCapacity, SizeType firstSequence = 0) noexcept;
+
+    /// Returns true if the window has been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Returns the number of results the window holds at once.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    /// Returns the sequence number of the next result to be popped.
+    [[nodiscard]] SizeType nextSequence() const noexcept;
+
+    // MARK: Inserting and Popping
+
+    /// Stores a result.
+    /// @note This method is safe to call from any number of threads, each with a distinct sequence number.
+    /// @param sequence The result's sequence number, which must not be less than ``nextSequence``.
+    /// @param value The result.
+    /// @return true on success, false if the sequence number is outside the window.
+    bool insert(SizeType sequence, T value) noexcept;
+
+    /// Removes the next result in sequence order.
+    /// @note This method is only safe to call from the consumer.
+    /// @param value Receives the result.
+    /// @return true on success, false if the next result has not been inserted.
+    bool pop(T &value) noexcept;
+
+  private:
+    /// One position in the window.
+    struct Slot {
+        /// The sequence number of the stored result plus one.
+        std::atomic<SizeType> tag{0};
+        /// The stored result.
+        T value{};
+    };
+
+    /// The largest supported capacity, which keeps sequence differences unambiguous.
+    static constexpr SizeType maxCapacity = SizeType{1} << (std::numeric_limits<SizeType>::digits - 2);
+
+    /// The window.
+    std::unique_ptr<Slot[]> slots_;
+    /// The number of slots.
+    SizeType capacity_{0};
+    /// The number of slots minus one.
+    SizeType capacityMask_{0};
+    /// The sequence number of the next result to be popped.
+    std::atomic<SizeType> next_{0};
+};
+
+// MARK: - Implementation -
+
+// MARK: Construction and Destruction
+
+template <typename T> inline ReorderBuffer<T>::ReorderBuffer(SizeType minCapacity) {
+    if (minCapacity < 2 || minCapacity > maxCapacity) [[unlikely]] {
+        throw std::invalid_argument("capacity out of range");
+    }
+    if (!allocate(minCapacity)) [[unlikely]] {
+        throw std::bad_alloc();
+    }
+}
+
+template <typename T>
+inline ReorderBuffer<T>::ReorderBuffer(ReorderBuffer &&other) noexcept
+    : slots_{std::move(other.slots_)}, capacity_{std::exchange(other.capacity_, 0)},
+      capacityMask_{std::exchange(other.capacityMask_, 0)},
+      next_{other.next_.exchange(0, std::memory_order_relaxed)} {}
+
+template <typename T> inline ReorderBuffer<T> &ReorderBuffer<T>::operator=(ReorderBuffer &&other) noexcept {
+    if (this != &other) [[likely]] {
+        slots_ = std::move(other.slots_);
+        capacity_ = std::exchange(other.capacity_, 0);
+        capacityMask_ = std::exchange(other.capacityMask_, 0);
+        next_.store(other.next_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+// MARK: Buffer Management
+
+template <typename T> inline bool ReorderBuffer<T>::allocate(SizeType minCapacity, SizeType firstSequence) noexcept {
+    if (minCapacity < 2 || minCapacity > maxCapacity) [[unlikely]] {
+        return false;
+    }
+
+    const auto capacity = detail::bit_ceil(minCapacity);
+    auto slots = std::unique_ptr<Slot[]>(new (std::nothrow) Slot[capacity]);
+    if (!slots) [[unlikely]] {
+        return false;
+    }
+
+    slots_ = std::move(slots);
+    capacity_ = capacity;
+    capacityMask_ = capacity - 1;
+    next_.store(firstSequence, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T> inline ReorderBuffer<T>::operator bool() const noexcept { return slots_ != nullptr; }
+
+template <typename T> inline auto ReorderBuffer<T>::capacity() const noexcept -> SizeType { return capacity_; }
+
+template <typename T> inline auto ReorderBuffer<T>::nextSequence() const noexcept -> SizeType {
+    return next_.load(std::memory_order_acquire);
+}
+
+// MARK: Inserting and Popping
+
+template <typename T> inline bool ReorderBuffer<T>::insert(SizeType sequence, T value) noexcept {
+    // Acquire pairs with the release in pop so the slot's previous result has been moved out
+    if (sequence - next_.load(std::memory_order_acquire) >= capacity_) [[unlikely]] {
+        return false;
+    }
+
+    auto &slot = slots_[sequence & capacityMask_];
+    slot.value = std::move(value);
+    slot.tag.store(sequence + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T> inline bool ReorderBuffer<T>::pop(T &value) noexcept {
+    const auto next = next_.load(std::memory_order_relaxed);
+    auto &slot = slots_[next & capacityMask_];
+    if (slot.tag.load(std::memory_order_acquire) != next + 1) {
+        return false;
+    }
+
+    value = std::move(slot.value);
+    next_.store(next + 1, std::memory_order_release);
+    return true;
+}
+
+} /* namespace spsc */
@@ -0,0 +1,354 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "BitOperations.hpp"
+#include "RingBufferIndex.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace spsc {
+
+/// A lock-free SPSC ring buffer of trivially copyable elements.
+///
+/// This class shares its position and wrap logic with ``AudioRingBuffer``.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+/// @tparam T The element type.
+template <typename T> class RingBuffer final {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned T is not supported");
+
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// A range of elements that may wrap around the end of the buffer.
+    using Region = detail::RingBufferIndex::Region;
+
+    /// The minimum supported buffer capacity in elements.
+    static constexpr SizeType minCapacity = SizeType{2};
+    /// The maximum supported buffer capacity in elements.
+    static constexpr SizeType maxCapacity = SizeType{1} << (std::numeric_limits<SizeType>::digits - 1);
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    RingBuffer() noexcept = default;
+
+    /// Creates a ring buffer with the specified minimum capacity.
+    ///
+    /// The actual buffer capacity will be the smallest integral power of two that is not less than the specified
+    /// minimum capacity.
+    /// @param minCapacity The desired minimum capacity in elements.
+    /// @throw std::bad_alloc if memory could not be allocated or std::invalid_argument if the buffer capacity is not
+    /// supported.
+    explicit RingBuffer(SizeType minCapacity);
+
+    // This class is non-copyable
+    RingBuffer(const RingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    /// @note This method is not thread safe for the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    RingBuffer(RingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    RingBuffer &operator=(RingBuffer &&other) noexcept;
+
+    /// Destroys the ring buffer and releases all associated resources.
+    ~RingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for elements.
+    ///
+    /// The actual buffer capacity will be the smallest integral power of two that is not less than the specified
+    /// minimum capacity. Any elements in the buffer are discarded.
+    /// @note This method is not thread safe.
+    /// @param minCapacity The desired minimum capacity in elements.
+    /// @return true on success, false if memory could not be allocated or the buffer capacity is not supported.
+    bool allocate(SizeType minCapacity) noexcept;
+
+    /// Frees any space allocated for elements.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the buffer has allocated space for elements.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the capacity of the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The buffer capacity in elements.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the buffer.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of elements of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns true if the buffer is full.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return true if the buffer is full.
+    [[nodiscard]] bool isFull() const noexcept;
+
+    /// Returns the number of elements in the buffer.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of elements available for reading.
+    [[nodiscard]] SizeType availableElements() const noexcept;
+
+    /// Returns true if the buffer is empty.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return true if the buffer contains no elements.
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // MARK: Writing and Reading Elements
+
+    /// Writes elements and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param elements The elements to copy.
+    /// @param count The desired number of elements to write.
+    /// @return The number of elements actually written.
+    SizeType push(const T *const _Nonnull elements, SizeType count) noexcept;
+
+    /// Writes one element and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param element The element to copy.
+    /// @return true if the element was written, false if the buffer is full.
+    bool push(const T &element) noexcept;
+
+    /// Reads elements and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param elements A buffer to receive the elements.
+    /// @param count The desired number of elements to read.
+    /// @return The number of elements actually read.
+    SizeType pop(T *const _Nonnull elements, SizeType count) noexcept;
+
+    /// Reads one element and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param element The element to receive the data.
+    /// @return true if an element was read, false if the buffer is empty.
+    bool pop(T &element) noexcept;
+
+    // MARK: Zero-Copy Access
+
+    /// Returns the element storage.
+    ///
+    /// The elements of a ``Region`` begin at `Region::index` and, if the region wraps, continue at the start of the
+    /// storage.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The element storage.
+    [[nodiscard]] T *_Nullable data() const noexcept;
+
+    /// Returns the free space to which up to count elements may be written in place.
+    /// @note This method is only safe to call from the producer.
+    /// @param count The desired number of elements.
+    /// @return A region holding no more than count elements.
+    [[nodiscard]] Region reserveWrite(SizeType count) const noexcept;
+
+    /// Advances the write position past elements written in place.
+    /// @note This method is only safe to call from the producer.
+    /// @param count The number of elements written, which must not exceed the size of the reserved region.
+    void commitWrite(SizeType count) noexcept;
+
+    /// Returns the elements from which up to count elements may be read in place.
+    /// @note This method is only safe to call from the consumer.
+    /// @param count The desired number of elements.
+    /// @return A region holding no more than count elements.
+    [[nodiscard]] Region reserveRead(SizeType count) const noexcept;
+
+    /// Advances the read position past elements read in place.
+    /// @note This method is only safe to call from the consumer.
+    /// @param count The number of elements read, which must not exceed the size of the reserved region.
+    void commitRead(SizeType count) noexcept;
+
+    // MARK: Discarding Elements
+
+    /// Skips elements and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param count The desired number of elements to skip.
+    /// @return The number of elements actually skipped.
+    SizeType skip(SizeType count) noexcept;
+
+    /// Advances the read position to the write position, emptying the buffer.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of elements discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// The element storage.
+    T *_Nullable buffer_{nullptr};
+    /// The capacity, write position, and read position of ``buffer_``.
+    detail::RingBufferIndex index_;
+};
+
+// MARK: - Implementation -
+
+// MARK: Construction and Destruction
+
+template <typename T> inline RingBuffer<T>::RingBuffer(SizeType minCapacity) {
+    if (minCapacity < RingBuffer::minCapacity || minCapacity > maxCapacity) [[unlikely]] {
+        throw std::invalid_argument("capacity out of range");
+    }
+    if (!allocate(minCapacity)) [[unlikely]] {
+        throw std::bad_alloc();
+    }
+}
+
+template <typename T>
+inline RingBuffer<T>::RingBuffer(RingBuffer &&other) noexcept
+    : buffer_{std::exchange(other.buffer_, nullptr)}, index_{std::move(other.index_)} {}
+
+template <typename T> inline RingBuffer<T> &RingBuffer<T>::operator=(RingBuffer &&other) noexcept {
+    if (this != &other) [[likely]] {
+        std::free(buffer_);
+        buffer_ = std::exchange(other.buffer_, nullptr);
+        index_ = std::move(other.index_);
+    }
+    return *this;
+}
+
+template <typename T> inline RingBuffer<T>::~RingBuffer() noexcept { std::free(buffer_); }
+
+// MARK: Buffer Management
+
+template <typename T> inline bool RingBuffer<T>::allocate(SizeType minCapacity) noexcept {
+    if (minCapacity < RingBuffer::minCapacity || minCapacity > maxCapacity) [[unlikely]] {
+        return false;
+    }
+
+    // Round to nearest power of two
+    const auto capacity = detail::bit_ceil(minCapacity);
+    if (capacity > std::numeric_limits<SizeType>::max() / sizeof(T)) [[unlikely]] {
+        return false;
+    }
+
+    deallocate();
+
+    buffer_ = static_cast<T *>(std::calloc(capacity, sizeof(T)));
+    if (buffer_ == nullptr) [[unlikely]] {
+        return false;
+    }
+
+    index_.reset(capacity);
+    return true;
+}
+
+template <typename T> inline void RingBuffer<T>::deallocate() noexcept {
+    if (buffer_) [[likely]] {
+        std::free(buffer_);
+        buffer_ = nullptr;
+        index_.reset(0);
+    }
+}
+
+template <typename T> inline RingBuffer<T>::operator bool() const noexcept { return buffer_ != nullptr; }
+
+// MARK: Buffer Information
+
+template <typename T> inline auto RingBuffer<T>::capacity() const noexcept -> SizeType { return index_.capacity(); }
+
+// MARK: Buffer Usage
+
+template <typename T> inline auto RingBuffer<T>::freeSpace() const noexcept -> SizeType { return index_.freeSpace(); }
+
+template <typename T> inline bool RingBuffer<T>::isFull() const noexcept { return index_.freeSpace() == 0; }
+
+template <typename T> inline auto RingBuffer<T>::availableElements() const noexcept -> SizeType {
+    return index_.availableElements();
+}
+
+template <typename T> inline bool RingBuffer<T>::isEmpty() const noexcept { return index_.availableElements() == 0; }
+
+// MARK: Writing and Reading Elements
+
+template <typename T>
+inline auto RingBuffer<T>::push(const T *const _Nonnull elements, SizeType count) noexcept -> SizeType {
+    if (elements == nullptr || count == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto region = index_.reserveWrite(count);
+    if (region.count() == 0) [[unlikely]] {
+        return 0;
+    }
+
+    std::memcpy(buffer_ + region.index, elements, region.firstCount * sizeof(T));
+    if (region.secondCount != 0) [[unlikely]] {
+        std::memcpy(buffer_, elements + region.firstCount, region.secondCount * sizeof(T));
+    }
+
+    index_.commitWrite(region.count());
+    return region.count();
+}
+
+template <typename T> inline bool RingBuffer<T>::push(const T &element) noexcept { return push(&element, 1) == 1; }
+
+template <typename T> inline auto RingBuffer<T>::pop(T *const _Nonnull elements, SizeType count) noexcept -> SizeType {
+    if (elements == nullptr || count == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto region = index_.reserveRead(count);
+    if (region.count() == 0) [[unlikely]] {
+        return 0;
+    }
+
+    std::memcpy(elements, buffer_ + region.index, region.firstCount * sizeof(T));
+    if (region.secondCount != 0) [[unlikely]] {
+        std::memcpy(elements + region.firstCount, buffer_, region.secondCount * sizeof(T));
+    }
+
+    index_.commitRead(region.count());
+    return region.count();
+}
+
+template <typename T> inline bool RingBuffer<T>::pop(T &element) noexcept { return pop(&element, 1) == 1; }
+
+// MARK: Zero-Copy Access
+
+template <typename T> inline T *_Nullable RingBuffer<T>::data() const noexcept { return buffer_; }
+
+template <typename T> inline auto RingBuffer<T>::reserveWrite(SizeType count) const noexcept -> Region {
+    return index_.reserveWrite(count);
+}
+
+template <typename T> inline void RingBuffer<T>::commitWrite(SizeType count) noexcept { index_.commitWrite(count); }
+
+template <typename T> inline auto RingBuffer<T>::reserveRead(SizeType count) const noexcept -> Region {
+    return index_.reserveRead(count);
+}
+
+template <typename T> inline void RingBuffer<T>::commitRead(SizeType count) noexcept { index_.commitRead(count); }
+
+// MARK: Discarding Elements
+
+template <typename T> inline auto RingBuffer<T>::skip(SizeType count) noexcept -> SizeType {
+    return index_.skip(count);
+}
+
+template <typename T> inline auto RingBuffer<T>::drain() noexcept -> SizeType { return index_.drain(); }
+
+} /* namespace spsc */
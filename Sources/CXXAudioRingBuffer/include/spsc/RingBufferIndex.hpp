@@ -0,0 +1,272 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace spsc::detail {
+
+/// The position and wrap logic shared by the SPSC ring buffers.
+///
+/// The write and read positions are free-running and masked to obtain an index into storage whose capacity is a power
+/// of two. The index does not own any storage; it tells its owner where to copy and publishes the result.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class RingBufferIndex final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = std::atomic<SizeType>;
+
+    /// A range of storage that may wrap around the end of the buffer.
+    struct Region {
+        /// The index of the first element of the region.
+        SizeType index{0};
+        /// The number of elements starting at ``index``.
+        SizeType firstCount{0};
+        /// The number of elements starting at index zero following the wrap.
+        SizeType secondCount{0};
+
+        /// Returns the total number of elements in the region.
+        [[nodiscard]] SizeType count() const noexcept { return firstCount + secondCount; }
+    };
+
+    // MARK: Construction and Destruction
+
+    /// Creates an index with zero capacity.
+    RingBufferIndex() noexcept = default;
+
+    /// Creates an empty index with the specified capacity.
+    /// @param capacity The storage capacity in elements, which must be zero or a power of two.
+    explicit constexpr RingBufferIndex(SizeType capacity) noexcept;
+
+    // This class is non-copyable
+    RingBufferIndex(const RingBufferIndex &) = delete;
+
+    /// Creates an index by moving the positions of another index.
+    /// @note This method is not thread safe for the index being moved.
+    RingBufferIndex(RingBufferIndex &&other) noexcept;
+
+    // This class is non-assignable
+    RingBufferIndex &operator=(const RingBufferIndex &) = delete;
+
+    /// Moves the positions of another index into this index.
+    /// @note This method is not thread safe.
+    RingBufferIndex &operator=(RingBufferIndex &&other) noexcept;
+
+    /// Sets the capacity and empties the buffer.
+    /// @note This method is not thread safe.
+    /// @param capacity The storage capacity in elements, which must be zero or a power of two.
+    void reset(SizeType capacity) noexcept;
+
+    // MARK: Information
+
+    /// Returns the storage capacity in elements.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    /// Returns the storage index corresponding to a position.
+    [[nodiscard]] SizeType wrap(SizeType position) const noexcept;
+
+    /// Returns the free-running write position.
+    /// @note The result of this method is only accurate when called from the producer.
+    [[nodiscard]] SizeType writePosition() const noexcept;
+
+    /// Returns the free-running read position.
+    /// @note The result of this method is only accurate when called from the consumer.
+    [[nodiscard]] SizeType readPosition() const noexcept;
+
+    // MARK: Usage
+
+    /// Returns the number of elements of free space.
+    /// @note The result of this method is only accurate when called from the producer.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns the number of elements available for reading.
+    /// @note The result of this method is only accurate when called from the consumer.
+    [[nodiscard]] SizeType availableElements() const noexcept;
+
+    // MARK: Writing
+
+    /// Returns the free space to which up to count elements may be written.
+    /// @note This method is only safe to call from the producer.
+    /// @param count The desired number of elements.
+    /// @return A region holding no more than count elements.
+    [[nodiscard]] Region reserveWrite(SizeType count) const noexcept;
+
+    /// Publishes elements written to a region returned by ``reserveWrite``.
+    /// @note This method is only safe to call from the producer.
+    /// @param count The number of elements written, which must not exceed the size of the reserved region.
+    void commitWrite(SizeType count) noexcept;
+
+    // MARK: Reading
+
+    /// Returns the elements from which up to count elements may be read.
+    /// @note This method is only safe to call from the consumer.
+    /// @param count The desired number of elements.
+    /// @return A region holding no more than count elements.
+    [[nodiscard]] Region reserveRead(SizeType count) const noexcept;
+
+    /// Releases elements read from a region returned by ``reserveRead`` back to the producer.
+    /// @note This method is only safe to call from the consumer.
+    /// @param count The number of elements read, which must not exceed the size of the reserved region.
+    void commitRead(SizeType count) noexcept;
+
+    /// Advances the read position by up to count elements.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of elements skipped.
+    SizeType skip(SizeType count) noexcept;
+
+    /// Advances the read position to the write position.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of elements discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// Returns the region of count elements starting at position.
+    [[nodiscard]] Region region(SizeType position, SizeType count) const noexcept;
+
+    /// The storage capacity in elements.
+    SizeType capacity_{0};
+    /// The storage capacity in elements minus one.
+    SizeType capacityMask_{0};
+
+    /// The free-running write location.
+    AtomicSizeType writePosition_{0};
+    /// The free-running read location.
+    AtomicSizeType readPosition_{0};
+
+    static_assert(AtomicSizeType::is_always_lock_free, "Lock-free AtomicSizeType required");
+};
+
+// MARK: - Implementation -
+
+// MARK: Construction and Destruction
+
+constexpr RingBufferIndex::RingBufferIndex(SizeType capacity) noexcept
+    : capacity_{capacity}, capacityMask_{capacity != 0 ? capacity - 1 : 0} {}
+
+inline RingBufferIndex::RingBufferIndex(RingBufferIndex &&other) noexcept
+    : capacity_{std::exchange(other.capacity_, 0)}, capacityMask_{std::exchange(other.capacityMask_, 0)},
+      writePosition_{other.writePosition_.exchange(0, std::memory_order_relaxed)},
+      readPosition_{other.readPosition_.exchange(0, std::memory_order_relaxed)} {}
+
+inline RingBufferIndex &RingBufferIndex::operator=(RingBufferIndex &&other) noexcept {
+    if (this != &other) [[likely]] {
+        capacity_ = std::exchange(other.capacity_, 0);
+        capacityMask_ = std::exchange(other.capacityMask_, 0);
+
+        writePosition_.store(other.writePosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        readPosition_.store(other.readPosition_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+inline void RingBufferIndex::reset(SizeType capacity) noexcept {
+    capacity_ = capacity;
+    capacityMask_ = capacity != 0 ? capacity - 1 : 0;
+
+    writePosition_.store(0, std::memory_order_relaxed);
+    readPosition_.store(0, std::memory_order_relaxed);
+}
+
+// MARK: Information
+
+inline auto RingBufferIndex::capacity() const noexcept -> SizeType { return capacity_; }
+
+inline auto RingBufferIndex::wrap(SizeType position) const noexcept -> SizeType { return position & capacityMask_; }
+
+inline auto RingBufferIndex::writePosition() const noexcept -> SizeType {
+    return writePosition_.load(std::memory_order_relaxed);
+}
+
+inline auto RingBufferIndex::readPosition() const noexcept -> SizeType {
+    return readPosition_.load(std::memory_order_relaxed);
+}
+
+// MARK: Usage
+
+inline auto RingBufferIndex::freeSpace() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    const auto readPos = readPosition_.load(std::memory_order_acquire);
+    return capacity_ - (writePos - readPos);
+}
+
+inline auto RingBufferIndex::availableElements() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return writePos - readPos;
+}
+
+// MARK: Writing
+
+inline auto RingBufferIndex::region(SizeType position, SizeType count) const noexcept -> Region {
+    const auto index = position & capacityMask_;
+    const auto countToEnd = capacity_ - index;
+
+    if (count <= countToEnd) [[likely]] {
+        return {index, count, 0};
+    }
+    return {index, countToEnd, count - countToEnd};
+}
+
+inline auto RingBufferIndex::reserveWrite(SizeType count) const noexcept -> Region {
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    const auto readPos = readPosition_.load(std::memory_order_acquire);
+    const auto countFree = capacity_ - (writePos - readPos);
+    return region(writePos, std::min(countFree, count));
+}
+
+inline void RingBufferIndex::commitWrite(SizeType count) noexcept {
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+    writePosition_.store(writePos + count, std::memory_order_release);
+}
+
+// MARK: Reading
+
+inline auto RingBufferIndex::reserveRead(SizeType count) const noexcept -> Region {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto countAvailable = writePos - readPos;
+    return region(readPos, std::min(countAvailable, count));
+}
+
+inline void RingBufferIndex::commitRead(SizeType count) noexcept {
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    readPosition_.store(readPos + count, std::memory_order_release);
+}
+
+inline auto RingBufferIndex::skip(SizeType count) noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto countToSkip = std::min(writePos - readPos, count);
+
+    if (countToSkip == 0) [[unlikely]] {
+        return 0;
+    }
+
+    readPosition_.store(readPos + countToSkip, std::memory_order_release);
+    return countToSkip;
+}
+
+inline auto RingBufferIndex::drain() noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+
+    if (writePos == readPos) [[unlikely]] {
+        return 0;
+    }
+
+    readPosition_.store(writePos, std::memory_order_release);
+    return writePos - readPos;
+}
+
+} /* namespace spsc::detail */
@@ -0,0 +1,235 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace spsc {
+
+/// A lock-free SPSC ring buffer supporting non-interleaved audio that overflows to a temporary file.
+///
+/// Audio written by the producer is staged in an input ring and moved by a helper thread to an output ring read by the
+/// consumer. If the consumer stalls and the free space in the input ring drops below a threshold, the helper thread
+/// moves the oldest audio to a temporary file instead and later reads it back into the output ring ahead of newer
+/// audio. Memory use is bounded by the two rings while the backlog is bounded only by disk space. Consumed audio at the
+/// start of the file is periodically discarded, so the file stays proportional to the backlog.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class SpillingAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The default interval at which the helper thread moves audio.
+    static constexpr std::chrono::microseconds defaultHelperInterval = std::chrono::milliseconds{2};
+    /// The default size in bytes of the consumed part of the temporary file above which it is compacted.
+    static constexpr SizeType defaultCompactionThreshold = SizeType{16} << 20;
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    SpillingAudioRingBuffer() noexcept;
+
+    // This class is non-copyable
+    SpillingAudioRingBuffer(const SpillingAudioRingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    ///
+    /// A running helper thread is paused between passes and continues with this ring buffer.
+    /// @note This method is not thread safe for the producer and consumer of the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    SpillingAudioRingBuffer(SpillingAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    SpillingAudioRingBuffer &operator=(const SpillingAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    SpillingAudioRingBuffer &operator=(SpillingAudioRingBuffer &&other) noexcept;
+
+    /// Stops the helper thread and releases all associated resources.
+    ~SpillingAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates space for audio data of the specified format and starts the helper thread.
+    ///
+    /// The input and output rings each have the capacity ``AudioRingBuffer`` would choose for `minFrameCapacity`.
+    /// The output ring should hold at least as many frames as the consumer reads during one helper interval.
+    /// @note Only non-interleaved formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from this buffer.
+    /// @param minFrameCapacity The desired minimum capacity in audio frames of each in-memory ring.
+    /// @param spillThreshold The free space in audio frames below which the oldest staged audio is moved to disk.
+    /// @param helperInterval The interval at which the helper thread moves audio.
+    /// @param compactionThreshold The size in bytes of the consumed part of the temporary file above which, once it is
+    /// also at least as large as the unconsumed part, the unconsumed audio is moved to the start and the file truncated.
+    /// @return true on success, false if memory or the temporary file could not be allocated, the audio format is not
+    /// supported, the buffer capacity is not supported, or `spillThreshold` exceeds the ring capacity.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity, SizeType spillThreshold,
+                  std::chrono::microseconds helperInterval = defaultHelperInterval,
+                  SizeType compactionThreshold = defaultCompactionThreshold) noexcept;
+
+    /// Stops the helper thread and frees any space allocated for audio data.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the buffer has allocated space for audio data.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the format of the audio stored in the buffer.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The audio format of the buffer.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the capacity of each in-memory ring.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The ring capacity in audio frames.
+    [[nodiscard]] SizeType capacity() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the input ring.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of audio frames of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns the amount of audio ready for reading in the output ring.
+    ///
+    /// Audio still staged in the input ring or stored on disk is not included.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns the amount of audio currently stored on disk.
+    /// @note This method is safe to call from any thread.
+    /// @return The number of audio frames in the temporary file.
+    [[nodiscard]] SizeType spilledFrames() const noexcept;
+
+    /// Returns true if writing to the temporary file failed.
+    ///
+    /// Audio in a chunk that could not be written is lost and no further audio is moved to disk.
+    /// @note This method is safe to call from any thread.
+    /// @return true if a disk error occurred.
+    [[nodiscard]] bool spillFailed() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Writes audio to the input ring and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads audio from the output ring and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio in the output ring and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Empties the output ring.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// State owned by the helper thread.
+    struct Helper;
+
+    /// Moves audio between the rings and the temporary file.
+    /// @note This method is only called from the helper thread.
+    void pump() noexcept;
+
+    /// Ring written by the producer and read by the helper thread.
+    AudioRingBuffer input_;
+    /// Ring written by the helper thread and read by the consumer.
+    AudioRingBuffer output_;
+
+    /// Free space in ``input_`` below which audio is moved to disk.
+    SizeType spillThreshold_{0};
+
+    /// The number of audio frames stored on disk, including a partially consumed chunk.
+    std::atomic<SizeType> spilledFrames_{0};
+    /// Set if writing to the temporary file failed.
+    std::atomic<bool> spillFailed_{false};
+
+    /// Helper thread state.
+    std::unique_ptr<Helper> helper_;
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline SpillingAudioRingBuffer::operator bool() const noexcept { return helper_ != nullptr; }
+
+// MARK: Buffer Information
+
+inline const AudioStreamBasicDescription &SpillingAudioRingBuffer::format() const noexcept { return input_.format(); }
+
+inline auto SpillingAudioRingBuffer::capacity() const noexcept -> SizeType { return input_.capacity(); }
+
+// MARK: Buffer Usage
+
+inline auto SpillingAudioRingBuffer::freeSpace() const noexcept -> SizeType { return input_.freeSpace(); }
+
+inline auto SpillingAudioRingBuffer::availableFrames() const noexcept -> SizeType { return output_.availableFrames(); }
+
+inline auto SpillingAudioRingBuffer::spilledFrames() const noexcept -> SizeType {
+    return spilledFrames_.load(std::memory_order_relaxed);
+}
+
+inline bool SpillingAudioRingBuffer::spillFailed() const noexcept {
+    return spillFailed_.load(std::memory_order_relaxed);
+}
+
+// MARK: Writing and Reading Audio
+
+inline auto SpillingAudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList,
+                                           SizeType frameCount) noexcept -> SizeType {
+    return input_.write(bufferList, frameCount);
+}
+
+inline auto SpillingAudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    return output_.read(bufferList, frameCount);
+}
+
+// MARK: Discarding Audio
+
+inline auto SpillingAudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
+    return output_.skip(frameCount);
+}
+
+inline auto SpillingAudioRingBuffer::drain() noexcept -> SizeType { return output_.drain(); }
+
+} /* namespace spsc */
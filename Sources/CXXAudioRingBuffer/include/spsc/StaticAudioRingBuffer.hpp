@@ -0,0 +1,258 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "RingBufferIndex.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace spsc {
+
+/// A lock-free SPSC ring buffer supporting non-interleaved audio with storage held inline.
+///
+/// The sample type, channel count, and capacity are fixed at compile time so the object never allocates and the
+/// channel buffers are addressed by offset from `this` rather than through a table of pointers. An instance may be
+/// placed in static storage or embedded in another object.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+/// @tparam Sample The type of one sample of one channel.
+/// @tparam Channels The number of channels.
+/// @tparam Capacity The capacity in audio frames, which must be a power of two.
+template <typename Sample, UInt32 Channels, std::size_t Capacity> class StaticAudioRingBuffer final {
+    static_assert(std::is_trivially_copyable_v<Sample>, "Sample must be trivially copyable");
+    static_assert(Channels > 0, "Channels must be greater than zero");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = std::atomic<SizeType>;
+
+    /// The number of channels.
+    static constexpr UInt32 channelCount = Channels;
+    /// The buffer capacity in audio frames.
+    static constexpr SizeType capacity = Capacity;
+    /// The number of bytes in one frame of one channel.
+    static constexpr SizeType bytesPerFrame = sizeof(Sample);
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty ring buffer.
+    constexpr StaticAudioRingBuffer() noexcept = default;
+
+    // This class is non-copyable
+    StaticAudioRingBuffer(const StaticAudioRingBuffer &) = delete;
+
+    /// Creates a ring buffer by moving the contents of another ring buffer.
+    ///
+    /// Because the storage is held inline the audio is copied, and the other ring buffer is left empty.
+    /// @note This method is not thread safe for the ring buffer being moved.
+    /// @param other The ring buffer to move.
+    StaticAudioRingBuffer(StaticAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    StaticAudioRingBuffer &operator=(const StaticAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another ring buffer into this ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The ring buffer to move.
+    StaticAudioRingBuffer &operator=(StaticAudioRingBuffer &&other) noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of free space in the buffer.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return The number of audio frames of free space available for writing.
+    [[nodiscard]] SizeType freeSpace() const noexcept;
+
+    /// Returns true if the buffer is full.
+    /// @note The result of this method is only accurate when called from the producer.
+    /// @return true if the buffer is full.
+    [[nodiscard]] bool isFull() const noexcept;
+
+    /// Returns the amount of audio in the buffer.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns true if the buffer is empty.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return true if the buffer contains no data.
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Writes audio and advances the write position.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing ``channelCount`` buffers of `Sample` data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads audio and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list containing ``channelCount`` buffers to receive `Sample` data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Advances the read position to the write position, emptying the buffer.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// The byte size of one channel buffer.
+    static constexpr SizeType channelStride = Capacity * bytesPerFrame;
+
+    /// The write and read positions of ``storage_`` in audio frames.
+    detail::RingBufferIndex index_{Capacity};
+
+    /// The channel buffers, stored contiguously ``channelStride`` bytes apart.
+    alignas(64) unsigned char storage_[Channels][channelStride]{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Construction and Destruction
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline StaticAudioRingBuffer<Sample, Channels, Capacity>::StaticAudioRingBuffer(StaticAudioRingBuffer &&other) noexcept
+    : index_{std::move(other.index_)} {
+    std::memcpy(storage_, other.storage_, sizeof storage_);
+    other.index_.reset(Capacity);
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::operator=(StaticAudioRingBuffer &&other) noexcept
+        -> StaticAudioRingBuffer & {
+    if (this != &other) [[likely]] {
+        index_ = std::move(other.index_);
+        std::memcpy(storage_, other.storage_, sizeof storage_);
+        other.index_.reset(Capacity);
+    }
+    return *this;
+}
+
+// MARK: Buffer Usage
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::freeSpace() const noexcept -> SizeType {
+    return index_.freeSpace();
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline bool StaticAudioRingBuffer<Sample, Channels, Capacity>::isFull() const noexcept {
+    return index_.freeSpace() == 0;
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::availableFrames() const noexcept -> SizeType {
+    return index_.availableElements();
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline bool StaticAudioRingBuffer<Sample, Channels, Capacity>::isEmpty() const noexcept {
+    return index_.availableElements() == 0;
+}
+
+// MARK: Writing and Reading Audio
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::write(const AudioBufferList *const _Nonnull bufferList,
+                                                                     SizeType frameCount) noexcept -> SizeType {
+    if (bufferList == nullptr || frameCount == 0) [[unlikely]] {
+        return 0;
+    }
+    assert(bufferList->mNumberBuffers == Channels);
+
+    const auto region = index_.reserveWrite(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        return 0;
+    }
+
+    for (UInt32 i = 0; i < Channels; ++i) {
+        assert(region.count() * bytesPerFrame <= bufferList->mBuffers[i].mDataByteSize);
+        const auto src = static_cast<const unsigned char *>(bufferList->mBuffers[i].mData);
+        std::memcpy(storage_[i] + region.index * bytesPerFrame, src, region.firstCount * bytesPerFrame);
+        if (region.secondCount != 0) [[unlikely]] {
+            std::memcpy(storage_[i], src + region.firstCount * bytesPerFrame, region.secondCount * bytesPerFrame);
+        }
+    }
+
+    index_.commitWrite(region.count());
+    return region.count();
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::read(AudioBufferList *const _Nonnull bufferList,
+                                                                    SizeType frameCount) noexcept -> SizeType {
+    if (bufferList == nullptr || frameCount == 0) [[unlikely]] {
+        return 0;
+    }
+    assert(bufferList->mNumberBuffers == Channels);
+
+    const auto region = index_.reserveRead(frameCount);
+    if (region.count() == 0) [[unlikely]] {
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
+        }
+        return 0;
+    }
+
+    const auto framesToRead = region.count();
+    for (UInt32 i = 0; i < Channels; ++i) {
+        assert(frameCount * bytesPerFrame <= bufferList->mBuffers[i].mDataByteSize);
+        const auto dst = static_cast<unsigned char *>(bufferList->mBuffers[i].mData);
+        std::memcpy(dst, storage_[i] + region.index * bytesPerFrame, region.firstCount * bytesPerFrame);
+        if (region.secondCount != 0) [[unlikely]] {
+            std::memcpy(dst + region.firstCount * bytesPerFrame, storage_[i], region.secondCount * bytesPerFrame);
+        }
+        // Fill remainder with silence if fewer than requested frames read
+        if (framesToRead != frameCount) [[unlikely]] {
+            std::memset(dst + framesToRead * bytesPerFrame, 0, (frameCount - framesToRead) * bytesPerFrame);
+        }
+    }
+
+    index_.commitRead(framesToRead);
+    return framesToRead;
+}
+
+// MARK: Discarding Audio
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::skip(SizeType frameCount) noexcept -> SizeType {
+    return index_.skip(frameCount);
+}
+
+template <typename Sample, UInt32 Channels, std::size_t Capacity>
+inline auto StaticAudioRingBuffer<Sample, Channels, Capacity>::drain() noexcept -> SizeType {
+    return index_.drain();
+}
+
+} /* namespace spsc */
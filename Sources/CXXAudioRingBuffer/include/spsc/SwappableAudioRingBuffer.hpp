@@ -0,0 +1,168 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "AudioRingBuffer.hpp"
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace spsc {
+
+/// An ``AudioRingBuffer`` that may be replaced while the producer and consumer are running.
+///
+/// A non-realtime thread calls ``reconfigure`` to allocate a new ring buffer and publish it. The producer switches to
+/// the newest ring buffer the next time it calls ``producerBuffer``. The consumer finishes reading the audio left in
+/// the ring buffer it was using and then switches in ``consumerBuffer``. Neither call allocates or frees memory.
+///
+/// Each ring buffer is tagged with an epoch and the producer and consumer each publish the epoch of the ring buffer they
+/// are using. A ring buffer older than both is no longer reachable and is freed by a reclaimer thread.
+///
+/// This class is thread safe when used with a single producer, a single consumer, and any number of threads calling
+/// ``reconfigure``.
+class SwappableAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = AudioRingBuffer::SizeType;
+
+    /// The default interval at which the reclaimer thread frees retired ring buffers.
+    static constexpr std::chrono::microseconds defaultReclaimInterval = std::chrono::milliseconds{10};
+    /// A reclaim interval that starts no reclaimer thread, leaving retired ring buffers to ``reclaim``.
+    static constexpr std::chrono::microseconds manualReclaimInterval = std::chrono::microseconds::zero();
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty swappable ring buffer.
+    /// @note ``allocate`` must be called before the object may be used.
+    SwappableAudioRingBuffer() noexcept;
+
+    // This class is non-copyable
+    SwappableAudioRingBuffer(const SwappableAudioRingBuffer &) = delete;
+
+    /// Creates a swappable ring buffer by moving the contents of another swappable ring buffer.
+    ///
+    /// A running reclaimer thread is paused between passes and continues with this swappable ring buffer.
+    /// @note This method is not thread safe for the producer, consumer, and reconfiguring threads of the swappable ring
+    /// buffer being moved.
+    /// @param other The swappable ring buffer to move.
+    SwappableAudioRingBuffer(SwappableAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    SwappableAudioRingBuffer &operator=(const SwappableAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another swappable ring buffer into this swappable ring buffer.
+    /// @note This method is not thread safe.
+    /// @param other The swappable ring buffer to move.
+    SwappableAudioRingBuffer &operator=(SwappableAudioRingBuffer &&other) noexcept;
+
+    /// Stops the reclaimer thread and releases all associated resources.
+    ~SwappableAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates the initial ring buffer and starts the reclaimer thread.
+    /// @note Only non-interleaved formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from the initial ring buffer.
+    /// @param minFrameCapacity The desired minimum capacity in audio frames.
+    /// @param reclaimInterval The interval at which the reclaimer thread frees retired ring buffers, or
+    /// ``manualReclaimInterval`` to start no reclaimer thread.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// buffer capacity is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType minFrameCapacity,
+                  std::chrono::microseconds reclaimInterval = defaultReclaimInterval) noexcept;
+
+    /// Stops the reclaimer thread and frees all ring buffers.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the initial ring buffer has been allocated.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    // MARK: Reconfiguration
+
+    /// Allocates a ring buffer and publishes it to the producer and consumer.
+    ///
+    /// The ring buffer in use is retired once the producer has switched away from it and the consumer has read the
+    /// audio it contains.
+    /// @note This method allocates memory and must not be called from a realtime thread.
+    /// @param format The format of the audio that will be written to and read from the new ring buffer.
+    /// @param minFrameCapacity The desired minimum capacity in audio frames.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, the buffer
+    /// capacity is not supported, or ``allocate`` has not been called.
+    bool reconfigure(const AudioStreamBasicDescription &format, SizeType minFrameCapacity) noexcept;
+
+    /// Frees retired ring buffers that neither the producer nor the consumer can still reach.
+    ///
+    /// This is called periodically by the reclaimer thread, if one was started.
+    /// @note This method frees memory and must not be called from a realtime thread.
+    /// @return The number of ring buffers freed.
+    SizeType reclaim() noexcept;
+
+    // MARK: Access
+
+    /// Returns the ring buffer the producer should write to, switching to the newest ring buffer if one was published.
+    ///
+    /// Call this once at the start of each producer cycle and use the result until the cycle ends.
+    /// @note This method is only safe to call from the producer.
+    /// @return The producer's ring buffer or nullptr if ``allocate`` has not been called.
+    AudioRingBuffer *_Nullable producerBuffer() noexcept;
+
+    /// Returns the ring buffer the consumer should read from.
+    ///
+    /// The consumer moves to a newer ring buffer only after the producer has switched away from the current one and
+    /// the consumer has read or drained everything left in it. To discard stale audio immediately, call
+    /// ``AudioRingBuffer::drain`` on the returned ring buffer; the switch then happens on the next call.
+    ///
+    /// Call this once at the start of each consumer cycle and use the result until the cycle ends.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The consumer's ring buffer or nullptr if ``allocate`` has not been called.
+    AudioRingBuffer *_Nullable consumerBuffer() noexcept;
+
+  private:
+    /// A published ring buffer.
+    struct Node;
+    /// State owned by the reclaimer thread.
+    struct Reclaimer;
+
+    /// Serializes ``reconfigure``, ``reclaim``, and access to ``oldest_``.
+    std::mutex mutex_;
+    /// The oldest ring buffer not yet freed, the head of the chain linked through ``Node::next``.
+    Node *_Nullable oldest_{nullptr};
+    /// The epoch assigned to the most recently published ring buffer.
+    std::uint64_t epoch_{0};
+
+    /// The most recently published ring buffer.
+    std::atomic<Node *> latest_{nullptr};
+
+    /// The ring buffer used by the producer.
+    Node *_Nullable producerNode_{nullptr};
+    /// The epoch of ``producerNode_``.
+    std::atomic<std::uint64_t> producerEpoch_{0};
+
+    /// The ring buffer used by the consumer.
+    Node *_Nullable consumerNode_{nullptr};
+    /// The epoch of ``consumerNode_``.
+    std::atomic<std::uint64_t> consumerEpoch_{0};
+
+    /// Reclaimer thread state.
+    std::unique_ptr<Reclaimer> reclaimer_;
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline SwappableAudioRingBuffer::operator bool() const noexcept { return reclaimer_ != nullptr; }
+
+} /* namespace spsc */
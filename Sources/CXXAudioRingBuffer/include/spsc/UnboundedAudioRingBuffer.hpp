@@ -0,0 +1,403 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include <CoreAudioTypes/CoreAudioTypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+namespace spsc {
+
+/// A lock-free SPSC queue supporting non-interleaved audio that grows as needed.
+///
+/// Audio is stored in a chain of fixed-capacity segments. When the segment being written is full the producer links
+/// another one, reusing a segment the consumer has finished with when possible and allocating only when none is
+/// available. Memory use therefore tracks the backlog instead of a worst-case capacity.
+///
+/// This class is thread safe when used with a single producer and a single consumer.
+class UnboundedAudioRingBuffer final {
+  public:
+    /// Unsigned integer type.
+    using SizeType = std::size_t;
+    /// Atomic unsigned integer type.
+    using AtomicSizeType = std::atomic<SizeType>;
+
+    /// The minimum supported segment capacity in audio frames.
+    static constexpr SizeType minSegmentCapacity = SizeType{1};
+    /// The maximum supported segment capacity in audio frames.
+    static constexpr SizeType maxSegmentCapacity = SizeType{1} << (std::numeric_limits<SizeType>::digits - 1);
+
+    // MARK: Construction and Destruction
+
+    /// Creates an empty queue.
+    /// @note ``allocate`` must be called before the object may be used.
+    UnboundedAudioRingBuffer() noexcept = default;
+
+    /// Creates a queue with the specified format and segment capacity.
+    /// @note Only non-interleaved formats are supported.
+    /// @param format The format of the audio that will be written to and read from the queue.
+    /// @param segmentFrameCapacity The capacity of each segment in audio frames.
+    /// @throw std::bad_alloc if memory could not be allocated or std::invalid_argument if the segment capacity is not
+    /// supported.
+    UnboundedAudioRingBuffer(const AudioStreamBasicDescription &format, SizeType segmentFrameCapacity);
+
+    // This class is non-copyable
+    UnboundedAudioRingBuffer(const UnboundedAudioRingBuffer &) = delete;
+
+    /// Creates a queue by moving the contents of another queue.
+    /// @note This method is not thread safe for the queue being moved.
+    /// @param other The queue to move.
+    UnboundedAudioRingBuffer(UnboundedAudioRingBuffer &&other) noexcept;
+
+    // This class is non-assignable
+    UnboundedAudioRingBuffer &operator=(const UnboundedAudioRingBuffer &) = delete;
+
+    /// Moves the contents of another queue into this queue.
+    /// @note This method is not thread safe.
+    /// @param other The queue to move.
+    UnboundedAudioRingBuffer &operator=(UnboundedAudioRingBuffer &&other) noexcept;
+
+    /// Destroys the queue and releases all associated resources.
+    ~UnboundedAudioRingBuffer() noexcept;
+
+    // MARK: Buffer Management
+
+    /// Allocates the first segment for audio data of the specified format.
+    /// @note Only non-interleaved formats are supported.
+    /// @note This method is not thread safe.
+    /// @param format The format of the audio that will be written to and read from this queue.
+    /// @param segmentFrameCapacity The capacity of each segment in audio frames.
+    /// @return true on success, false if memory could not be allocated, the audio format is not supported, or the
+    /// segment capacity is not supported.
+    bool allocate(const AudioStreamBasicDescription &format, SizeType segmentFrameCapacity) noexcept;
+
+    /// Frees all segments.
+    /// @note This method is not thread safe.
+    void deallocate() noexcept;
+
+    /// Returns true if the queue has allocated space for audio data.
+    [[nodiscard]] explicit operator bool() const noexcept;
+
+    /// Ensures the specified number of audio frames may be written without allocating memory.
+    /// @note This method is only safe to call from the producer.
+    /// @param frameCount The number of audio frames to make room for.
+    /// @return true on success, false if memory could not be allocated.
+    bool reserve(SizeType frameCount) noexcept;
+
+    /// Frees reserved segments and segments the consumer has finished with.
+    /// @note This method is only safe to call from the producer.
+    /// @return The number of segments freed.
+    SizeType trim() noexcept;
+
+    // MARK: Buffer Information
+
+    /// Returns the format of the audio stored in the queue.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The audio format of the queue.
+    [[nodiscard]] const AudioStreamBasicDescription &format() const noexcept;
+
+    /// Returns the capacity of each segment.
+    /// @note This method is safe to call from both producer and consumer.
+    /// @return The segment capacity in audio frames.
+    [[nodiscard]] SizeType segmentCapacity() const noexcept;
+
+    /// Returns the number of segments owned by the queue.
+    /// @note This method is only safe to call from the producer.
+    /// @return The number of allocated segments.
+    [[nodiscard]] SizeType segmentCount() const noexcept;
+
+    // MARK: Buffer Usage
+
+    /// Returns the amount of audio in the queue.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return The number of audio frames available for reading.
+    [[nodiscard]] SizeType availableFrames() const noexcept;
+
+    /// Returns true if the queue is empty.
+    /// @note The result of this method is only accurate when called from the consumer.
+    /// @return true if the queue contains no data.
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // MARK: Writing and Reading Audio
+
+    /// Writes audio and advances the write position.
+    ///
+    /// If no recycled or reserved segment is available when one is needed a new segment is allocated.
+    /// @note This method is only safe to call from the producer.
+    /// @param bufferList An audio buffer list containing the data to copy.
+    /// @param frameCount The desired number of audio frames to write.
+    /// @return The number of audio frames actually written, which is less than `frameCount` only if memory could not
+    /// be allocated.
+    SizeType write(const AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    /// Reads audio and advances the read position.
+    ///
+    /// If fewer than the requested number of frames are available the remainder of the audio buffer list will be set to
+    /// zero.
+    /// @note This method is only safe to call from the consumer.
+    /// @param bufferList An audio buffer list to receive the data.
+    /// @param frameCount The desired number of audio frames to read.
+    /// @return The number of audio frames actually read.
+    SizeType read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept;
+
+    // MARK: Discarding Audio
+
+    /// Skips audio and advances the read position.
+    /// @note This method is only safe to call from the consumer.
+    /// @param frameCount The desired number of audio frames to skip.
+    /// @return The number of audio frames actually skipped.
+    SizeType skip(SizeType frameCount) noexcept;
+
+    /// Advances the read position to the write position, emptying the queue.
+    /// @note This method is only safe to call from the consumer.
+    /// @return The number of audio frames discarded.
+    SizeType drain() noexcept;
+
+  private:
+    /// A fixed-capacity block of audio frames.
+    struct Segment {
+        /// The next segment in the chain.
+        std::atomic<Segment *> next{nullptr};
+        /// The channel buffers, allocated in the same chunk as the segment.
+        void *_Nonnull *_Nonnull buffers{nullptr};
+    };
+
+    /// Allocates a segment for the current format and segment capacity.
+    [[nodiscard]] Segment *_Nullable allocateSegment() const noexcept;
+
+    /// Returns a segment that may be linked as the tail, allocating one if necessary.
+    /// @note This method is only safe to call from the producer.
+    [[nodiscard]] Segment *_Nullable acquireSegment() noexcept;
+
+    /// Advances the consumer past the segment being read if it is exhausted.
+    /// @note This method is only safe to call from the consumer.
+    Segment *_Nonnull consumerSegment() noexcept;
+
+    /// The oldest segment in the chain; segments from here up to ``head_`` are reusable.
+    Segment *_Nullable first_{nullptr};
+    /// The segment being written.
+    Segment *_Nullable tail_{nullptr};
+    /// Reserved segments not yet linked into the chain.
+    Segment *_Nullable spare_{nullptr};
+    /// The number of audio frames written to ``tail_``.
+    SizeType tailOffset_{0};
+    /// The number of segments owned by the queue.
+    SizeType segmentCount_{0};
+
+    /// The segment being read.
+    std::atomic<Segment *> head_{nullptr};
+    /// The number of audio frames read from ``head_``.
+    SizeType headOffset_{0};
+
+    /// The capacity of each segment in audio frames.
+    SizeType segmentCapacity_{0};
+
+    /// The free-running write location.
+    AtomicSizeType writePosition_{0};
+    /// The free-running read location.
+    AtomicSizeType readPosition_{0};
+
+    static_assert(AtomicSizeType::is_always_lock_free, "Lock-free AtomicSizeType required");
+    static_assert(std::atomic<Segment *>::is_always_lock_free, "Lock-free segment pointer required");
+
+    /// The format of the audio this queue contains.
+    AudioStreamBasicDescription format_{};
+};
+
+// MARK: - Implementation -
+
+// MARK: Buffer Management
+
+inline UnboundedAudioRingBuffer::operator bool() const noexcept { return tail_ != nullptr; }
+
+// MARK: Buffer Information
+
+inline const AudioStreamBasicDescription &UnboundedAudioRingBuffer::format() const noexcept { return format_; }
+
+inline auto UnboundedAudioRingBuffer::segmentCapacity() const noexcept -> SizeType { return segmentCapacity_; }
+
+inline auto UnboundedAudioRingBuffer::segmentCount() const noexcept -> SizeType { return segmentCount_; }
+
+// MARK: Buffer Usage
+
+inline auto UnboundedAudioRingBuffer::availableFrames() const noexcept -> SizeType {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return writePos - readPos;
+}
+
+inline bool UnboundedAudioRingBuffer::isEmpty() const noexcept {
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    return writePos == readPos;
+}
+
+// MARK: Segment Management
+
+inline auto UnboundedAudioRingBuffer::acquireSegment() noexcept -> Segment * {
+    Segment *segment = nullptr;
+    if (spare_ != nullptr) [[likely]] {
+        segment = spare_;
+        spare_ = spare_->next.load(std::memory_order_relaxed);
+    } else if (first_ != head_.load(std::memory_order_acquire)) [[likely]] {
+        // The consumer has moved past first_ so it may be reused
+        segment = first_;
+        first_ = first_->next.load(std::memory_order_relaxed);
+    } else [[unlikely]] {
+        segment = allocateSegment();
+        if (segment == nullptr) [[unlikely]] {
+            return nullptr;
+        }
+        ++segmentCount_;
+    }
+
+    segment->next.store(nullptr, std::memory_order_relaxed);
+    return segment;
+}
+
+inline auto UnboundedAudioRingBuffer::consumerSegment() noexcept -> Segment * {
+    auto segment = head_.load(std::memory_order_relaxed);
+    if (headOffset_ == segmentCapacity_) {
+        // The producer links the next segment before publishing any audio written to it
+        segment = segment->next.load(std::memory_order_acquire);
+        assert(segment != nullptr);
+        head_.store(segment, std::memory_order_release);
+        headOffset_ = 0;
+    }
+    return segment;
+}
+
+// MARK: Writing and Reading Audio
+
+inline auto UnboundedAudioRingBuffer::write(const AudioBufferList *const _Nonnull bufferList,
+                                            SizeType frameCount) noexcept -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || segmentCapacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_relaxed);
+
+    SizeType framesWritten = 0;
+    while (framesWritten < frameCount) {
+        if (tailOffset_ == segmentCapacity_) {
+            auto segment = acquireSegment();
+            if (segment == nullptr) [[unlikely]] {
+                break;
+            }
+            tail_->next.store(segment, std::memory_order_release);
+            tail_ = segment;
+            tailOffset_ = 0;
+        }
+
+        const auto framesToCopy = std::min(segmentCapacity_ - tailOffset_, frameCount - framesWritten);
+        const auto dstOffset = tailOffset_ * format_.mBytesPerFrame;
+        const auto srcOffset = framesWritten * format_.mBytesPerFrame;
+        const auto byteCount = framesToCopy * format_.mBytesPerFrame;
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(srcOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memcpy(static_cast<unsigned char *>(tail_->buffers[i]) + dstOffset,
+                        static_cast<const unsigned char *>(bufferList->mBuffers[i].mData) + srcOffset, byteCount);
+        }
+
+        tailOffset_ += framesToCopy;
+        framesWritten += framesToCopy;
+    }
+
+    writePosition_.store(writePos + framesWritten, std::memory_order_release);
+    return framesWritten;
+}
+
+inline auto UnboundedAudioRingBuffer::read(AudioBufferList *const _Nonnull bufferList, SizeType frameCount) noexcept
+        -> SizeType {
+    if (bufferList == nullptr || frameCount == 0 || segmentCapacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = writePos - readPos;
+
+    if (framesAvailable == 0) [[unlikely]] {
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            std::memset(bufferList->mBuffers[i].mData, 0, bufferList->mBuffers[i].mDataByteSize);
+        }
+        return 0;
+    }
+
+    const auto framesToRead = std::min(framesAvailable, frameCount);
+
+    SizeType framesRead = 0;
+    while (framesRead < framesToRead) {
+        const auto segment = consumerSegment();
+
+        const auto framesToCopy = std::min(segmentCapacity_ - headOffset_, framesToRead - framesRead);
+        const auto dstOffset = framesRead * format_.mBytesPerFrame;
+        const auto srcOffset = headOffset_ * format_.mBytesPerFrame;
+        const auto byteCount = framesToCopy * format_.mBytesPerFrame;
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(dstOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memcpy(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + dstOffset,
+                        static_cast<const unsigned char *>(segment->buffers[i]) + srcOffset, byteCount);
+        }
+
+        headOffset_ += framesToCopy;
+        framesRead += framesToCopy;
+    }
+
+    readPosition_.store(readPos + framesToRead, std::memory_order_release);
+
+    // Fill remainder with silence if fewer than requested frames read
+    if (framesToRead != frameCount) {
+        const auto byteOffset = framesToRead * format_.mBytesPerFrame;
+        const auto byteCount = (frameCount - framesToRead) * format_.mBytesPerFrame;
+        for (UInt32 i = 0; i < bufferList->mNumberBuffers; ++i) {
+            assert(byteOffset + byteCount <= bufferList->mBuffers[i].mDataByteSize);
+            std::memset(static_cast<unsigned char *>(bufferList->mBuffers[i].mData) + byteOffset, 0, byteCount);
+        }
+    }
+
+    return framesToRead;
+}
+
+// MARK: Discarding Audio
+
+inline auto UnboundedAudioRingBuffer::skip(SizeType frameCount) noexcept -> SizeType {
+    if (frameCount == 0 || segmentCapacity_ == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto writePos = writePosition_.load(std::memory_order_acquire);
+    const auto readPos = readPosition_.load(std::memory_order_relaxed);
+    const auto framesAvailable = writePos - readPos;
+
+    if (framesAvailable == 0) [[unlikely]] {
+        return 0;
+    }
+
+    const auto framesToSkip = std::min(framesAvailable, frameCount);
+
+    SizeType framesSkipped = 0;
+    while (framesSkipped < framesToSkip) {
+        consumerSegment();
+        const auto framesInSegment = std::min(segmentCapacity_ - headOffset_, framesToSkip - framesSkipped);
+        headOffset_ += framesInSegment;
+        framesSkipped += framesInSegment;
+    }
+
+    readPosition_.store(readPos + framesToSkip, std::memory_order_release);
+    return framesToSkip;
+}
+
+inline auto UnboundedAudioRingBuffer::drain() noexcept -> SizeType { return skip(availableFrames()); }
+
+} /* namespace spsc */
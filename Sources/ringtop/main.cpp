@@ -0,0 +1,115 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+// Displays the AudioRingBuffer metrics a process publishes with spsc::AudioRingBufferMetricsRegistry, refreshing like
+// top. Underrun and overrun columns show the change since the previous refresh and, in parentheses, the total.
+
+#include "spsc/AudioRingBufferMetrics.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+/// The totals shown at the previous refresh.
+struct PreviousCounts {
+    std::uint64_t underrunCount{0};
+    std::uint64_t overrunCount{0};
+};
+
+/// Prints one refresh of the page.
+void printPage(const spsc::AudioRingBufferMetricsPage &page, PreviousCounts *previous, bool clearScreen) {
+    if (clearScreen) {
+        std::printf("\x1b[H\x1b[2J");
+    }
+
+    std::printf("pid %u, %llu updates every %u ms\n\n", page.processID.load(std::memory_order_relaxed),
+                static_cast<unsigned long long>(page.updateCount.load(std::memory_order_relaxed)),
+                page.updateInterval.load(std::memory_order_relaxed));
+    std::printf("%-4s %-24s %9s %9s %6s %9s %9s %9s %16s %16s  %s\n", "slot", "label", "capacity", "fill", "fill%",
+                "min", "mean", "max", "underruns", "overruns", "format");
+
+    for (std::size_t i = 0; i < spsc::AudioRingBufferMetricsPage::slotCount; ++i) {
+        spsc::AudioRingBufferMetricsSnapshot snapshot;
+        if (!page.slots[i].read(snapshot)) {
+            previous[i] = {};
+            continue;
+        }
+
+        const auto fill = snapshot.writePosition - snapshot.readPosition;
+        const auto fillPercent =
+                snapshot.capacity != 0 ? 100.0 * static_cast<double>(fill) / static_cast<double>(snapshot.capacity)
+                                       : 0.0;
+        const auto meanFill = snapshot.sampleCount != 0 ? snapshot.fillSum / snapshot.sampleCount : 0;
+        const auto minFill = snapshot.sampleCount != 0 ? snapshot.minFill : 0;
+
+        char underruns[32];
+        char overruns[32];
+        std::snprintf(underruns, sizeof underruns, "%llu (%llu)",
+                      static_cast<unsigned long long>(snapshot.underrunCount - previous[i].underrunCount),
+                      static_cast<unsigned long long>(snapshot.underrunCount));
+        std::snprintf(overruns, sizeof overruns, "%llu (%llu)",
+                      static_cast<unsigned long long>(snapshot.overrunCount - previous[i].overrunCount),
+                      static_cast<unsigned long long>(snapshot.overrunCount));
+        previous[i] = {snapshot.underrunCount, snapshot.overrunCount};
+
+        std::printf("%-4zu %-24.24s %9llu %9llu %5.1f%% %9llu %9llu %9llu %16s %16s  %.0f Hz, %u ch, %u bytes\n", i,
+                    snapshot.label, static_cast<unsigned long long>(snapshot.capacity),
+                    static_cast<unsigned long long>(fill), fillPercent, static_cast<unsigned long long>(minFill),
+                    static_cast<unsigned long long>(meanFill), static_cast<unsigned long long>(snapshot.maxFill),
+                    underruns, overruns, snapshot.sampleRate, snapshot.channelsPerFrame, snapshot.bytesPerFrame);
+    }
+
+    std::fflush(stdout);
+}
+
+} /* namespace */
+
+int main(int argc, char *argv[]) {
+    char name[64]{};
+    long intervalMilliseconds = 1000;
+    long refreshCount = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        const auto argument = std::string_view{argv[i]};
+        if (argument.rfind("--interval=", 0) == 0) {
+            intervalMilliseconds = std::strtol(argv[i] + 11, nullptr, 10);
+        } else if (argument.rfind("--count=", 0) == 0) {
+            refreshCount = std::strtol(argv[i] + 8, nullptr, 10);
+        } else if (argument.rfind("--name=", 0) == 0) {
+            std::snprintf(name, sizeof name, "%s", argv[i] + 7);
+        } else if (name[0] == '\0') {
+            spsc::AudioRingBufferMetricsRegistry::defaultName(std::atoi(argv[i]), name, sizeof name);
+        }
+    }
+
+    if (name[0] == '\0' || intervalMilliseconds <= 0) {
+        std::fprintf(stderr, "Usage: %s <pid> | --name=<shm-name> [--interval=ms] [--count=n]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    spsc::AudioRingBufferMetricsReader reader;
+    if (!reader.open(name)) {
+        std::fprintf(stderr, "No ring buffer metrics published at %s\n", name);
+        return EXIT_FAILURE;
+    }
+
+    PreviousCounts previous[spsc::AudioRingBufferMetricsPage::slotCount]{};
+    const auto clearScreen = refreshCount != 1;
+    for (long refresh = 0; refreshCount < 0 || refresh < refreshCount; ++refresh) {
+        if (refresh != 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{intervalMilliseconds});
+        }
+        printPage(*reader.page(), previous, clearScreen);
+    }
+
+    return EXIT_SUCCESS;
+}
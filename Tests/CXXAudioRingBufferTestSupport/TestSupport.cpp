@@ -0,0 +1,9 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+// A target needs at least one source file; the helpers are all inline
+#include "TestSupport.hpp"
@@ -0,0 +1,43 @@
+//
+// SPDX-FileCopyrightText: 2026 Stephen F. Booth <contact@sbooth.dev>
+// SPDX-License-Identifier: MIT
+//
+// Part of https://github.com/sbooth/CXXAudioRingBuffer
+//
+
+#pragma once
+
+#include "spsc/AudioRingBufferReclaimer.hpp"
+#include "spsc/ReorderBuffer.hpp"
+#include "spsc/RingBuffer.hpp"
+#include "spsc/StaticAudioRingBuffer.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+// Helpers for the Swift tests: template specializations and values Swift cannot spell directly.
+
+namespace support {
+
+/// An ``spsc::RingBuffer`` of 32-bit integers.
+using Int32RingBuffer = spsc::RingBuffer<std::int32_t>;
+
+/// An ``spsc::ReorderBuffer`` of 32-bit integers.
+using Int32ReorderBuffer = spsc::ReorderBuffer<std::int32_t>;
+
+/// A stereo float ``spsc::StaticAudioRingBuffer`` holding 256 frames.
+using StaticStereoAudioRingBuffer = spsc::StaticAudioRingBuffer<float, 2, 256>;
+
+/// Returns a duration of the reclaimer clock.
+/// @param milliseconds The duration in milliseconds.
+inline spsc::AudioRingBufferReclaimer::Clock::duration reclaimerDuration(long long milliseconds) noexcept {
+    return std::chrono::milliseconds{milliseconds};
+}
+
+/// Returns a time point of the reclaimer clock.
+/// @param milliseconds The time in milliseconds since the clock's epoch.
+inline spsc::AudioRingBufferReclaimer::Clock::time_point reclaimerTime(long long milliseconds) noexcept {
+    return spsc::AudioRingBufferReclaimer::Clock::time_point{std::chrono::milliseconds{milliseconds}};
+}
+
+} /* namespace support */
@@ -5,8 +5,45 @@
 // Part of https://github.com/sbooth/CXXAudioRingBuffer
 //
 
+import Foundation
 import Testing
+import AudioRingBuffer
 @testable import CXXAudioRingBuffer
+import CXXAudioRingBufferTestSupport
+
+/// Non-interleaved channels referenced by an `AudioBufferList`.
+final class TestBufferList<Sample: Numeric> {
+    let frameCount: Int
+    let list: UnsafeMutableAudioBufferListPointer
+
+    init(channelCount: Int, frameCount: Int) {
+        self.frameCount = frameCount
+        list = AudioBufferList.allocate(maximumBuffers: channelCount)
+        for i in 0..<channelCount {
+            let data = UnsafeMutablePointer<Sample>.allocate(capacity: frameCount)
+            data.initialize(repeating: 0, count: frameCount)
+            list[i] = AudioBuffer(mNumberChannels: 1, mDataByteSize: UInt32(frameCount * MemoryLayout<Sample>.size), mData: data)
+        }
+    }
+
+    deinit {
+        for buffer in list {
+            buffer.mData?.deallocate()
+        }
+        free(list.unsafeMutablePointer)
+    }
+
+    var pointer: UnsafeMutablePointer<AudioBufferList> { list.unsafeMutablePointer }
+
+    subscript(channel: Int) -> UnsafeMutableBufferPointer<Sample> {
+        UnsafeMutableBufferPointer(start: list[channel].mData!.assumingMemoryBound(to: Sample.self), count: frameCount)
+    }
+}
+
+/// A non-interleaved 32-bit float format.
+func floatFormat(channelCount: UInt32) -> AudioStreamBasicDescription {
+    AudioStreamBasicDescription(mSampleRate: 48000, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: channelCount, mBitsPerChannel: 32, mReserved: 0)
+}
 
 @Suite struct CXXAudioRingBufferTests {
     @Test func audioRingBuffer() async {
@@ -24,10 +61,1122 @@ import Testing
         #expect(rb.availableFrames() == 0)
         #expect(rb.freeSpace() == rb.capacity())
 
+        #expect(rb.reserveWrite(600).count() == 512)
+        rb.commitWrite(100)
+        #expect(rb.availableFrames() == 100)
+        #expect(rb.reserveRead(600).count() == 100)
+        rb.commitRead(100)
+        #expect(rb.availableFrames() == 0)
+
+        // A smaller capacity reuses the allocation in place, with the channel buffers packed at its start
+        let channelBuffers = [rb.channelBuffer(0), rb.channelBuffer(1)]
+        #expect(rb.allocate(std2ch, 200) == true)
+        #expect(rb.capacity() == 256)
+        #expect(rb.channelBuffer(0) == channelBuffers[0])
+        #expect(rb.channelBuffer(1) == channelBuffers[0] + 256 * Int(std2ch.mBytesPerFrame))
+        #expect(rb.allocate(std2ch, 512) == true)
+        #expect(rb.capacity() == 512)
+        #expect([rb.channelBuffer(0), rb.channelBuffer(1)] == channelBuffers)
+
+        #expect(rb.allocate(std2ch, 1024) == true)
+        #expect(rb.capacity() == 1024)
+
         rb.deallocate()
         #expect(rb.__convertToBool() == false)
         #expect(rb.capacity() == 0)
         #expect(rb.availableFrames() == 0)
         #expect(rb.freeSpace() == rb.capacity())
     }
+
+    @Test func unboundedAudioRingBuffer() async {
+        let empty = spsc.UnboundedAudioRingBuffer()
+        #expect(empty.__convertToBool() == false)
+        #expect(empty.segmentCapacity() == 0)
+        #expect(empty.availableFrames() == 0)
+
+        var rb = spsc.UnboundedAudioRingBuffer()
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 8, mFramesPerPacket: 8, mBytesPerFrame: 8, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        #expect(rb.allocate(std2ch, 500) == true)
+        #expect(rb.__convertToBool() == true)
+        #expect(rb.segmentCapacity() == 500)
+        #expect(rb.segmentCount() == 1)
+        #expect(rb.availableFrames() == 0)
+
+        #expect(rb.reserve(2000) == true)
+        #expect(rb.segmentCount() == 4)
+        #expect(rb.trim() == 3)
+
+        rb.deallocate()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.segmentCapacity() == 0)
+        #expect(rb.availableFrames() == 0)
+    }
+
+    @Test func unboundedAudioRingBufferSpansSegments() async {
+        var rb = spsc.UnboundedAudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 2), 100) == true)
+
+        let input = TestBufferList<Float>(channelCount: 2, frameCount: 70)
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 120)
+        var framesWritten = 0
+        var framesRead = 0
+
+        func write() {
+            for i in 0..<70 {
+                input[0][i] = Float(framesWritten + i)
+                input[1][i] = -Float(framesWritten + i)
+            }
+            #expect(rb.write(input.pointer, 70) == 70)
+            framesWritten += 70
+        }
+
+        func read() -> Int {
+            let count = rb.read(output.pointer, 120)
+            for i in 0..<count where output[0][i] != Float(framesRead + i) || output[1][i] != -Float(framesRead + i) {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i]), \(output[1][i])")
+                break
+            }
+            framesRead += count
+            return count
+        }
+
+        // Writes and reads that straddle segment boundaries
+        for _ in 0..<5 {
+            write()
+        }
+        #expect(rb.segmentCount() == 4)
+        #expect(rb.availableFrames() == 350)
+        #expect(read() == 120)
+        #expect(read() == 120)
+        #expect(read() == 110)
+        #expect(rb.isEmpty())
+
+        // Segments the consumer has left are recycled, so a steady backlog stops allocating
+        var segmentCount = 0
+        for round in 0..<20 {
+            for _ in 0..<5 {
+                write()
+            }
+            while read() != 0 {}
+            if round == 1 {
+                segmentCount = rb.segmentCount()
+            }
+        }
+        #expect(rb.segmentCount() == segmentCount)
+        #expect(framesRead == framesWritten)
+    }
+
+    @Test func compactAudioRingBuffer() async {
+        var rb = spsc.CompactAudioRingBuffer()
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        #expect(rb.allocate(std2ch, 512, .int16) == true)
+        #expect(rb.__convertToBool() == true)
+        #expect(rb.storageFormat() == .int16)
+        #expect(rb.capacity() == 512)
+        #expect(rb.availableFrames() == 0)
+        #expect(rb.freeSpace() == rb.capacity())
+
+        let std2ch16 = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeEndian|kAudioFormatFlagIsSignedInteger|kAudioFormatFlagIsPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 2, mFramesPerPacket: 1, mBytesPerFrame: 2, mChannelsPerFrame: 2, mBitsPerChannel: 16, mReserved: 0)
+        #expect(rb.allocate(std2ch16, 512, .float16) == false)
+
+        rb.deallocate()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.capacity() == 0)
+    }
+
+    @Test func compactAudioRingBufferConversions() async {
+        // The software conversions used without hardware support
+        #expect(spsc.detail.floatToHalf(1) == 0x3c00)
+        #expect(spsc.detail.floatToHalf(65504) == 0x7bff)
+        #expect(spsc.detail.floatToHalf(-65504) == 0xfbff)
+        #expect(spsc.detail.floatToHalf(65519) == 0x7bff)
+        #expect(spsc.detail.floatToHalf(65520) == 0x7c00)
+        #expect(spsc.detail.floatToHalf(.infinity) == 0x7c00)
+        #expect(spsc.detail.floatToHalf(-.infinity) == 0xfc00)
+        #expect(spsc.detail.floatToHalf(.nan) & 0x7c00 == 0x7c00 && spsc.detail.floatToHalf(.nan) & 0x03ff != 0)
+        #expect(spsc.detail.halfToFloat(0x0001) == 0x1p-24)
+        #expect(spsc.detail.halfToFloat(0x7bff) == 65504)
+        #expect(spsc.detail.halfToFloat(0xfc00) == -.infinity)
+
+        let values: [Float] = [0, 1, -1, 0.1, 65504, -65504, 70000, .infinity, -.infinity, .nan, 1e-8, 2]
+        let input = TestBufferList<Float>(channelCount: 1, frameCount: values.count)
+        let output = TestBufferList<Float>(channelCount: 1, frameCount: values.count)
+        for (i, value) in values.enumerated() {
+            input[0][i] = value
+        }
+
+        // Half precision keeps the range of the input, and the hardware path agrees with the software one
+        var rb = spsc.CompactAudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 1), 16, .float16) == true)
+        #expect(rb.write(input.pointer, values.count) == values.count)
+        #expect(rb.read(output.pointer, values.count) == values.count)
+        let expectedHalf: [Float] = [0, 1, -1, 0.0999755859375, 65504, -65504, .infinity, .infinity, -.infinity, .nan, 0, 2]
+        for (i, expected) in expectedHalf.enumerated() {
+            if expected.isNaN {
+                #expect(output[0][i].isNaN)
+            } else {
+                #expect(output[0][i] == expected)
+                #expect(output[0][i] == spsc.detail.halfToFloat(spsc.detail.floatToHalf(values[i])))
+            }
+        }
+
+        // Integers clip to [-1, 1) and store NaN as silence; dither moves other samples by at most one step
+        #expect(rb.allocate(floatFormat(channelCount: 1), 16, .int16) == true)
+        let maxSample: Float = 32767 / 32768
+        let expectedInt: [Float] = [0, maxSample, -1, 0.1, maxSample, -1, maxSample, maxSample, -1, 0, 0, maxSample]
+        for _ in 0..<100 {
+            #expect(rb.write(input.pointer, values.count) == values.count)
+            #expect(rb.read(output.pointer, values.count) == values.count)
+            for (i, expected) in expectedInt.enumerated() {
+                #expect(abs(output[0][i] - expected) <= 2 / 32768)
+            }
+            #expect(output[0][4] == maxSample)
+            #expect(output[0][5] == -1)
+            #expect(output[0][7] == maxSample)
+            #expect(output[0][8] == -1)
+            #expect(output[0][9] == 0)
+        }
+    }
+
+    @Test func exactAudioRingBuffer() async {
+        var rb = spsc.ExactAudioRingBuffer()
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 8, mFramesPerPacket: 8, mBytesPerFrame: 8, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        #expect(rb.allocate(std2ch, 48000) == true)
+        #expect(rb.__convertToBool() == true)
+        #expect(rb.capacity() == 48000)
+        #expect(rb.availableFrames() == 0)
+        #expect(rb.freeSpace() == rb.capacity())
+
+        #expect(rb.allocate(std2ch, 200) == true)
+        #expect(rb.capacity() == 200)
+
+        rb.deallocate()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.capacity() == 0)
+    }
+
+    @Test func exactAudioRingBufferWrap() async {
+        var rb = spsc.ExactAudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 2), 200) == true)
+        #expect(rb.capacity() == 200)
+
+        let input = TestBufferList<Float>(channelCount: 2, frameCount: 150)
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 150)
+        var framesWritten = 0
+        var framesRead = 0
+
+        // 150 frames at a time against a capacity of 200 wraps at a different offset each round
+        for _ in 0..<6 {
+            for i in 0..<150 {
+                input[0][i] = Float(framesWritten + i)
+                input[1][i] = -Float(framesWritten + i)
+            }
+            #expect(rb.write(input.pointer, 150) == 150)
+            framesWritten += 150
+            #expect(rb.availableFrames() == 150)
+            #expect(rb.freeSpace() == 50)
+
+            #expect(rb.read(output.pointer, 150) == 150)
+            for i in 0..<150 where output[0][i] != Float(framesRead + i) || output[1][i] != -Float(framesRead + i) {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i]), \(output[1][i])")
+                break
+            }
+            framesRead += 150
+        }
+        #expect(rb.availableFrames() == 0)
+    }
+
+    @Test func ringBuffer() async {
+        var rb = support.Int32RingBuffer()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.allocate(1) == false)
+        #expect(rb.allocate(100) == true)
+        #expect(rb.capacity() == 128)
+
+        var input = [Int32](repeating: 0, count: 100)
+        var output = [Int32](repeating: 0, count: 100)
+        var written: Int32 = 0
+        var read: Int32 = 0
+
+        // 100 elements at a time against a capacity of 128 wraps at a different offset each round
+        for _ in 0..<5 {
+            for i in 0..<100 {
+                input[i] = written + Int32(i)
+            }
+            #expect(rb.push(input, 100) == 100)
+            written += 100
+            #expect(rb.pop(&output, 100) == 100)
+            #expect(output == Array(read..<read + 100))
+            read += 100
+        }
+
+        #expect(rb.push(input, 100) == 100)
+        #expect(rb.push(input, 100) == 28)
+        #expect(rb.isFull() == true)
+        #expect(rb.skip(100) == 100)
+        var element: Int32 = -1
+        #expect(rb.pop(&element) == true)
+        #expect(element == input[0])
+        #expect(rb.drain() == 27)
+        #expect(rb.isEmpty() == true)
+        #expect(rb.pop(&element) == false)
+
+        // A zero-copy write across the wrap reads back in order
+        let region = rb.reserveWrite(50)
+        #expect(region.count() == 50)
+        #expect(region.secondCount != 0)
+        let storage = rb.data()!
+        for i in 0..<Int(region.firstCount) {
+            storage[Int(region.index) + i] = Int32(i)
+        }
+        for i in 0..<Int(region.secondCount) {
+            storage[i] = Int32(Int(region.firstCount) + i)
+        }
+        rb.commitWrite(50)
+        #expect(rb.pop(&output, 50) == 50)
+        #expect(Array(output[0..<50]) == (0..<50).map { Int32($0) })
+    }
+
+    @Test func staticAudioRingBuffer() async {
+        var rb = support.StaticStereoAudioRingBuffer()
+        #expect(support.StaticStereoAudioRingBuffer.capacity == 256)
+        #expect(rb.isEmpty() == true)
+        #expect(rb.freeSpace() == 256)
+
+        let input = TestBufferList<Float>(channelCount: 2, frameCount: 200)
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 200)
+        var framesWritten = 0
+        var framesRead = 0
+
+        func write(_ frameCount: Int, expecting expected: Int? = nil) {
+            for i in 0..<frameCount {
+                input[0][i] = Float(framesWritten + i)
+                input[1][i] = -Float(framesWritten + i)
+            }
+            let written = Int(rb.write(input.pointer, frameCount))
+            #expect(written == expected ?? frameCount)
+            framesWritten += written
+        }
+
+        func read(_ frameCount: Int) {
+            #expect(rb.read(output.pointer, frameCount) == frameCount)
+            for i in 0..<frameCount where output[0][i] != Float(framesRead + i) || output[1][i] != -Float(framesRead + i) {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i]), \(output[1][i])")
+                break
+            }
+            framesRead += frameCount
+        }
+
+        // The second write wraps, and the third fills the buffer
+        write(200)
+        read(150)
+        write(200)
+        write(10, expecting: 6)
+        #expect(rb.isFull() == true)
+        #expect(rb.availableFrames() == 256)
+
+        // Skipped frames are not read, and the read continues across the wrap
+        #expect(rb.skip(30) == 30)
+        framesRead += 30
+        read(100)
+        #expect(rb.availableFrames() == 126)
+
+        #expect(rb.drain() == 126)
+        #expect(rb.isEmpty() == true)
+        #expect(rb.freeSpace() == 256)
+    }
+
+    @Test func swappableAudioRingBuffer() async {
+        var rb = spsc.SwappableAudioRingBuffer()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.producerBuffer() == nil)
+
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 8, mFramesPerPacket: 8, mBytesPerFrame: 8, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        // Without a reclaimer thread only reclaim() frees the retired ring buffer
+        #expect(rb.allocate(std2ch, 512, spsc.SwappableAudioRingBuffer.manualReclaimInterval) == true)
+        #expect(rb.__convertToBool() == true)
+        #expect(rb.producerBuffer()?.pointee.capacity() == 512)
+
+        #expect(rb.reconfigure(std2ch, 1024) == true)
+        #expect(rb.producerBuffer()?.pointee.capacity() == 1024)
+        #expect(rb.consumerBuffer()?.pointee.capacity() == 1024)
+        #expect(rb.reclaim() == 1)
+
+        rb.deallocate()
+        #expect(rb.__convertToBool() == false)
+    }
+
+    @Test func audioBlockQueue() async {
+        var queue = spsc.AudioBlockQueue()
+        #expect(queue.__convertToBool() == false)
+
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        #expect(queue.allocate(std2ch, 256, 3) == true)
+        #expect(queue.slotCount() == 4)
+        #expect(queue.blockFrameCount() == 256)
+
+        var block = spsc.AudioBlockQueue.Block()
+        #expect(queue.claim(&block) == false)
+        #expect(queue.reserve(&block) == true)
+        queue.publish(block, 100)
+        #expect(queue.claim(&block) == true)
+        #expect(block.sequence == 0)
+        #expect(block.frameCount == 100)
+        queue.complete(block)
+
+        queue.deallocate()
+        #expect(queue.__convertToBool() == false)
+    }
+
+    @Test func reorderBuffer() async {
+        var rb = support.Int32ReorderBuffer()
+        #expect(rb.__convertToBool() == false)
+        #expect(rb.allocate(4, 0) == true)
+        #expect(rb.capacity() == 4)
+
+        var value: Int32 = -1
+        #expect(rb.pop(&value) == false)
+
+        // Results inserted out of order are held until the next one in sequence arrives
+        #expect(rb.insert(2, 20) == true)
+        #expect(rb.insert(1, 10) == true)
+        #expect(rb.pop(&value) == false)
+
+        // A sequence number a full window ahead of the next one to pop is refused
+        #expect(rb.insert(4, 40) == false)
+
+        #expect(rb.insert(3, 30) == true)
+        #expect(rb.insert(0, 0) == true)
+        for i in 0..<4 {
+            #expect(rb.pop(&value) == true)
+            #expect(value == Int32(i * 10))
+        }
+        #expect(rb.nextSequence() == 4)
+        #expect(rb.pop(&value) == false)
+
+        // Popping advances the window
+        #expect(rb.insert(7, 70) == true)
+        #expect(rb.insert(8, 80) == false)
+        #expect(rb.insert(4, 40) == true)
+        #expect(rb.pop(&value) == true)
+        #expect(value == 40)
+        #expect(rb.pop(&value) == false)
+    }
+
+    @Test func audioRingBufferMixer() async {
+        var mixer = spsc.AudioRingBufferMixer()
+        #expect(mixer.__convertToBool() == false)
+        #expect(mixer.allocate(4) == true)
+        #expect(mixer.maxStreamCount() == 4)
+
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(std2ch, 512) == true)
+        #expect(mixer.attach(&rb, 0.5) == 0)
+        #expect(mixer.gain(0) == 0.5)
+        mixer.setGain(0, 0.25)
+        #expect(mixer.gain(0) == 0.25)
+        #expect(mixer.underrunCount(0) == 0)
+        mixer.detach(0)
+
+        mixer.deallocate()
+        #expect(mixer.__convertToBool() == false)
+    }
+
+    @Test func audioRingBufferMixerSum() async {
+        var mixer = spsc.AudioRingBufferMixer()
+        #expect(mixer.allocate(4) == true)
+
+        // A full stereo stream and a short mono stream
+        var stereo = spsc.AudioRingBuffer()
+        #expect(stereo.allocate(floatFormat(channelCount: 2), 512) == true)
+        var mono = spsc.AudioRingBuffer()
+        #expect(mono.allocate(floatFormat(channelCount: 1), 512) == true)
+        #expect(mixer.attach(&stereo, 0.5) == 0)
+        #expect(mixer.attach(&mono, 0.25) == 1)
+
+        let stereoInput = TestBufferList<Float>(channelCount: 2, frameCount: 300)
+        stereoInput[0].update(repeating: 1)
+        stereoInput[1].update(repeating: 2)
+        #expect(stereo.write(stereoInput.pointer, 300) == 300)
+        let monoInput = TestBufferList<Float>(channelCount: 1, frameCount: 100)
+        monoInput[0].update(repeating: 4)
+        #expect(mono.write(monoInput.pointer, 100) == 100)
+
+        // The mix spans more than one tile and outlasts the mono stream
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 300)
+        output[0].update(repeating: 99)
+        output[1].update(repeating: 99)
+        #expect(mixer.mix(output.pointer, 300) == 2)
+        #expect(output[0][..<100].allSatisfy { $0 == 0.5 * 1 + 0.25 * 4 })
+        #expect(output[0][100...].allSatisfy { $0 == 0.5 * 1 })
+        #expect(output[1].allSatisfy { $0 == 0.5 * 2 })
+        #expect(mixer.underrunCount(0) == 0)
+        #expect(mixer.underrunCount(1) == 1)
+        #expect(stereo.availableFrames() == 0)
+        #expect(mono.availableFrames() == 0)
+
+        mixer.deallocate()
+    }
+
+    @Test func audioRingBufferScheduler() async {
+        var scheduler = spsc.AudioRingBufferScheduler()
+        #expect(scheduler.nodeCount() == 0)
+        #expect(scheduler.isRunning() == false)
+        #expect(scheduler.start(0, spsc.AudioRingBufferScheduler.defaultIdleInterval) == false)
+        #expect(scheduler.start(2, spsc.AudioRingBufferScheduler.defaultIdleInterval) == true)
+        #expect(scheduler.isRunning() == true)
+        scheduler.stop()
+        #expect(scheduler.isRunning() == false)
+    }
+
+    @Test func audioRingBufferPipeline() async {
+        var pipeline = spsc.AudioRingBufferPipeline()
+        #expect(pipeline.__convertToBool() == false)
+        #expect(pipeline.stageCount() == 0)
+        #expect(pipeline.isRunning() == false)
+        #expect(spsc.AudioRingBufferPipeline.ringCapacity(64, 0, 128, 32) == 224)
+    }
+
+    @Test func audioRingBufferTracer() async {
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(std2ch, 512) == true)
+
+        var tracer = spsc.AudioRingBufferTracer()
+        #expect(tracer.__convertToBool() == false)
+        #expect(tracer.allocate(&rb, 2) == true)
+        tracer.recordWrite(256, 256)
+        tracer.recordRead(512, 256)
+
+        var events = [spsc.AudioRingBufferTracer.Event](repeating: spsc.AudioRingBufferTracer.Event(), count: 4)
+        #expect(tracer.collect(&events, 4) == 2)
+        #expect(events[0].framesRequested == 256)
+        #expect(events[1].framesTransferred == 256)
+        #expect(tracer.droppedEventCount() == 0)
+
+        tracer.deallocate()
+        #expect(tracer.__convertToBool() == false)
+    }
+
+    @Test func audioRingBufferTracerForwardsAndSaves() async throws {
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 2), 512) == true)
+
+        var tracer = spsc.AudioRingBufferTracer()
+        #expect(tracer.allocate(&rb, 2) == true)
+
+        let input = TestBufferList<Float>(channelCount: 2, frameCount: 600)
+        for i in 0..<600 {
+            input[0][i] = Float(i)
+            input[1][i] = -Float(i)
+        }
+
+        // Calls are forwarded to the ring buffer, and a third write event does not fit
+        #expect(tracer.write(input.pointer, 300) == 300)
+        #expect(tracer.write(input.pointer, 300) == 212)
+        #expect(tracer.write(input.pointer, 100) == 0)
+        #expect(tracer.droppedEventCount() == 1)
+
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 600)
+        #expect(tracer.read(output.pointer, 600) == 512)
+        #expect(output[0][299] == 299)
+        #expect(output[1][511] == -211)
+        #expect(rb.availableFrames() == 0)
+
+        var events = [spsc.AudioRingBufferTracer.Event](repeating: spsc.AudioRingBufferTracer.Event(), count: 8)
+        #expect(tracer.collect(&events, 8) == 3)
+        #expect(events[0].operation == .write)
+        #expect(events[0].framesRequested == 300)
+        #expect(events[0].framesTransferred == 300)
+        #expect(events[1].framesTransferred == 212)
+        #expect(events[2].operation == .read)
+        #expect(events[2].framesRequested == 600)
+        #expect(events[2].framesTransferred == 512)
+        #expect(events[0].timestamp <= events[1].timestamp)
+
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("tracer-\(UUID().uuidString).csv")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let file = try #require(fopen(url.path, "w"))
+        #expect(spsc.AudioRingBufferTracer.save(file, events, 3) == true)
+        fclose(file)
+
+        let lines = try String(contentsOf: url, encoding: .utf8).split(separator: "\n").map(String.init)
+        #expect(lines == [
+            "w,\(events[0].timestamp),300,300",
+            "w,\(events[1].timestamp),300,212",
+            "r,\(events[2].timestamp),600,512",
+        ])
+    }
+
+    @Test func audioRingBufferMetrics() async {
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(std2ch, 512) == true)
+        #expect(rb.underrunCount() == 0)
+        #expect(rb.overrunCount() == 0)
+        #expect(rb.writePosition() == 0)
+        #expect(rb.readPosition() == 0)
+
+        var registry = spsc.AudioRingBufferMetricsRegistry()
+        #expect(registry.__convertToBool() == false)
+        #expect(registry.add(rb, "closed") == spsc.AudioRingBufferMetricsRegistry.SizeType.max)
+
+        // Writing to an unallocated ring is not an overrun
+        var empty = spsc.AudioRingBuffer()
+        let input = TestBufferList<Float>(channelCount: 2, frameCount: 16)
+        #expect(empty.write(input.pointer, 16) == 0)
+        #expect(empty.overrunCount() == 0)
+    }
+
+    @Test func audioRingBufferMetricsRegistryPublishes() async throws {
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 2), 512) == true)
+
+        let name = "/spsc-metrics-test.\(getpid())"
+        var registry = spsc.AudioRingBufferMetricsRegistry()
+        #expect(registry.open(name, spsc.AudioRingBufferMetricsRegistry.defaultUpdateInterval) == true)
+        #expect(registry.__convertToBool() == true)
+        let slot = registry.add(rb, "test")
+        #expect(slot == 0)
+
+        let buffer = TestBufferList<Float>(channelCount: 2, frameCount: 100)
+        #expect(rb.write(buffer.pointer, 100) == 100)
+        #expect(rb.read(buffer.pointer, 30) == 30)
+
+        // Another process would map the page the same way
+        var reader = spsc.AudioRingBufferMetricsReader()
+        #expect(reader.open(name) == true)
+        var snapshot = spsc.AudioRingBufferMetricsSnapshot()
+        for _ in 0..<200 where !(reader.read(slot, &snapshot) && snapshot.readPosition == 30) {
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+        #expect(snapshot.capacity == 512)
+        #expect(snapshot.writePosition == 100)
+        #expect(snapshot.readPosition == 30)
+        #expect(snapshot.channelsPerFrame == 2)
+        #expect(withUnsafeBytes(of: snapshot.label) { String(cString: $0.bindMemory(to: CChar.self).baseAddress!) } == "test")
+        #expect(reader.read(spsc.AudioRingBufferMetricsPage.slotCount, &snapshot) == false)
+
+        reader.close()
+        registry.remove(slot)
+        registry.close()
+        #expect(registry.__convertToBool() == false)
+    }
+
+    @Test func audioRingBufferCostHistograms() async {
+        #expect(spsc.AudioRingBufferCostHistograms.bucketIndex(7) == 7)
+        #expect(spsc.AudioRingBufferCostHistograms.bucketIndex(8) == 8)
+        #expect(spsc.AudioRingBufferCostHistograms.bucketIndex(17) == 16)
+        #expect(spsc.AudioRingBufferCostHistograms.bucketLowerBound(16) == 16)
+        #expect(spsc.AudioRingBufferCostHistograms.bucketIndex(UInt64.max) == spsc.AudioRingBufferCostHistograms.bucketCount - 1)
+
+        let rb = spsc.AudioRingBuffer()
+        #expect(rb.costHistograms() == nil)
+    }
+
+    @Test func audioRingBufferCostHistogramsRecordPhases() async {
+        typealias Phase = spsc.AudioRingBufferCostHistograms.Phase
+
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 2), 128) == true)
+        let buffer = TestBufferList<Float>(channelCount: 2, frameCount: 100)
+
+        var histograms = spsc.AudioRingBufferCostHistograms()
+        withUnsafeMutablePointer(to: &histograms) { histograms in
+            rb.setCostHistograms(histograms)
+            #expect(rb.costHistograms() == histograms)
+
+            // A full read, a short read, and an empty read
+            #expect(rb.write(buffer.pointer, 100) == 100)
+            #expect(rb.read(buffer.pointer, 60) == 60)
+            #expect(rb.read(buffer.pointer, 60) == 40)
+            #expect(rb.read(buffer.pointer, 60) == 0)
+
+            // Detached histograms record nothing
+            rb.setCostHistograms(nil)
+            #expect(rb.write(buffer.pointer, 100) == 100)
+        }
+
+        #expect(histograms.totalCount(.writeReserve) == 1)
+        #expect(histograms.totalCount(.writeCopy) == 1)
+        #expect(histograms.totalCount(.writeCommit) == 1)
+        #expect(histograms.totalCount(.readReserve) == 3)
+        #expect(histograms.totalCount(.readCopy) == 2)
+        #expect(histograms.totalCount(.readCommit) == 2)
+        #expect(histograms.totalCount(.readSilence) == 2)
+        #expect(histograms.percentile(.writeCopy, 100) <= histograms.totalTicks(.writeCopy))
+        #expect(histograms.percentile(.readCopy, 50) <= histograms.percentile(.readCopy, 100))
+
+        histograms.reset()
+        #expect(histograms.totalCount(.readReserve) == 0)
+    }
+
+    @Test func audioRingBufferGroupWriteAll() async {
+        var unwrapped = spsc.AudioRingBuffer()
+        var wrapped = spsc.AudioRingBuffer()
+        var partial = spsc.AudioRingBuffer()
+        #expect(unwrapped.allocate(floatFormat(channelCount: 2), 4096) == true)
+        #expect(wrapped.allocate(floatFormat(channelCount: 2), 4096) == true)
+        #expect(partial.allocate(floatFormat(channelCount: 2), 4096) == true)
+
+        let filler = TestBufferList<Float>(channelCount: 2, frameCount: 3000)
+        for i in 0..<3000 {
+            filler[0][i] = -1
+            filler[1][i] = -2
+        }
+        // Move the write position of one member to frame 3000 so its free region wraps
+        #expect(wrapped.write(filler.pointer, 3000) == 3000)
+        #expect(wrapped.read(filler.pointer, 3000) == 3000)
+        // Leave another member with less free space than the slice
+        for i in 0..<3000 {
+            filler[0][i] = -1
+            filler[1][i] = -2
+        }
+        #expect(partial.write(filler.pointer, 2000) == 2000)
+
+        var group = spsc.AudioRingBufferGroup()
+        #expect(group.allocate(3) == true)
+        #expect(group.add(&unwrapped) == true)
+        #expect(group.add(&wrapped) == true)
+        #expect(group.add(&partial) == true)
+        #expect(group.memberCount() == 3)
+
+        // 3000 frames of 32-bit float span several chunks of chunkByteSize bytes
+        #expect(3000 * MemoryLayout<Float>.size > spsc.AudioRingBufferGroup.chunkByteSize)
+        let source = TestBufferList<Float>(channelCount: 2, frameCount: 3000)
+        for i in 0..<3000 {
+            source[0][i] = Float(i)
+            source[1][i] = -Float(i)
+        }
+        #expect(group.writeAll(source.pointer, 3000) == 2096)
+
+        let output = TestBufferList<Float>(channelCount: 2, frameCount: 4096)
+        func expectFrames(_ count: Int, from start: Int, at offset: Int, _ member: String) {
+            for i in 0..<count where output[0][offset + i] != Float(start + i) || output[1][offset + i] != -Float(start + i) {
+                Issue.record("\(member) frame \(offset + i) read back as \(output[0][offset + i]), \(output[1][offset + i])")
+                break
+            }
+        }
+
+        #expect(unwrapped.read(output.pointer, 4096) == 3000)
+        expectFrames(3000, from: 0, at: 0, "unwrapped")
+
+        #expect(wrapped.read(output.pointer, 4096) == 3000)
+        expectFrames(3000, from: 0, at: 0, "wrapped")
+
+        #expect(partial.read(output.pointer, 4096) == 4096)
+        #expect(output[0][0..<2000].allSatisfy { $0 == -1 })
+        #expect(output[1][0..<2000].allSatisfy { $0 == -2 })
+        expectFrames(2096, from: 0, at: 2000, "partial")
+    }
+
+    @Test func audioRingBufferRegions() async {
+        let std2ch = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagsNativeFloatPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 4, mFramesPerPacket: 1, mBytesPerFrame: 4, mChannelsPerFrame: 2, mBitsPerChannel: 32, mReserved: 0)
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(std2ch, 8) == true)
+
+        #expect(rb.withWritableRegion(frameCount: 6) { region in
+            #expect(region.channelCount == 2)
+            for channel in 0..<region.channelCount {
+                let (first, _) = region.channel(channel)
+                for i in 0..<first.count {
+                    first[i] = Float(channel * 100 + i)
+                }
+            }
+            return region.frameCount
+        } == 6)
+        #expect(rb.availableFrames() == 6)
+
+        #expect(rb.withReadableRegion(frameCount: 4) { region in
+            #expect(region.frameCount == 4)
+            #expect(region.channel(1).0[3] == 103)
+            return 4
+        } == 4)
+
+        // The next write wraps
+        #expect(rb.withWritableRegion(frameCount: 8) { region in
+            #expect(region.firstCount == 2)
+            #expect(region.secondCount == 4)
+            return 0
+        } == 0)
+        #expect(rb.availableFrames() == 2)
+    }
+
+    @Test func audioRingBufferReclaimFreeSpace() async {
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 1), 65536) == true)
+        rb.prefault()
+        #expect(rb.reclaimFreeSpace(rb.capacity()) == 0)
+
+        /// Returns the number of bytes in the whole pages spanning frames [begin, end) of the channel buffer.
+        let pageSize = Int(sysconf(_SC_PAGESIZE))
+        let base = Int(bitPattern: rb.channelBuffer(0))
+        func releasableBytes(_ begin: Int, _ end: Int) -> Int {
+            let first = (base + begin * MemoryLayout<Float>.size + pageSize - 1) & ~(pageSize - 1)
+            let last = (base + end * MemoryLayout<Float>.size) & ~(pageSize - 1)
+            return max(last - first, 0)
+        }
+
+        let input = TestBufferList<Float>(channelCount: 1, frameCount: 20000)
+        let output = TestBufferList<Float>(channelCount: 1, frameCount: 20000)
+        var framesWritten = 0
+        var framesRead = 0
+
+        func write() {
+            for i in 0..<20000 {
+                input[0][i] = Float(framesWritten + i)
+            }
+            #expect(rb.write(input.pointer, 20000) == 20000)
+            framesWritten += 20000
+        }
+
+        func read() {
+            #expect(rb.read(output.pointer, 20000) == 20000)
+            for i in 0..<20000 where output[0][i] != Float(framesRead + i) {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i])")
+                break
+            }
+            framesRead += 20000
+        }
+
+        // Leave the write position at frame 60000 and the read position at frame 40000,
+        // so the free region wraps
+        write(); read(); write(); read(); write()
+        #expect(rb.freeSpace() == 45536)
+
+        // Nothing is released when keepFrames covers the free region
+        #expect(rb.reclaimFreeSpace(45536) == 0)
+        #expect(rb.reclaimFreeSpace(1000) == releasableBytes(61000, 65536) + releasableBytes(0, 40000))
+
+        // Audio before the reclaimed region is intact, and audio written into it reads back
+        read()
+        write()
+        read()
+        #expect(rb.availableFrames() == 0)
+    }
+
+    @Test func audioRingBufferReclaimerIdleTiming() async {
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 1), 65536) == true)
+        rb.prefault()
+
+        var reclaimer = spsc.AudioRingBufferReclaimer(64, support.reclaimerDuration(100), 0)
+        func update(_ milliseconds: Int64) -> Int {
+            Int(reclaimer.update(&rb, support.reclaimerTime(milliseconds)))
+        }
+
+        let buffers = TestBufferList<Float>(channelCount: 1, frameCount: 1000)
+        #expect(rb.write(buffers.pointer, 1000) == 1000)
+        #expect(update(0) == 0)
+
+        // Idle timing starts with the first sample at or below lowFillFrames
+        #expect(rb.read(buffers.pointer, 990) == 990)
+        #expect(update(10) == 0)
+        #expect(update(50) == 0)
+        #expect(update(109) == 0)
+        #expect(update(110) > 0)
+        // A release restarts the idle period
+        #expect(update(150) == 0)
+
+        // Filling above lowFillFrames resets the idle period
+        #expect(rb.write(buffers.pointer, 1000) == 1000)
+        #expect(update(300) == 0)
+        #expect(rb.read(buffers.pointer, 1000) == 1000)
+        #expect(update(310) == 0)
+        #expect(update(400) == 0)
+        #expect(update(410) > 0)
+    }
+
+    @Test func spillingAudioRingBuffer() async throws {
+        var rb = spsc.SpillingAudioRingBuffer()
+        #expect(rb.__convertToBool() == false)
+        // A spill threshold above the capacity could never be met
+        #expect(rb.allocate(floatFormat(channelCount: 1), 256, 257, spsc.SpillingAudioRingBuffer.defaultHelperInterval, 4096) == false)
+        // A small compaction threshold so a sustained backlog compacts the file repeatedly
+        #expect(rb.allocate(floatFormat(channelCount: 1), 256, 128, spsc.SpillingAudioRingBuffer.defaultHelperInterval, 4096) == true)
+
+        let input = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        let output = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        var written: Float = 0
+        var expected: Float = 0
+
+        func produce() {
+            for i in 0..<64 {
+                input[0][i] = written + Float(i)
+            }
+            written += Float(rb.write(input.pointer, 64))
+        }
+
+        func consume() -> Int {
+            let count = rb.read(output.pointer, 64)
+            for i in 0..<count {
+                #expect(output[0][i] == expected)
+                expected += 1
+            }
+            return count
+        }
+
+        // Build a backlog larger than the rings while the consumer stalls
+        for _ in 0..<40 {
+            produce()
+            try await Task.sleep(nanoseconds: 2_000_000)
+        }
+        #expect(rb.spilledFrames() > 0)
+
+        // Sustain a partial backlog, then drain it
+        for _ in 0..<500 {
+            produce()
+            try await Task.sleep(nanoseconds: 1_000_000)
+            _ = consume()
+        }
+        for _ in 0..<2000 where expected < written {
+            if consume() == 0 {
+                try await Task.sleep(nanoseconds: 1_000_000)
+            }
+        }
+
+        #expect(expected == written)
+        #expect(rb.spilledFrames() == 0)
+        #expect(rb.spillFailed() == false)
+
+        rb.deallocate()
+        #expect(rb.__convertToBool() == false)
+    }
+
+    @Test func compressedAudioRingBufferWrap() async throws {
+        let int16Mono = AudioStreamBasicDescription(mSampleRate: 44100, mFormatID: kAudioFormatLinearPCM, mFormatFlags: kAudioFormatFlagIsSignedInteger|kAudioFormatFlagsNativeEndian|kAudioFormatFlagIsPacked|kAudioFormatFlagIsNonInterleaved, mBytesPerPacket: 2, mFramesPerPacket: 1, mBytesPerFrame: 2, mChannelsPerFrame: 1, mBitsPerChannel: 16, mReserved: 0)
+
+        var rb = spsc.CompressedAudioRingBuffer()
+        // A verbatim block is more than half the compressed ring, so it only fits once the ring has been emptied
+        #expect(rb.allocate(int16Mono, 256, 8, 600, spsc.CompressedAudioRingBuffer.defaultHelperInterval) == true)
+
+        let input = TestBufferList<Int16>(channelCount: 1, frameCount: 256)
+        let output = TestBufferList<Int16>(channelCount: 1, frameCount: 256)
+        var generator = SystemRandomNumberGenerator()
+
+        for round in 0..<8 {
+            // Fill with a compressible block followed by one stored verbatim, draining each before the next
+            for verbatim in [false, true] {
+                for i in 0..<256 {
+                    input[0][i] = verbatim ? Int16.random(in: .min ... .max, using: &generator) : Int16(truncatingIfNeeded: round * 256 + i) &+ Int16.random(in: 0..<256, using: &generator)
+                }
+                #expect(rb.write(input.pointer, 256) == 256)
+
+                for _ in 0..<200 where rb.availableFrames() < 256 {
+                    try await Task.sleep(nanoseconds: 5_000_000)
+                }
+                #expect(rb.availableFrames() == 256)
+                #expect(rb.read(output.pointer, 256) == 256)
+                #expect(Array(output[0]) == Array(input[0]))
+            }
+        }
+
+        #expect(rb.compressedBytes() == 0)
+        rb.deallocate()
+    }
+
+    @Test func audioRingBufferParallelWriterAndReader() async {
+        var rb = spsc.AudioRingBuffer()
+        #expect(rb.allocate(floatFormat(channelCount: 4), 256) == true)
+        var writer = spsc.AudioRingBufferParallelWriter(&rb, 4)
+        var reader = spsc.AudioRingBufferParallelReader(&rb, 4)
+
+        // Each group holds one channel
+        let channels = (0..<4).map { _ in TestBufferList<Float>(channelCount: 1, frameCount: 64) }
+        let committed = UnsafeMutableBufferPointer<Bool>.allocate(capacity: 4)
+        defer { committed.deallocate() }
+
+        func sample(_ round: Int, _ frame: Int, _ group: Int) -> Float {
+            Float(round * 64 + frame) + Float(group) / 8
+        }
+
+        for round in 0..<16 {
+            let region = writer.begin(64)
+            #expect(region.count() == 64)
+            #expect(writer.inFlight() == true)
+            #expect(writer.begin(64).count() == 0)
+
+            // Three groups write and commit in parallel without publishing the frames
+            withUnsafeMutablePointer(to: &writer) { writer in
+                DispatchQueue.concurrentPerform(iterations: 3) { group in
+                    for i in 0..<64 {
+                        channels[group][0][i] = sample(round, i, group)
+                    }
+                    writer.pointee.writeChannels(region, channels[group].pointer, UInt32(group))
+                    committed[group] = writer.pointee.commit()
+                }
+            }
+            #expect(committed[0..<3].allSatisfy { !$0 })
+            #expect(writer.inFlight() == true)
+            #expect(rb.availableFrames() == 0)
+
+            // The last group's commit publishes
+            for i in 0..<64 {
+                channels[3][0][i] = sample(round, i, 3)
+            }
+            writer.writeChannels(region, channels[3].pointer, 3)
+            #expect(writer.commit() == true)
+            #expect(writer.inFlight() == false)
+            #expect(rb.availableFrames() == 64)
+
+            // Four groups read in parallel and exactly one commit releases the frames
+            let readRegion = reader.begin(64)
+            #expect(readRegion.count() == 64)
+            #expect(reader.begin(64).count() == 0)
+            withUnsafeMutablePointer(to: &reader) { reader in
+                DispatchQueue.concurrentPerform(iterations: 4) { group in
+                    channels[group][0].update(repeating: 0)
+                    reader.pointee.readChannels(readRegion, channels[group].pointer, UInt32(group))
+                    committed[group] = reader.pointee.commit()
+                }
+            }
+            #expect(committed.filter { $0 }.count == 1)
+            #expect(reader.inFlight() == false)
+            #expect(rb.availableFrames() == 0)
+
+            for group in 0..<4 {
+                #expect(channels[group][0].elementsEqual((0..<64).map { sample(round, $0, group) }))
+            }
+        }
+    }
+
+    @Test func audioRingBufferSchedulerRunsNodes() async throws {
+        /// A node computing `scale * x + offset` from one ring into another.
+        final class Node {
+            let input: UnsafeMutablePointer<spsc.AudioRingBuffer>
+            let output: UnsafeMutablePointer<spsc.AudioRingBuffer>
+            let scale: Float
+            let offset: Float
+            let buffer = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+
+            init(_ input: UnsafeMutablePointer<spsc.AudioRingBuffer>, _ output: UnsafeMutablePointer<spsc.AudioRingBuffer>, scale: Float, offset: Float) {
+                self.input = input
+                self.output = output
+                self.scale = scale
+                self.offset = offset
+            }
+
+            func process() {
+                while input.pointee.availableFrames() >= 64 && output.pointee.freeSpace() >= 64 {
+                    _ = input.pointee.read(buffer.pointer, 64)
+                    for i in 0..<64 {
+                        buffer[0][i] = scale * buffer[0][i] + offset
+                    }
+                    _ = output.pointee.write(buffer.pointer, 64)
+                }
+            }
+        }
+
+        // Three rings connected by a doubling node and an incrementing node
+        let rings = UnsafeMutablePointer<spsc.AudioRingBuffer>.allocate(capacity: 3)
+        for i in 0..<3 {
+            (rings + i).initialize(to: spsc.AudioRingBuffer())
+            #expect(rings[i].allocate(floatFormat(channelCount: 1), 256) == true)
+        }
+        defer {
+            rings.deinitialize(count: 3)
+            rings.deallocate()
+        }
+        let nodes = [Node(rings, rings + 1, scale: 2, offset: 0), Node(rings + 1, rings + 2, scale: 1, offset: 1)]
+
+        var scheduler = spsc.AudioRingBufferScheduler()
+        for (i, node) in nodes.enumerated() {
+            var inputs = spsc.AudioRingBufferScheduler.PortList()
+            inputs.push_back(spsc.AudioRingBufferScheduler.Port(ringBuffer: node.input, frameCount: 64))
+            var outputs = spsc.AudioRingBufferScheduler.PortList()
+            outputs.push_back(spsc.AudioRingBufferScheduler.Port(ringBuffer: node.output, frameCount: 64))
+            let process = spsc.AudioRingBufferScheduler.makeProcessFunction({ context in
+                Unmanaged<Node>.fromOpaque(context!).takeUnretainedValue().process()
+            }, Unmanaged.passUnretained(node).toOpaque())
+            #expect(scheduler.addNode(process, inputs, outputs) == i)
+        }
+        #expect(scheduler.nodeCount() == 2)
+        #expect(scheduler.start(2, spsc.AudioRingBufferScheduler.defaultIdleInterval) == true)
+
+        // Feed the graph from outside and drain its output
+        let input = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        let output = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        var framesWritten = 0
+        var framesRead = 0
+        for _ in 0..<2000 where framesRead < 1024 {
+            if framesWritten < 1024 && rings[0].freeSpace() >= 64 {
+                for i in 0..<64 {
+                    input[0][i] = Float(framesWritten + i)
+                }
+                #expect(rings[0].write(input.pointer, 64) == 64)
+                framesWritten += 64
+            }
+            let count = rings[2].read(output.pointer, 64)
+            for i in 0..<count where output[0][i] != Float(framesRead + i) * 2 + 1 {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i])")
+                break
+            }
+            framesRead += count
+            if count == 0 {
+                try await Task.sleep(nanoseconds: 1_000_000)
+            }
+        }
+
+        // The workers hold unretained references to the nodes
+        scheduler.stop()
+        withExtendedLifetime(nodes) {}
+        #expect(framesRead == 1024)
+        #expect(scheduler.runCount(0) > 0)
+        #expect(scheduler.runCount(1) > 0)
+    }
+
+    @Test func audioRingBufferPipelineRunsStages() async throws {
+        // One stage doubling each sample
+        var stage = spsc.AudioRingBufferPipeline.Stage()
+        stage.process = spsc.AudioRingBufferPipeline.makeProcessFunction({ _, input, output, frameCount in
+            let source = UnsafeMutableAudioBufferListPointer(UnsafeMutablePointer(mutating: input))[0].mData!.assumingMemoryBound(to: Float.self)
+            let destination = UnsafeMutableAudioBufferListPointer(output)[0].mData!.assumingMemoryBound(to: Float.self)
+            for i in 0..<Int(frameCount) {
+                destination[i] = 2 * source[i]
+            }
+            return frameCount
+        }, nil)
+        stage.outputFormat = floatFormat(channelCount: 1)
+        stage.blockFrameCount = 64
+        var stages = spsc.AudioRingBufferPipeline.StageList()
+        stages.push_back(stage)
+
+        var pipeline = spsc.AudioRingBufferPipeline()
+        let endpoint = spsc.AudioRingBufferPipeline.Endpoint(blockFrameCount: 64, latencyFrameCount: 0)
+        #expect(pipeline.allocate(floatFormat(channelCount: 1), endpoint, stages, endpoint) == true)
+        #expect(pipeline.stageCount() == 1)
+        #expect(pipeline.start(.dedicated, 1, spsc.AudioRingBufferPipeline.defaultIdleInterval) == true)
+        #expect(pipeline.isRunning() == true)
+
+        let input = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        let output = TestBufferList<Float>(channelCount: 1, frameCount: 64)
+        var framesWritten = 0
+        var framesRead = 0
+        for _ in 0..<2000 where framesRead < 1024 {
+            if framesWritten < 1024 && pipeline.input().pointee.freeSpace() >= 64 {
+                for i in 0..<64 {
+                    input[0][i] = Float(framesWritten + i)
+                }
+                #expect(pipeline.input().pointee.write(input.pointer, 64) == 64)
+                framesWritten += 64
+            }
+            let count = pipeline.output().pointee.read(output.pointer, 64)
+            for i in 0..<count where output[0][i] != Float(framesRead + i) * 2 {
+                Issue.record("frame \(framesRead + i) read back as \(output[0][i])")
+                break
+            }
+            framesRead += count
+            if count == 0 {
+                try await Task.sleep(nanoseconds: 1_000_000)
+            }
+        }
+
+        pipeline.stop()
+        #expect(framesRead == 1024)
+        let statistics = pipeline.statistics(0)
+        #expect(statistics.framesConsumed == 1024)
+        #expect(statistics.framesProduced == 1024)
+        #expect(statistics.blockCount == 16)
+    }
 }